@@ -0,0 +1,600 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include "../containers/vector.hpp"
+#include "../utilities/span.hpp"
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__SSE2__)
+#include <immintrin.h>
+#define MYSTL_SIMD_X86 1
+#define MYSTL_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define MYSTL_SIMD_X86 0
+#endif
+
+namespace mystl {
+
+// returned by the index-returning algorithms when nothing matches
+constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+// Bulk algorithms over contiguous int / float / double data. Each call picks
+// the widest kernel the running CPU supports (AVX2, then SSE2, then plain
+// loops), so one binary runs everywhere and uses AVX2 where it exists.
+// Other element types always take the plain loops.
+namespace simd {
+
+enum class isa { scalar, sse2, avx2 };
+
+inline isa detect_isa() {
+#if MYSTL_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return isa::avx2;
+    if (__builtin_cpu_supports("sse2")) return isa::sse2;
+#endif
+    return isa::scalar;
+}
+
+inline isa& selected_isa() {
+    static isa level = detect_isa();
+    return level;
+}
+
+inline isa active_isa() {
+    return selected_isa();
+}
+
+// cap dispatch at `level` (for benchmarks and testing the fallbacks); it can
+// never be raised above what the CPU supports
+inline void limit_isa(isa level) {
+    isa best = detect_isa();
+    selected_isa() = level < best ? level : best;
+}
+
+template <typename T>
+struct vectorizable
+    : std::bool_constant<std::is_same<T, int32_t>::value || std::is_same<T, float>::value ||
+                         std::is_same<T, double>::value> {};
+
+// value no element can beat when searching for the min (Max = false) or max
+template <bool Max, typename T>
+constexpr T identity_of() {
+    if constexpr (std::numeric_limits<T>::has_infinity)
+        return Max ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::infinity();
+    else
+        return Max ? std::numeric_limits<T>::lowest() : std::numeric_limits<T>::max();
+}
+
+// Plain loops: the fallback for every ISA and the only path for other types.
+// Comparisons are written so NaNs are skipped, matching the vector kernels.
+namespace scalar {
+
+template <typename T>
+std::size_t find(const T* data, std::size_t n, const T& value) {
+    for (std::size_t i = 0; i < n; i++)
+        if (data[i] == value) return i;
+    return npos;
+}
+
+template <typename T>
+std::size_t count(const T* data, std::size_t n, const T& value) {
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < n; i++)
+        total += data[i] == value;
+    return total;
+}
+
+template <bool Max, typename T>
+T extreme(const T* data, std::size_t n, T best) {
+    for (std::size_t i = 0; i < n; i++)
+        if (Max ? best < data[i] : data[i] < best) best = data[i];
+    return best;
+}
+
+template <typename T>
+T sum(const T* data, std::size_t n, T total) {
+    for (std::size_t i = 0; i < n; i++)
+        total = total + data[i];
+    return total;
+}
+
+template <typename T>
+void fill(T* data, std::size_t n, const T& value) {
+    for (std::size_t i = 0; i < n; i++)
+        data[i] = value;
+}
+
+// Blocks of 16 with a constant trip count let the compiler vectorize the
+// body at -O2 for any inlinable op. The restrict form is used for disjoint
+// ranges and the in-place form when source and destination coincide.
+template <typename T, typename U, typename Op>
+void transform(const T* __restrict src, U* __restrict dst, std::size_t n, Op& op) {
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+        for (std::size_t j = 0; j < 16; j++) dst[i + j] = op(src[i + j]);
+    for (; i < n; i++) dst[i] = op(src[i]);
+}
+
+template <typename T, typename Op>
+void transform_in_place(T* data, std::size_t n, Op& op) {
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+        for (std::size_t j = 0; j < 16; j++) data[i + j] = op(data[i + j]);
+    for (; i < n; i++) data[i] = op(data[i]);
+}
+
+}
+
+#if MYSTL_SIMD_X86
+
+// Per-ISA register operations. eq_mask returns one bit per lane.
+template <typename T>
+struct sse2_ops;
+
+template <>
+struct sse2_ops<int32_t> {
+    using reg = __m128i;
+    static constexpr std::size_t lanes = 4;
+    static reg load(const int32_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    static void store(int32_t* p, reg v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+    static reg set1(int32_t v) { return _mm_set1_epi32(v); }
+    static reg zero() { return _mm_setzero_si128(); }
+    static unsigned eq_mask(reg a, reg b) { return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b))); }
+    static reg add(reg a, reg b) { return _mm_add_epi32(a, b); }
+    // SSE2 has no 32-bit min/max; select through a compare mask
+    static reg min(reg a, reg b) {
+        __m128i aGreater = _mm_cmpgt_epi32(a, b);
+        return _mm_or_si128(_mm_and_si128(aGreater, b), _mm_andnot_si128(aGreater, a));
+    }
+    static reg max(reg a, reg b) {
+        __m128i aGreater = _mm_cmpgt_epi32(a, b);
+        return _mm_or_si128(_mm_and_si128(aGreater, a), _mm_andnot_si128(aGreater, b));
+    }
+};
+
+template <>
+struct sse2_ops<float> {
+    using reg = __m128;
+    static constexpr std::size_t lanes = 4;
+    static reg load(const float* p) { return _mm_loadu_ps(p); }
+    static void store(float* p, reg v) { _mm_storeu_ps(p, v); }
+    static reg set1(float v) { return _mm_set1_ps(v); }
+    static reg zero() { return _mm_setzero_ps(); }
+    static unsigned eq_mask(reg a, reg b) { return _mm_movemask_ps(_mm_cmpeq_ps(a, b)); }
+    static reg add(reg a, reg b) { return _mm_add_ps(a, b); }
+    // minps/maxps return the second operand when either is NaN
+    static reg min(reg a, reg b) { return _mm_min_ps(a, b); }
+    static reg max(reg a, reg b) { return _mm_max_ps(a, b); }
+};
+
+template <>
+struct sse2_ops<double> {
+    using reg = __m128d;
+    static constexpr std::size_t lanes = 2;
+    static reg load(const double* p) { return _mm_loadu_pd(p); }
+    static void store(double* p, reg v) { _mm_storeu_pd(p, v); }
+    static reg set1(double v) { return _mm_set1_pd(v); }
+    static reg zero() { return _mm_setzero_pd(); }
+    static unsigned eq_mask(reg a, reg b) { return _mm_movemask_pd(_mm_cmpeq_pd(a, b)); }
+    static reg add(reg a, reg b) { return _mm_add_pd(a, b); }
+    static reg min(reg a, reg b) { return _mm_min_pd(a, b); }
+    static reg max(reg a, reg b) { return _mm_max_pd(a, b); }
+};
+
+template <typename T>
+struct avx2_ops;
+
+template <>
+struct avx2_ops<int32_t> {
+    using reg = __m256i;
+    static constexpr std::size_t lanes = 8;
+    MYSTL_TARGET_AVX2 static reg load(const int32_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    MYSTL_TARGET_AVX2 static void store(int32_t* p, reg v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+    MYSTL_TARGET_AVX2 static reg set1(int32_t v) { return _mm256_set1_epi32(v); }
+    MYSTL_TARGET_AVX2 static reg zero() { return _mm256_setzero_si256(); }
+    MYSTL_TARGET_AVX2 static unsigned eq_mask(reg a, reg b) {
+        return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b)));
+    }
+    MYSTL_TARGET_AVX2 static reg add(reg a, reg b) { return _mm256_add_epi32(a, b); }
+    MYSTL_TARGET_AVX2 static reg min(reg a, reg b) { return _mm256_min_epi32(a, b); }
+    MYSTL_TARGET_AVX2 static reg max(reg a, reg b) { return _mm256_max_epi32(a, b); }
+};
+
+template <>
+struct avx2_ops<float> {
+    using reg = __m256;
+    static constexpr std::size_t lanes = 8;
+    MYSTL_TARGET_AVX2 static reg load(const float* p) { return _mm256_loadu_ps(p); }
+    MYSTL_TARGET_AVX2 static void store(float* p, reg v) { _mm256_storeu_ps(p, v); }
+    MYSTL_TARGET_AVX2 static reg set1(float v) { return _mm256_set1_ps(v); }
+    MYSTL_TARGET_AVX2 static reg zero() { return _mm256_setzero_ps(); }
+    MYSTL_TARGET_AVX2 static unsigned eq_mask(reg a, reg b) { return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ)); }
+    MYSTL_TARGET_AVX2 static reg add(reg a, reg b) { return _mm256_add_ps(a, b); }
+    MYSTL_TARGET_AVX2 static reg min(reg a, reg b) { return _mm256_min_ps(a, b); }
+    MYSTL_TARGET_AVX2 static reg max(reg a, reg b) { return _mm256_max_ps(a, b); }
+};
+
+template <>
+struct avx2_ops<double> {
+    using reg = __m256d;
+    static constexpr std::size_t lanes = 4;
+    MYSTL_TARGET_AVX2 static reg load(const double* p) { return _mm256_loadu_pd(p); }
+    MYSTL_TARGET_AVX2 static void store(double* p, reg v) { _mm256_storeu_pd(p, v); }
+    MYSTL_TARGET_AVX2 static reg set1(double v) { return _mm256_set1_pd(v); }
+    MYSTL_TARGET_AVX2 static reg zero() { return _mm256_setzero_pd(); }
+    MYSTL_TARGET_AVX2 static unsigned eq_mask(reg a, reg b) { return _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ)); }
+    MYSTL_TARGET_AVX2 static reg add(reg a, reg b) { return _mm256_add_pd(a, b); }
+    MYSTL_TARGET_AVX2 static reg min(reg a, reg b) { return _mm256_min_pd(a, b); }
+    MYSTL_TARGET_AVX2 static reg max(reg a, reg b) { return _mm256_max_pd(a, b); }
+};
+
+// The kernels are spelled out once per ISA: a function's target is fixed
+// where it is defined, so one template cannot serve both.
+namespace sse2 {
+
+template <typename T>
+std::size_t find(const T* data, std::size_t n, T value) {
+    using V = sse2_ops<T>;
+    typename V::reg needle = V::set1(value);
+    std::size_t i = 0;
+    for (; i + V::lanes <= n; i += V::lanes) {
+        unsigned mask = V::eq_mask(V::load(data + i), needle);
+        if (mask) return i + __builtin_ctz(mask);
+    }
+    std::size_t rest = scalar::find(data + i, n - i, value);
+    return rest == npos ? npos : i + rest;
+}
+
+template <typename T>
+std::size_t count(const T* data, std::size_t n, T value) {
+    using V = sse2_ops<T>;
+    typename V::reg needle = V::set1(value);
+    std::size_t total = 0, i = 0;
+    // popcount of the 4-bit lane mask from a packed nibble table; baseline
+    // x86-64 has no popcnt instruction
+    for (; i + V::lanes <= n; i += V::lanes)
+        total += (0x4332322132212110ULL >> (4 * V::eq_mask(V::load(data + i), needle))) & 0xf;
+    return total + scalar::count(data + i, n - i, value);
+}
+
+template <bool Max, typename T>
+T extreme(const T* data, std::size_t n, T identity) {
+    using V = sse2_ops<T>;
+    typename V::reg best = V::set1(identity);
+    std::size_t i = 0;
+    for (; i + V::lanes <= n; i += V::lanes)
+        best = Max ? V::max(V::load(data + i), best) : V::min(V::load(data + i), best);
+    T lanes[V::lanes];
+    V::store(lanes, best);
+    return scalar::extreme<Max>(data + i, n - i, scalar::extreme<Max>(lanes, V::lanes, identity));
+}
+
+template <typename T>
+T sum(const T* data, std::size_t n, T init) {
+    using V = sse2_ops<T>;
+    typename V::reg a0 = V::zero(), a1 = V::zero();
+    std::size_t i = 0;
+    for (; i + 2 * V::lanes <= n; i += 2 * V::lanes) {
+        a0 = V::add(a0, V::load(data + i));
+        a1 = V::add(a1, V::load(data + i + V::lanes));
+    }
+    T lanes[V::lanes];
+    V::store(lanes, V::add(a0, a1));
+    return scalar::sum(data + i, n - i, scalar::sum(lanes, V::lanes, init));
+}
+
+template <typename T>
+void fill(T* data, std::size_t n, T value) {
+    using V = sse2_ops<T>;
+    typename V::reg v = V::set1(value);
+    std::size_t i = 0;
+    for (; i + V::lanes <= n; i += V::lanes) V::store(data + i, v);
+    scalar::fill(data + i, n - i, value);
+}
+
+}
+
+namespace avx2 {
+
+template <typename T>
+MYSTL_TARGET_AVX2 std::size_t find(const T* data, std::size_t n, T value) {
+    using V = avx2_ops<T>;
+    typename V::reg needle = V::set1(value);
+    std::size_t i = 0;
+    for (; i + V::lanes <= n; i += V::lanes) {
+        unsigned mask = V::eq_mask(V::load(data + i), needle);
+        if (mask) return i + __builtin_ctz(mask);
+    }
+    std::size_t rest = scalar::find(data + i, n - i, value);
+    return rest == npos ? npos : i + rest;
+}
+
+template <typename T>
+MYSTL_TARGET_AVX2 std::size_t count(const T* data, std::size_t n, T value) {
+    using V = avx2_ops<T>;
+    typename V::reg needle = V::set1(value);
+    std::size_t total = 0, i = 0;
+    for (; i + V::lanes <= n; i += V::lanes)
+        total += __builtin_popcount(V::eq_mask(V::load(data + i), needle));
+    return total + scalar::count(data + i, n - i, value);
+}
+
+template <bool Max, typename T>
+MYSTL_TARGET_AVX2 T extreme(const T* data, std::size_t n, T identity) {
+    using V = avx2_ops<T>;
+    typename V::reg best = V::set1(identity);
+    std::size_t i = 0;
+    for (; i + V::lanes <= n; i += V::lanes)
+        best = Max ? V::max(V::load(data + i), best) : V::min(V::load(data + i), best);
+    T lanes[V::lanes];
+    V::store(lanes, best);
+    return scalar::extreme<Max>(data + i, n - i, scalar::extreme<Max>(lanes, V::lanes, identity));
+}
+
+// four accumulators hide the latency of the vector adds
+template <typename T>
+MYSTL_TARGET_AVX2 T sum(const T* data, std::size_t n, T init) {
+    using V = avx2_ops<T>;
+    typename V::reg a0 = V::zero(), a1 = V::zero(), a2 = V::zero(), a3 = V::zero();
+    std::size_t i = 0;
+    for (; i + 4 * V::lanes <= n; i += 4 * V::lanes) {
+        a0 = V::add(a0, V::load(data + i));
+        a1 = V::add(a1, V::load(data + i + V::lanes));
+        a2 = V::add(a2, V::load(data + i + 2 * V::lanes));
+        a3 = V::add(a3, V::load(data + i + 3 * V::lanes));
+    }
+    for (; i + V::lanes <= n; i += V::lanes)
+        a0 = V::add(a0, V::load(data + i));
+    T lanes[V::lanes];
+    V::store(lanes, V::add(V::add(a0, a1), V::add(a2, a3)));
+    return scalar::sum(data + i, n - i, scalar::sum(lanes, V::lanes, init));
+}
+
+template <typename T>
+MYSTL_TARGET_AVX2 void fill(T* data, std::size_t n, T value) {
+    using V = avx2_ops<T>;
+    typename V::reg v = V::set1(value);
+    std::size_t i = 0;
+    // align the stores so none of them splits a cache line
+    while (i < n && reinterpret_cast<std::uintptr_t>(data + i) % sizeof(typename V::reg) != 0)
+        data[i++] = value;
+    for (; i + V::lanes <= n; i += V::lanes) V::store(data + i, v);
+    scalar::fill(data + i, n - i, value);
+}
+
+// same blocking as scalar::transform; the op is inlined into AVX2 code
+template <typename T, typename U, typename Op>
+MYSTL_TARGET_AVX2 void transform(const T* __restrict src, U* __restrict dst, std::size_t n, Op& op) {
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+        for (std::size_t j = 0; j < 16; j++) dst[i + j] = op(src[i + j]);
+    for (; i < n; i++) dst[i] = op(src[i]);
+}
+
+template <typename T, typename Op>
+MYSTL_TARGET_AVX2 void transform_in_place(T* data, std::size_t n, Op& op) {
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+        for (std::size_t j = 0; j < 16; j++) data[i + j] = op(data[i + j]);
+    for (; i < n; i++) data[i] = op(data[i]);
+}
+
+}
+
+#endif
+
+// The dispatchers: choose a kernel by element type and active ISA.
+template <typename T>
+std::size_t find(const T* data, std::size_t n, const T& value) {
+#if MYSTL_SIMD_X86
+    if constexpr (vectorizable<T>::value) {
+        switch (active_isa()) {
+        case isa::avx2: return avx2::find(data, n, value);
+        case isa::sse2: return sse2::find(data, n, value);
+        default: break;
+        }
+    }
+#endif
+    return scalar::find(data, n, value);
+}
+
+template <typename T>
+std::size_t count(const T* data, std::size_t n, const T& value) {
+#if MYSTL_SIMD_X86
+    if constexpr (vectorizable<T>::value) {
+        switch (active_isa()) {
+        case isa::avx2: return avx2::count(data, n, value);
+        case isa::sse2: return sse2::count(data, n, value);
+        default: break;
+        }
+    }
+#endif
+    return scalar::count(data, n, value);
+}
+
+template <bool Max, typename T>
+T extreme(const T* data, std::size_t n, T identity) {
+#if MYSTL_SIMD_X86
+    if constexpr (vectorizable<T>::value) {
+        switch (active_isa()) {
+        case isa::avx2: return avx2::extreme<Max>(data, n, identity);
+        case isa::sse2: return sse2::extreme<Max>(data, n, identity);
+        default: break;
+        }
+    }
+#endif
+    return scalar::extreme<Max>(data, n, identity);
+}
+
+// Index of the first smallest (largest) element, as std::min_element would
+// report it. The extreme value is taken per 4096-element block, so the only
+// second pass is a find() inside the winning block.
+template <bool Max, typename T>
+std::size_t extreme_index(const T* data, std::size_t n) {
+    if (n == 0) return npos;
+    if constexpr (!vectorizable<T>::value) {
+        std::size_t best = 0;
+        for (std::size_t i = 1; i < n; i++)
+            if (Max ? data[best] < data[i] : data[i] < data[best]) best = i;
+        return best;
+    } else {
+        // a leading NaN compares false against everything, so it stays the answer
+        if constexpr (!std::numeric_limits<T>::is_integer) {
+            if (data[0] != data[0]) return 0;
+        }
+        constexpr std::size_t block = 4096;
+        const T identity = identity_of<Max, T>();
+        std::size_t bestStart = 0;
+        T best = extreme<Max>(data, n < block ? n : block, identity);
+        for (std::size_t start = block; start < n; start += block) {
+            T candidate = extreme<Max>(data + start, n - start < block ? n - start : block, identity);
+            if (Max ? best < candidate : candidate < best) {
+                best = candidate;
+                bestStart = start;
+            }
+        }
+        std::size_t length = n - bestStart < block ? n - bestStart : block;
+        return bestStart + find(data + bestStart, length, best);
+    }
+}
+
+template <typename T>
+T sum(const T* data, std::size_t n, T init) {
+#if MYSTL_SIMD_X86
+    if constexpr (vectorizable<T>::value) {
+        switch (active_isa()) {
+        case isa::avx2: return avx2::sum(data, n, init);
+        case isa::sse2: return sse2::sum(data, n, init);
+        default: break;
+        }
+    }
+#endif
+    return scalar::sum(data, n, init);
+}
+
+template <typename T>
+void fill(T* data, std::size_t n, const T& value) {
+#if MYSTL_SIMD_X86
+    if constexpr (vectorizable<T>::value) {
+        switch (active_isa()) {
+        case isa::avx2: return avx2::fill(data, n, value);
+        case isa::sse2: return sse2::fill(data, n, value);
+        default: break;
+        }
+    }
+#endif
+    scalar::fill(data, n, value);
+}
+
+template <typename T, typename U, typename Op>
+void transform(const T* src, U* dst, std::size_t n, Op& op) {
+    const void* srcBegin = src;
+    const void* srcEnd = src + n;
+    const void* dstBegin = dst;
+    const void* dstEnd = dst + n;
+    bool inPlace = srcBegin == dstBegin && sizeof(T) == sizeof(U);
+    bool disjoint = srcEnd <= dstBegin || dstEnd <= srcBegin;
+    if (!inPlace && !disjoint) {
+        // partial overlap: element order matters, no blocking
+        for (std::size_t i = 0; i < n; i++) dst[i] = op(src[i]);
+        return;
+    }
+#if MYSTL_SIMD_X86
+    if (active_isa() == isa::avx2) {
+        if constexpr (std::is_same<T, U>::value) {
+            if (inPlace) return avx2::transform_in_place(dst, n, op);
+        }
+        return avx2::transform(src, dst, n, op);
+    }
+#endif
+    if constexpr (std::is_same<T, U>::value) {
+        if (inPlace) return scalar::transform_in_place(dst, n, op);
+    }
+    scalar::transform(src, dst, n, op);
+}
+
+}
+
+// Public algorithms, over spans and mystl::vector.
+
+// index of the first element equal to value, or npos
+template <typename T>
+std::size_t find(span<T> range, const std::remove_cv_t<T>& value) {
+    return simd::find<std::remove_cv_t<T>>(range.data(), range.size(), value);
+}
+
+template <typename T, typename A>
+std::size_t find(const vector<T, A>& v, const T& value) {
+    return find(span<const T>(v.data(), v.size()), value);
+}
+
+// number of elements equal to value
+template <typename T>
+std::size_t count(span<T> range, const std::remove_cv_t<T>& value) {
+    return simd::count<std::remove_cv_t<T>>(range.data(), range.size(), value);
+}
+
+template <typename T, typename A>
+std::size_t count(const vector<T, A>& v, const T& value) {
+    return count(span<const T>(v.data(), v.size()), value);
+}
+
+// index of the first smallest element, or npos if empty
+template <typename T>
+std::size_t min_element(span<T> range) {
+    return simd::extreme_index<false, std::remove_cv_t<T>>(range.data(), range.size());
+}
+
+template <typename T, typename A>
+std::size_t min_element(const vector<T, A>& v) {
+    return min_element(span<const T>(v.data(), v.size()));
+}
+
+// index of the first largest element, or npos if empty
+template <typename T>
+std::size_t max_element(span<T> range) {
+    return simd::extreme_index<true, std::remove_cv_t<T>>(range.data(), range.size());
+}
+
+template <typename T, typename A>
+std::size_t max_element(const vector<T, A>& v) {
+    return max_element(span<const T>(v.data(), v.size()));
+}
+
+// init plus the sum of all elements. Float and double sums run in several
+// lanes at once, so rounding can differ from a left-to-right loop.
+template <typename T>
+std::remove_cv_t<T> accumulate(span<T> range, std::remove_cv_t<T> init) {
+    return simd::sum<std::remove_cv_t<T>>(range.data(), range.size(), init);
+}
+
+template <typename T, typename A>
+T accumulate(const vector<T, A>& v, T init) {
+    return accumulate(span<const T>(v.data(), v.size()), init);
+}
+
+// dst[i] = op(src[i]); dst may be src itself
+template <typename T, typename U, typename Op>
+void transform(span<T> src, span<U> dst, Op op) {
+    if (dst.size() < src.size()) throw std::invalid_argument("transform destination is smaller than source");
+    simd::transform<std::remove_cv_t<T>>(src.data(), dst.data(), src.size(), op);
+}
+
+template <typename T, typename A, typename U, typename B, typename Op>
+void transform(const vector<T, A>& src, vector<U, B>& dst, Op op) {
+    transform(span<const T>(src.data(), src.size()), span<U>(dst.data(), dst.size()), op);
+}
+
+template <typename T>
+void fill(span<T> range, const T& value) {
+    simd::fill(range.data(), range.size(), value);
+}
+
+template <typename T, typename A>
+void fill(vector<T, A>& v, const T& value) {
+    fill(span<T>(v.data(), v.size()), value);
+}
+
+}
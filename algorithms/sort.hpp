@@ -0,0 +1,545 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../containers/vector.hpp"
+#include "../utilities/pair.hpp"
+#include "../utilities/span.hpp"
+#include "../utilities/thread_pool.hpp"
+
+namespace mystl {
+
+// Sorting over contiguous ranges (mystl::span, mystl::vector).
+//
+// sort() is an introsort; stable_sort() a bottom-up merge sort. With the
+// default comparator, integer, float and mystl::pair-of-those keys go to an
+// LSD radix sort instead. The thread_pool overloads split the work: sort()
+// is a samplesort whose buckets are sorted in parallel, stable_sort() sorts
+// chunks in parallel and merges them with every thread working on each merge.
+//
+// The merge, radix and parallel paths need a scratch buffer of n elements,
+// so they require T to be default constructible.
+namespace sorting {
+
+constexpr std::size_t kInsertionThreshold = 24;
+constexpr std::size_t kMergeRun = 32;
+constexpr std::size_t kRadixThreshold = 1 << 11;
+constexpr std::size_t kParallelThreshold = 1 << 15;
+
+template <typename T, typename Compare>
+void insertion_sort(T* first, T* last, Compare& comp) {
+    if (first == last) return;
+    for (T* i = first + 1; i < last; ++i) {
+        T value = std::move(*i);
+        T* j = i;
+        for (; j > first && comp(value, *(j - 1)); --j)
+            *j = std::move(*(j - 1));
+        *j = std::move(value);
+    }
+}
+
+template <typename T, typename Compare>
+void sift_down(T* heap, std::size_t n, std::size_t i, Compare& comp) {
+    T value = std::move(heap[i]);
+    while (2 * i + 1 < n) {
+        std::size_t child = 2 * i + 1;
+        if (child + 1 < n && comp(heap[child], heap[child + 1])) child++;
+        if (!comp(value, heap[child])) break;
+        heap[i] = std::move(heap[child]);
+        i = child;
+    }
+    heap[i] = std::move(value);
+}
+
+template <typename T, typename Compare>
+void heap_sort(T* first, T* last, Compare& comp) {
+    std::size_t n = last - first;
+    for (std::size_t i = n / 2; i-- > 0;)
+        sift_down(first, n, i, comp);
+    for (std::size_t end = n; end-- > 1;) {
+        std::swap(first[0], first[end]);
+        sift_down(first, end, 0, comp);
+    }
+}
+
+// put the median of *a, *b, *c into *result
+template <typename T, typename Compare>
+void move_median_to_first(T* result, T* a, T* b, T* c, Compare& comp) {
+    using std::swap;
+    if (comp(*a, *b)) {
+        if (comp(*b, *c)) swap(*result, *b);
+        else if (comp(*a, *c)) swap(*result, *c);
+        else swap(*result, *a);
+    } else if (comp(*a, *c)) {
+        swap(*result, *a);
+    } else if (comp(*b, *c)) {
+        swap(*result, *c);
+    } else {
+        swap(*result, *b);
+    }
+}
+
+// Hoare partition of [first, last) around *pivot. The median-of-three
+// guarantees an element on each side that stops the scans, so they need
+// no bounds checks.
+template <typename T, typename Compare>
+T* unguarded_partition(T* first, T* last, T* pivot, Compare& comp) {
+    using std::swap;
+    while (true) {
+        while (comp(*first, *pivot)) ++first;
+        --last;
+        while (comp(*pivot, *last)) --last;
+        if (!(first < last)) return first;
+        swap(*first, *last);
+        ++first;
+    }
+}
+
+// quicksort that switches to heap sort once recursion gets too deep, and
+// leaves short ranges to insertion sort
+template <typename T, typename Compare>
+void introsort(T* first, T* last, int depth, Compare& comp) {
+    while (static_cast<std::size_t>(last - first) > kInsertionThreshold) {
+        if (depth-- == 0) {
+            heap_sort(first, last, comp);
+            return;
+        }
+        T* mid = first + (last - first) / 2;
+        move_median_to_first(first, first + 1, mid, last - 1, comp);
+        T* cut = unguarded_partition(first + 1, last, first, comp);
+        // recurse into the smaller side so the stack stays O(log n)
+        if (cut - first < last - cut) {
+            introsort(first, cut, depth, comp);
+            first = cut;
+        } else {
+            introsort(cut, last, depth, comp);
+            last = cut;
+        }
+    }
+    insertion_sort(first, last, comp);
+}
+
+template <typename T, typename Compare>
+void comparison_sort(T* data, std::size_t n, Compare& comp) {
+    int depth = 0;
+    for (std::size_t m = n; m > 1; m >>= 1) depth += 2;
+    introsort(data, data + n, depth, comp);
+}
+
+// stable merge of [a, a + na) and [b, b + nb) into out; ties take from a
+template <typename T, typename Compare>
+void merge_into(T* a, std::size_t na, T* b, std::size_t nb, T* out, Compare& comp) {
+    std::size_t i = 0, j = 0;
+    while (i < na && j < nb) {
+        if (comp(b[j], a[i])) *out++ = std::move(b[j++]);
+        else *out++ = std::move(a[i++]);
+    }
+    while (i < na) *out++ = std::move(a[i++]);
+    while (j < nb) *out++ = std::move(b[j++]);
+}
+
+// bottom-up merge sort; buffer holds n elements of scratch space
+template <typename T, typename Compare>
+void merge_sort(T* data, std::size_t n, T* buffer, Compare& comp) {
+    for (std::size_t start = 0; start < n; start += kMergeRun) {
+        std::size_t end = start + kMergeRun < n ? start + kMergeRun : n;
+        insertion_sort(data + start, data + end, comp);
+    }
+    T* src = data;
+    T* dst = buffer;
+    for (std::size_t width = kMergeRun; width < n; width *= 2) {
+        for (std::size_t start = 0; start < n; start += 2 * width) {
+            std::size_t mid = start + width < n ? start + width : n;
+            std::size_t end = start + 2 * width < n ? start + 2 * width : n;
+            merge_into(src + start, mid - start, src + mid, end - mid, dst + start, comp);
+        }
+        std::swap(src, dst);
+    }
+    if (src != data)
+        for (std::size_t i = 0; i < n; i++) data[i] = std::move(src[i]);
+}
+
+// Radix keys: each sortable type maps to unsigned digits whose
+// lexicographic order (most significant digit last) matches operator<.
+template <typename T, typename = void>
+struct radix_traits {
+    static constexpr bool enabled = false;
+    static constexpr bool exact = false;
+};
+
+template <typename T>
+struct radix_traits<T, std::enable_if_t<std::is_integral<T>::value && !std::is_same<T, bool>::value>> {
+    using key_type = std::make_unsigned_t<T>;
+    static constexpr bool enabled = true;
+    // equal keys are exactly the equivalent elements, so radix order is stable-sort order
+    static constexpr bool exact = true;
+    static constexpr std::size_t digits = sizeof(T);
+
+    static unsigned digit(const T& value, std::size_t d) {
+        key_type key = static_cast<key_type>(value);
+        if (std::is_signed<T>::value) key ^= key_type(1) << (8 * sizeof(T) - 1);
+        return static_cast<unsigned>((key >> (8 * d)) & 0xff);
+    }
+};
+
+template <typename T>
+struct radix_traits<T, std::enable_if_t<std::is_floating_point<T>::value &&
+                                        (sizeof(T) == 4 || sizeof(T) == 8)>> {
+    using key_type = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+    static constexpr bool enabled = true;
+    // -0.0 and 0.0 are equivalent but get different keys
+    static constexpr bool exact = false;
+    static constexpr std::size_t digits = sizeof(T);
+
+    // negative values: flip every bit; positive values: flip the sign bit.
+    // Negative NaNs sort first and positive NaNs last.
+    static unsigned digit(const T& value, std::size_t d) {
+        key_type bits;
+        std::memcpy(&bits, &value, sizeof(T));
+        const key_type sign = key_type(1) << (8 * sizeof(T) - 1);
+        key_type key = (bits & sign) ? ~bits : (bits | sign);
+        return static_cast<unsigned>((key >> (8 * d)) & 0xff);
+    }
+};
+
+// pairs compare by first, then second: the digits of second come first
+template <typename A, typename B>
+struct radix_traits<pair<A, B>, std::enable_if_t<radix_traits<A>::enabled && radix_traits<B>::enabled>> {
+    static constexpr bool enabled = true;
+    static constexpr bool exact = radix_traits<A>::exact && radix_traits<B>::exact;
+    static constexpr std::size_t digits = radix_traits<A>::digits + radix_traits<B>::digits;
+
+    static unsigned digit(const pair<A, B>& value, std::size_t d) {
+        if (d < radix_traits<B>::digits) return radix_traits<B>::digit(value.second, d);
+        return radix_traits<A>::digit(value.first, d - radix_traits<B>::digits);
+    }
+};
+
+// LSD radix sort, 8 bits per pass; buffer holds n elements of scratch space.
+// All histograms come from one read of the input, and passes where every
+// element has the same digit are skipped.
+template <typename T>
+void radix_sort(T* data, std::size_t n, T* buffer) {
+    using traits = radix_traits<T>;
+    constexpr std::size_t D = traits::digits;
+    std::vector<std::size_t> counts(D * 256, 0);
+    for (std::size_t i = 0; i < n; i++)
+        for (std::size_t d = 0; d < D; d++)
+            counts[d * 256 + traits::digit(data[i], d)]++;
+
+    T* src = data;
+    T* dst = buffer;
+    for (std::size_t d = 0; d < D; d++) {
+        std::size_t* count = counts.data() + d * 256;
+        if (count[traits::digit(src[0], d)] == n) continue;
+        std::size_t offset = 0;
+        for (std::size_t b = 0; b < 256; b++) {
+            std::size_t c = count[b];
+            count[b] = offset;
+            offset += c;
+        }
+        for (std::size_t i = 0; i < n; i++)
+            dst[count[traits::digit(src[i], d)]++] = std::move(src[i]);
+        std::swap(src, dst);
+    }
+    if (src != data)
+        for (std::size_t i = 0; i < n; i++) data[i] = std::move(src[i]);
+}
+
+template <typename T, typename Compare>
+constexpr bool is_default_order() {
+    return std::is_same<Compare, std::less<T>>::value || std::is_same<Compare, std::less<>>::value;
+}
+
+template <typename T, typename Compare>
+void sort(T* data, std::size_t n, Compare& comp) {
+    if constexpr (radix_traits<T>::enabled && is_default_order<T, Compare>()) {
+        if (n >= kRadixThreshold) {
+            std::vector<T> buffer(n);
+            radix_sort(data, n, buffer.data());
+            return;
+        }
+    }
+    comparison_sort(data, n, comp);
+}
+
+// buffer may be null, in which case one is allocated when needed
+template <typename T, typename Compare>
+void stable_sort(T* data, std::size_t n, T* buffer, Compare& comp) {
+    if (n <= kMergeRun) {
+        insertion_sort(data, data + n, comp);
+        return;
+    }
+    std::vector<T> owned;
+    if (!buffer) {
+        owned.resize(n);
+        buffer = owned.data();
+    }
+    if constexpr (radix_traits<T>::exact && is_default_order<T, Compare>()) {
+        if (n >= kRadixThreshold) {
+            radix_sort(data, n, buffer);
+            return;
+        }
+    }
+    merge_sort(data, n, buffer, comp);
+}
+
+// Samplesort: pick splitters from an oversampled, sorted sample, count and
+// scatter elements into buckets chunk by chunk in parallel, then sort the
+// buckets in parallel.
+template <typename T, typename Compare>
+void parallel_sort(thread_pool& pool, T* data, std::size_t n, Compare& comp) {
+    std::size_t workers = pool.size();
+    if (n < kParallelThreshold || workers < 2) {
+        sort(data, n, comp);
+        return;
+    }
+    const std::size_t buckets = workers * 4;
+    const std::size_t oversample = 32;
+
+    std::vector<T> sample(buckets * oversample);
+    uint64_t seed = 0x9E3779B97F4A7C15ull;
+    for (T& s : sample) {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        s = data[seed % n];
+    }
+    comparison_sort(sample.data(), sample.size(), comp);
+    std::vector<T> splitters;
+    for (std::size_t b = 1; b < buckets; b++)
+        splitters.push_back(sample[b * oversample]);
+
+    // bucket of x = number of splitters <= x
+    auto bucketOf = [&splitters](const T& x, Compare& local) {
+        std::size_t lo = 0, hi = splitters.size();
+        while (lo < hi) {
+            std::size_t mid = (lo + hi) / 2;
+            if (local(x, splitters[mid])) hi = mid;
+            else lo = mid + 1;
+        }
+        return lo;
+    };
+
+    const std::size_t chunks = workers;
+    const std::size_t chunkSize = (n + chunks - 1) / chunks;
+    std::vector<uint16_t> bucketIndex(n);
+    std::vector<std::size_t> counts(chunks * buckets, 0);
+    {
+        task_group group(pool);
+        for (std::size_t c = 0; c < chunks; c++) {
+            group.run([&, c] {
+                std::size_t begin = c * chunkSize, end = begin + chunkSize < n ? begin + chunkSize : n;
+                std::size_t* count = counts.data() + c * buckets;
+                Compare local = comp;
+                for (std::size_t i = begin; i < end; i++) {
+                    std::size_t b = bucketOf(data[i], local);
+                    bucketIndex[i] = static_cast<uint16_t>(b);
+                    count[b]++;
+                }
+            });
+        }
+    }
+
+    // offsets[c][b]: where chunk c writes its first element of bucket b
+    std::vector<std::size_t> offsets(chunks * buckets);
+    std::vector<std::size_t> bucketStart(buckets + 1);
+    std::size_t offset = 0;
+    for (std::size_t b = 0; b < buckets; b++) {
+        bucketStart[b] = offset;
+        for (std::size_t c = 0; c < chunks; c++) {
+            offsets[c * buckets + b] = offset;
+            offset += counts[c * buckets + b];
+        }
+    }
+    bucketStart[buckets] = n;
+
+    std::vector<T> buffer(n);
+    {
+        task_group group(pool);
+        for (std::size_t c = 0; c < chunks; c++) {
+            group.run([&, c] {
+                std::size_t begin = c * chunkSize, end = begin + chunkSize < n ? begin + chunkSize : n;
+                std::size_t* next = offsets.data() + c * buckets;
+                for (std::size_t i = begin; i < end; i++)
+                    buffer[next[bucketIndex[i]]++] = std::move(data[i]);
+            });
+        }
+    }
+    {
+        task_group group(pool);
+        for (std::size_t b = 0; b < buckets; b++) {
+            group.run([&, b] {
+                std::size_t begin = bucketStart[b], length = bucketStart[b + 1] - begin;
+                Compare local = comp;
+                sort(buffer.data() + begin, length, local);
+                for (std::size_t i = begin; i < begin + length; i++)
+                    data[i] = std::move(buffer[i]);
+            });
+        }
+    }
+}
+
+// number of elements of a that land in the first k outputs of a stable
+// merge of a and b
+template <typename T, typename Compare>
+std::size_t merge_split(const T* a, std::size_t na, const T* b, std::size_t nb, std::size_t k, Compare& comp) {
+    std::size_t lo = k > nb ? k - nb : 0;
+    std::size_t hi = k < na ? k : na;
+    while (lo < hi) {
+        std::size_t i = (lo + hi) / 2;
+        std::size_t j = k - i;
+        // a[i] goes before b[j - 1]: take more of a
+        if (j > 0 && i < na && !comp(b[j - 1], a[i])) lo = i + 1;
+        else hi = i;
+    }
+    return lo;
+}
+
+// Parallel merge sort: stable-sort one chunk per worker, then merge runs
+// pairwise. Each merge is cut into one piece per worker by merge_split, so
+// the last rounds keep every thread busy too.
+template <typename T, typename Compare>
+void parallel_stable_sort(thread_pool& pool, T* data, std::size_t n, Compare& comp) {
+    std::size_t workers = pool.size();
+    if (n < kParallelThreshold || workers < 2) {
+        stable_sort(data, n, static_cast<T*>(nullptr), comp);
+        return;
+    }
+    std::vector<T> buffer(n);
+    std::vector<std::size_t> runs;
+    const std::size_t chunkSize = (n + workers - 1) / workers;
+    for (std::size_t begin = 0; begin < n; begin += chunkSize) runs.push_back(begin);
+    runs.push_back(n);
+    {
+        task_group group(pool);
+        for (std::size_t r = 0; r + 1 < runs.size(); r++) {
+            group.run([&, r] {
+                Compare local = comp;
+                stable_sort(data + runs[r], runs[r + 1] - runs[r], buffer.data() + runs[r], local);
+            });
+        }
+    }
+
+    T* src = data;
+    T* dst = buffer.data();
+    while (runs.size() > 2) {
+        std::vector<std::size_t> merged;
+        for (std::size_t r = 0; r + 1 < runs.size(); r += 2) merged.push_back(runs[r]);
+        merged.push_back(n);
+
+        // all split points are found before any element is moved out of src
+        std::size_t merges = (runs.size() - 1) / 2;
+        std::vector<std::size_t> splits(merges * (workers + 1));
+        {
+            task_group group(pool);
+            for (std::size_t m = 0; m < merges; m++) {
+                group.run([&, m] {
+                    Compare local = comp;
+                    std::size_t begin = runs[2 * m], mid = runs[2 * m + 1], end = runs[2 * m + 2];
+                    std::size_t na = mid - begin, nb = end - mid;
+                    for (std::size_t p = 0; p <= workers; p++)
+                        splits[m * (workers + 1) + p] =
+                            merge_split(src + begin, na, src + mid, nb, (na + nb) * p / workers, local);
+                });
+            }
+        }
+        {
+            task_group group(pool);
+            for (std::size_t m = 0; m < merges; m++) {
+                for (std::size_t p = 0; p < workers; p++) {
+                    group.run([&, m, p] {
+                        Compare local = comp;
+                        std::size_t begin = runs[2 * m], mid = runs[2 * m + 1], end = runs[2 * m + 2];
+                        std::size_t total = end - begin;
+                        std::size_t k0 = total * p / workers, k1 = total * (p + 1) / workers;
+                        std::size_t i0 = splits[m * (workers + 1) + p], i1 = splits[m * (workers + 1) + p + 1];
+                        merge_into(src + begin + i0, i1 - i0, src + mid + (k0 - i0), (k1 - i1) - (k0 - i0),
+                                   dst + begin + k0, local);
+                    });
+                }
+            }
+            if (runs.size() % 2 == 0) {
+                // odd run out: carried over unchanged
+                std::size_t begin = runs[runs.size() - 2];
+                group.run([=] {
+                    for (std::size_t i = begin; i < n; i++) dst[i] = std::move(src[i]);
+                });
+            }
+        }
+        runs.swap(merged);
+        std::swap(src, dst);
+    }
+    if (src != data) {
+        task_group group(pool);
+        for (std::size_t begin = 0; begin < n; begin += chunkSize) {
+            group.run([=] {
+                std::size_t end = begin + chunkSize < n ? begin + chunkSize : n;
+                for (std::size_t i = begin; i < end; i++) data[i] = std::move(src[i]);
+            });
+        }
+    }
+}
+
+}
+
+template <typename T, typename Compare = std::less<T>>
+void sort(span<T> range, Compare comp = Compare()) {
+    sorting::sort(range.data(), range.size(), comp);
+}
+
+template <typename T, typename A, typename Compare = std::less<T>>
+void sort(vector<T, A>& v, Compare comp = Compare()) {
+    sorting::sort(v.data(), static_cast<std::size_t>(v.size()), comp);
+}
+
+template <typename T, typename Compare = std::less<T>>
+void sort(thread_pool& pool, span<T> range, Compare comp = Compare()) {
+    sorting::parallel_sort(pool, range.data(), range.size(), comp);
+}
+
+template <typename T, typename A, typename Compare = std::less<T>>
+void sort(thread_pool& pool, vector<T, A>& v, Compare comp = Compare()) {
+    sorting::parallel_sort(pool, v.data(), static_cast<std::size_t>(v.size()), comp);
+}
+
+// equivalent elements keep their relative order
+template <typename T, typename Compare = std::less<T>>
+void stable_sort(span<T> range, Compare comp = Compare()) {
+    sorting::stable_sort(range.data(), range.size(), static_cast<T*>(nullptr), comp);
+}
+
+template <typename T, typename A, typename Compare = std::less<T>>
+void stable_sort(vector<T, A>& v, Compare comp = Compare()) {
+    sorting::stable_sort(v.data(), static_cast<std::size_t>(v.size()), static_cast<T*>(nullptr), comp);
+}
+
+template <typename T, typename Compare = std::less<T>>
+void stable_sort(thread_pool& pool, span<T> range, Compare comp = Compare()) {
+    sorting::parallel_stable_sort(pool, range.data(), range.size(), comp);
+}
+
+template <typename T, typename A, typename Compare = std::less<T>>
+void stable_sort(thread_pool& pool, vector<T, A>& v, Compare comp = Compare()) {
+    sorting::parallel_stable_sort(pool, v.data(), static_cast<std::size_t>(v.size()), comp);
+}
+
+// ascending LSD radix sort, whatever the size; stable
+template <typename T>
+void radix_sort(span<T> range) {
+    static_assert(sorting::radix_traits<T>::enabled, "radix_sort needs integer, float or mystl::pair keys");
+    if (range.size() < 2) return;
+    std::vector<T> buffer(range.size());
+    sorting::radix_sort(range.data(), range.size(), buffer.data());
+}
+
+template <typename T, typename A>
+void radix_sort(vector<T, A>& v) {
+    radix_sort(span<T>(v.data(), v.size()));
+}
+
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include <chrono>
+#include <cstdio>
+
+// Minimal timing helpers shared by the benchmark programs in this directory.
+// Build any of them with e.g. `g++ -std=c++17 -O2 -pthread stack_queue_bench.cpp`.
+namespace bench {
+
+using clock = std::chrono::steady_clock;
+
+inline double seconds_since(clock::time_point start) {
+    return std::chrono::duration<double>(clock::now() - start).count();
+}
+
+// run fn once, report ops/sec for the given operation count and return elapsed seconds
+template <typename Fn>
+double run(const char* label, long long ops, Fn&& fn) {
+    auto start = clock::now();
+    fn();
+    double elapsed = seconds_since(start);
+    std::printf("%-48s %10.3f ms %14.0f ops/s\n", label, elapsed * 1e3, ops / elapsed);
+    return elapsed;
+}
+
+// keep the optimizer from discarding a computed value
+template <typename T>
+inline void do_not_optimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+}
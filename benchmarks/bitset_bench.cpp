@@ -0,0 +1,104 @@
+#include "bench.hpp"
+#include "../containers/dynamic_bitset.hpp"
+#include "../containers/unordered_set.hpp"
+
+#include <random>
+#include <vector>
+
+// Dense integer membership in dynamic_bitset against unordered_set<int>, then
+// bulk word-parallel operations and rank/select on their own. Build with
+// -mavx2 -mbmi2 (or -march=native) to use the vector and pdep paths.
+
+constexpr size_t kUniverse = 1 << 22;
+constexpr size_t kBulkBits = size_t(1) << 28;
+constexpr int kQueries = 1 << 22;
+
+void membership() {
+    std::mt19937 rng(1);
+    std::vector<int> keys(kUniverse / 2);
+    for (int& key : keys) key = static_cast<int>(rng() % kUniverse);
+    std::vector<int> queries(kQueries);
+    for (int& q : queries) q = static_cast<int>(rng() % kUniverse);
+
+    std::printf("-- membership, %zu inserts over [0, %zu) --\n", keys.size(), kUniverse);
+
+    mystl::unordered_set<int> set;
+    bench::run("unordered_set<int> insert", keys.size(), [&] {
+        for (int key : keys) set.insert(key);
+    });
+    long long found = 0;
+    bench::run("unordered_set<int> lookup", kQueries, [&] {
+        for (int q : queries) found += set.find(q) != set.end();
+    });
+
+    mystl::dynamic_bitset bitset(kUniverse);
+    bench::run("dynamic_bitset set", keys.size(), [&] {
+        for (int key : keys) bitset.set(static_cast<size_t>(key));
+    });
+    bench::run("dynamic_bitset test", kQueries, [&] {
+        for (int q : queries) found += bitset[static_cast<size_t>(q)];
+    });
+    bench::do_not_optimize(found);
+
+    // a node per key (32 bytes after malloc rounding) plus one bucket pointer per bucket
+    double setBytes = set.size() * 32.0 + set.size() / 0.7 * sizeof(void*);
+    std::printf("memory: unordered_set ~%.1f MB (%.1f bytes/key), dynamic_bitset %.1f MB (%.2f bytes/key)\n",
+                setBytes / 1e6, setBytes / set.size(), bitset.size_in_bytes() / 1e6,
+                static_cast<double>(bitset.size_in_bytes()) / bitset.count());
+}
+
+void bulk() {
+    std::mt19937_64 rng(2);
+    mystl::dynamic_bitset a(kBulkBits), b(kBulkBits);
+    for (size_t i = 0; i < kBulkBits / 8; i++) {
+        a.set(rng() % kBulkBits);
+        b.set(rng() % kBulkBits);
+    }
+
+    double gigabytes = kBulkBits / 8 / 1e9;
+    std::printf("-- bulk operations over %zu bits --\n", kBulkBits);
+    auto report = [&](const char* label, double seconds, double bytesTouched) {
+        std::printf("%-48s %10.3f ms %11.2f GB/s\n", label, seconds * 1e3, bytesTouched / seconds);
+    };
+
+    auto start = bench::clock::now();
+    size_t ones = a.count();
+    report("count", bench::seconds_since(start), gigabytes);
+
+    start = bench::clock::now();
+    a &= b;
+    report("a &= b", bench::seconds_since(start), 3 * gigabytes);
+
+    start = bench::clock::now();
+    a |= b;
+    report("a |= b", bench::seconds_since(start), 3 * gigabytes);
+
+    start = bench::clock::now();
+    a ^= b;
+    report("a ^= b", bench::seconds_since(start), 3 * gigabytes);
+
+    size_t visited = 0;
+    start = bench::clock::now();
+    for (size_t i = b.find_first(); i != mystl::dynamic_bitset::npos; i = b.find_next(i)) visited++;
+    report("find_first/find_next over b", bench::seconds_since(start), gigabytes);
+    bench::do_not_optimize(ones + visited);
+
+    std::printf("-- rank/select over b (%zu ones) --\n", b.count());
+    bench::run("build rank/select index", 1, [&] { b.rank(0); });
+    std::vector<size_t> positions(kQueries), ranks(kQueries);
+    for (size_t& p : positions) p = rng() % kBulkBits;
+    for (size_t& r : ranks) r = rng() % b.count();
+    size_t sum = 0;
+    bench::run("rank", kQueries, [&] {
+        for (size_t p : positions) sum += b.rank(p);
+    });
+    bench::run("select", kQueries, [&] {
+        for (size_t r : ranks) sum += b.select(r);
+    });
+    bench::do_not_optimize(sum);
+}
+
+int main() {
+    membership();
+    bulk();
+}
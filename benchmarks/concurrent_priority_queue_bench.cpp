@@ -0,0 +1,162 @@
+#include "bench.hpp"
+#include "../containers/concurrent_priority_queue.hpp"
+#include "../containers/priority_queue.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+// Throughput and rank error of concurrent_priority_queue against a
+// mutex-guarded mystl::priority_queue at 1-64 threads. Each thread alternates
+// push and try_pop on a min-queue prefilled with 1M random keys.
+//
+// Rank error: every operation is stamped from a global counter, the log is
+// replayed in stamp order, and each popped key's rank among the keys present
+// at that moment is computed with a Fenwick tree (rank 0 = exact minimum).
+
+constexpr int kPrefill = 1 << 20;
+constexpr long long kOpsPerRun = 4000000;
+
+class locked_priority_queue {
+    mystl::priority_queue<uint64_t, std::greater<uint64_t>, 4> pq;
+    std::mutex m;
+
+public:
+    void push(uint64_t v) {
+        std::lock_guard<std::mutex> lock(m);
+        pq.push(v);
+    }
+
+    bool try_pop(uint64_t& out) {
+        std::lock_guard<std::mutex> lock(m);
+        return pq.try_pop(out);
+    }
+};
+
+struct Event {
+    uint64_t stamp;
+    uint64_t key;
+    bool isPop;
+};
+
+// keys are unique: random high bits, thread and sequence in the low bits
+uint64_t make_key(std::mt19937_64& rng, int thread, uint64_t i) {
+    return (rng() >> 24 << 24) | (static_cast<uint64_t>(thread) << 17) | (i & 0x1FFFF);
+}
+
+template <typename Queue>
+double throughput(Queue& q, int threads) {
+    std::mt19937_64 rng(1);
+    for (int i = 0; i < kPrefill; i++) q.push(make_key(rng, 255, i));
+
+    long long perThread = kOpsPerRun / threads / 2;
+    auto start = bench::clock::now();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t] {
+            std::mt19937_64 local(t + 2);
+            uint64_t out, sum = 0;
+            for (long long i = 0; i < perThread; i++) {
+                q.push(make_key(local, t, i));
+                if (q.try_pop(out)) sum += out;
+            }
+            bench::do_not_optimize(sum);
+        });
+    }
+    for (auto& w : workers) w.join();
+    return kOpsPerRun / bench::seconds_since(start);
+}
+
+struct RankError {
+    double mean;
+    uint64_t max;
+};
+
+template <typename Queue>
+RankError rank_error(Queue& q, int threads) {
+    std::atomic<uint64_t> clock{0};
+    std::vector<Event> prefill;
+    std::mt19937_64 rng(1);
+    for (int i = 0; i < kPrefill / 8; i++) {
+        uint64_t key = make_key(rng, 255, i);
+        q.push(key);
+        prefill.push_back({clock++, key, false});
+    }
+
+    long long perThread = 200000 / threads;
+    std::vector<std::vector<Event>> logs(threads);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t] {
+            std::mt19937_64 local(t + 2);
+            uint64_t out;
+            for (long long i = 0; i < perThread; i++) {
+                uint64_t key = make_key(local, t, i);
+                // stamp a push before it is visible and a pop after it happened, so
+                // the replay never sees a key popped before it was pushed
+                logs[t].push_back({clock.fetch_add(1), key, false});
+                q.push(key);
+                if (q.try_pop(out)) logs[t].push_back({clock.fetch_add(1), out, true});
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    std::vector<Event> events = prefill;
+    for (auto& log : logs) events.insert(events.end(), log.begin(), log.end());
+    std::sort(events.begin(), events.end(), [](const Event& a, const Event& b) { return a.stamp < b.stamp; });
+
+    std::vector<uint64_t> keys;
+    for (const Event& e : events) if (!e.isPop) keys.push_back(e.key);
+    std::sort(keys.begin(), keys.end());
+    std::vector<int> fenwick(keys.size() + 1, 0);
+    auto add = [&](size_t i, int delta) { for (i++; i < fenwick.size(); i += i & -i) fenwick[i] += delta; };
+    auto prefix = [&](size_t i) { long long s = 0; for (; i > 0; i -= i & -i) s += fenwick[i]; return s; };
+
+    double total = 0;
+    uint64_t worst = 0, pops = 0;
+    for (const Event& e : events) {
+        size_t index = std::lower_bound(keys.begin(), keys.end(), e.key) - keys.begin();
+        if (e.isPop) {
+            uint64_t rank = prefix(index);
+            total += rank;
+            worst = std::max(worst, rank);
+            pops++;
+            add(index, -1);
+        } else {
+            add(index, 1);
+        }
+    }
+    return {pops ? total / pops : 0, worst};
+}
+
+int main() {
+    std::printf("%-8s %16s %16s %14s %12s\n", "threads", "mutex ops/s", "multiqueue ops/s", "mean rank err", "max rank err");
+    for (int threads = 1; threads <= 64; threads *= 2) {
+        locked_priority_queue locked;
+        mystl::concurrent_priority_queue<uint64_t, std::greater<uint64_t>> relaxed(threads);
+        double a = throughput(locked, threads);
+        double b = throughput(relaxed, threads);
+
+        mystl::concurrent_priority_queue<uint64_t, std::greater<uint64_t>> measured(threads);
+        RankError err = rank_error(measured, threads);
+        std::printf("%-8d %16.0f %16.0f %14.2f %12llu\n", threads, a, b, err.mean, (unsigned long long)err.max);
+    }
+
+    std::printf("\nrelaxation at 8 threads (queues per thread x pop choices):\n");
+    for (size_t c : {1, 2, 4}) {
+        for (size_t choices : {2, 4}) {
+            mystl::concurrent_priority_queue<uint64_t, std::greater<uint64_t>> q(8, c, choices);
+            double ops = throughput(q, 8);
+            mystl::concurrent_priority_queue<uint64_t, std::greater<uint64_t>> m(8, c, choices);
+            RankError err = rank_error(m, 8);
+            std::printf("  c=%zu choices=%zu  %14.0f ops/s  mean rank err %8.2f  max %llu\n", c, choices, ops,
+                        err.mean, (unsigned long long)err.max);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,141 @@
+#include "bench.hpp"
+#include "../containers/mpmc_queue.hpp"
+#include "../containers/queue.hpp"
+#include "../containers/spsc_queue.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Producer/consumer throughput and enqueue-to-dequeue latency for spsc_queue,
+// mpmc_queue and the mutex-guarded mystl::queue they replace, across thread counts.
+
+constexpr long long kItems = 2000000;
+constexpr size_t kCapacity = 4096;
+
+// the baseline pipelines used: a mystl::queue behind a std::mutex
+class locked_queue {
+    mystl::queue<uint64_t> q;
+    std::mutex m;
+
+public:
+    explicit locked_queue(size_t) {}
+
+    bool try_push(uint64_t v) {
+        std::lock_guard<std::mutex> lock(m);
+        q.push(v);
+        return true;
+    }
+
+    bool try_pop(uint64_t& out) {
+        std::lock_guard<std::mutex> lock(m);
+        return q.try_pop(out);
+    }
+};
+
+uint64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        bench::clock::now().time_since_epoch()).count();
+}
+
+struct Result {
+    double seconds;
+    std::vector<uint64_t> latencies;
+};
+
+// each item is the timestamp at which it was pushed; consumers sample latency
+template <typename Queue>
+Result run_pipeline(int producers, int consumers) {
+    Queue q(kCapacity);
+    std::atomic<long long> consumed{0};
+    std::vector<std::vector<uint64_t>> samples(consumers);
+    long long perProducer = kItems / producers;
+    long long total = perProducer * producers;
+
+    auto start = bench::clock::now();
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; p++) {
+        threads.emplace_back([&] {
+            for (long long i = 0; i < perProducer; i++) {
+                while (!q.try_push(now_ns()))
+                    std::this_thread::yield();
+            }
+        });
+    }
+    for (int c = 0; c < consumers; c++) {
+        threads.emplace_back([&, c] {
+            uint64_t stamp;
+            long long seen = 0;
+            while (consumed.load(std::memory_order_relaxed) < total) {
+                if (q.try_pop(stamp)) {
+                    if ((++seen & 63) == 0) samples[c].push_back(now_ns() - stamp);
+                    consumed.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    Result r{bench::seconds_since(start), {}};
+    for (auto& s : samples) r.latencies.insert(r.latencies.end(), s.begin(), s.end());
+    std::sort(r.latencies.begin(), r.latencies.end());
+    return r;
+}
+
+template <typename Queue>
+void report(const char* name, int producers, int consumers) {
+    Result r = run_pipeline<Queue>(producers, consumers);
+    auto pct = [&](double p) {
+        return r.latencies.empty() ? 0 : r.latencies[static_cast<size_t>(p * (r.latencies.size() - 1))];
+    };
+    std::printf("%-12s %2dP/%2dC %14.0f items/s   p50 %8llu ns   p99 %10llu ns\n", name, producers, consumers,
+                kItems / r.seconds, (unsigned long long)pct(0.5), (unsigned long long)pct(0.99));
+}
+
+// batched SPSC transfer: producer and consumer move 64 items per index update
+void spsc_batched() {
+    mystl::spsc_queue<uint64_t> q(kCapacity);
+    std::thread producer([&] {
+        uint64_t buf[64];
+        for (long long i = 0; i < kItems;) {
+            size_t want = std::min<long long>(64, kItems - i);
+            for (size_t k = 0; k < want; k++) buf[k] = i + k;
+            size_t n = q.try_push_batch(buf, want);
+            if (!n) std::this_thread::yield();
+            i += n;
+        }
+    });
+    uint64_t buf[64];
+    uint64_t sum = 0;
+    bench::run("spsc_queue batch(64) 1P/1C", kItems, [&] {
+        for (long long got = 0; got < kItems;) {
+            size_t n = q.try_pop_batch(buf, 64);
+            if (!n) std::this_thread::yield();
+            for (size_t k = 0; k < n; k++) sum += buf[k];
+            got += n;
+        }
+        producer.join();
+    });
+    bench::do_not_optimize(sum);
+}
+
+int main() {
+    unsigned hw = std::max(2u, std::thread::hardware_concurrency());
+    std::printf("hardware threads: %u\n", hw);
+
+    report<mystl::spsc_queue<uint64_t>>("spsc_queue", 1, 1);
+    report<mystl::mpmc_queue<uint64_t>>("mpmc_queue", 1, 1);
+    report<locked_queue>("mutex+queue", 1, 1);
+    spsc_batched();
+
+    for (int threads = 2; threads <= static_cast<int>(hw) && threads <= 16; threads *= 2) {
+        report<mystl::mpmc_queue<uint64_t>>("mpmc_queue", threads, threads);
+        report<locked_queue>("mutex+queue", threads, threads);
+    }
+    return 0;
+}
@@ -0,0 +1,62 @@
+#include "bench.hpp"
+#include "../containers/concurrent_stack.hpp"
+#include "../containers/stack.hpp"
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Push/pop throughput of concurrent_stack (with and without the elimination
+// array) against a mutex-guarded mystl::stack at 1-64 threads. Each thread
+// alternates push and pop, the most contended pattern for a single top pointer.
+
+constexpr long long kTotalOps = 4000000;
+
+class locked_stack {
+    mystl::stack<long> s;
+    std::mutex m;
+
+public:
+    void push(long v) {
+        std::lock_guard<std::mutex> lock(m);
+        s.push(v);
+    }
+
+    bool try_pop(long& out) {
+        std::lock_guard<std::mutex> lock(m);
+        return s.try_pop(out);
+    }
+};
+
+template <typename Stack>
+double run(Stack& s, int threads) {
+    long long perThread = kTotalOps / threads / 2;
+    auto start = bench::clock::now();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&] {
+            long value, sum = 0;
+            for (long long i = 0; i < perThread; i++) {
+                s.push(static_cast<long>(i));
+                if (s.try_pop(value)) sum += value;
+            }
+            bench::do_not_optimize(sum);
+        });
+    }
+    for (auto& w : workers) w.join();
+    return bench::seconds_since(start);
+}
+
+int main() {
+    std::printf("%-8s %18s %18s %18s\n", "threads", "mutex+stack", "treiber", "treiber+elim");
+    for (int threads = 1; threads <= 64; threads *= 2) {
+        locked_stack locked;
+        mystl::concurrent_stack<long> plain(0);
+        mystl::concurrent_stack<long> eliminating(16);
+        double a = run(locked, threads);
+        double b = run(plain, threads);
+        double c = run(eliminating, threads);
+        std::printf("%-8d %14.0f/s %14.0f/s %14.0f/s\n", threads, kTotalOps / a, kTotalOps / b, kTotalOps / c);
+    }
+    return 0;
+}
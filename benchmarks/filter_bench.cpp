@@ -0,0 +1,79 @@
+#include "bench.hpp"
+#include "../containers/filtered.hpp"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+// Lookup throughput of unordered_set, unordered_map and map with and without a
+// Bloom or cuckoo filter in front, as the share of lookups that hit goes from
+// 1% to 99%. Present keys are even, absent keys odd, both drawn at random.
+
+constexpr int kKeys = 1 << 19;
+constexpr int kLookups = 1 << 22;
+
+std::vector<int> make_lookups(int hitPercent) {
+    std::mt19937 rng(hitPercent);
+    std::vector<int> lookups(kLookups);
+    for (int& key : lookups) {
+        int base = static_cast<int>(rng() % kKeys) * 2;
+        key = static_cast<int>(rng() % 100) < hitPercent ? base : base + 1;
+    }
+    return lookups;
+}
+
+// the unfiltered containers do not agree on a membership test
+bool lookup(mystl::unordered_set<int>& s, int key) { return s.find(key) != s.end(); }
+bool lookup(mystl::unordered_map<int, int>& m, int key) { return m.contains(key); }
+bool lookup(mystl::map<int, int>& m, int key) { return m.contains(key); }
+
+template <typename Fn>
+void measure(const char* name, int hitPercent, Fn&& contains, const std::vector<int>& lookups) {
+    char label[96];
+    std::snprintf(label, sizeof(label), "%-30s %2d%% hits", name, hitPercent);
+    long long found = 0;
+    bench::run(label, kLookups, [&] {
+        for (int key : lookups) found += contains(key);
+    });
+    bench::do_not_optimize(found);
+}
+
+template <typename Plain, typename Bloom, typename Cuckoo, typename Insert>
+void compare(const char* name, Insert&& insert, const std::vector<int>& hitPercents) {
+    Plain plain;
+    Bloom bloom(kKeys);
+    Cuckoo cuckoo(kKeys);
+    for (int i = 0; i < kKeys; i++) {
+        insert(plain, 2 * i);
+        insert(bloom, 2 * i);
+        insert(cuckoo, 2 * i);
+    }
+
+    std::printf("-- %s, %d keys --\n", name, kKeys);
+    std::string plainName = name;
+    std::string bloomName = plainName + " + bloom";
+    std::string cuckooName = plainName + " + cuckoo";
+    for (int hitPercent : hitPercents) {
+        std::vector<int> lookups = make_lookups(hitPercent);
+        measure(plainName.c_str(), hitPercent, [&](int k) { return lookup(plain, k); }, lookups);
+        measure(bloomName.c_str(), hitPercent, [&](int k) { return bloom.contains(k); }, lookups);
+        measure(cuckooName.c_str(), hitPercent, [&](int k) { return cuckoo.contains(k); }, lookups);
+    }
+}
+
+int main() {
+    std::vector<int> hitPercents = {1, 10, 50, 90, 99};
+
+    compare<mystl::unordered_set<int>, mystl::filtered_unordered_set<int>,
+            mystl::filtered_unordered_set<int, mystl::cuckoo_filter<int>>>(
+        "unordered_set", [](auto& s, int k) { s.insert(k); }, hitPercents);
+
+    compare<mystl::unordered_map<int, int>, mystl::filtered_unordered_map<int, int>,
+            mystl::filtered_unordered_map<int, int, mystl::cuckoo_filter<int>>>(
+        "unordered_map", [](auto& m, int k) { m.insert(k, k); }, hitPercents);
+
+    compare<mystl::map<int, int>, mystl::filtered_map<int, int>,
+            mystl::filtered_map<int, int, mystl::cuckoo_filter<int>>>(
+        "map", [](auto& m, int k) { m.insert(k, k); }, hitPercents);
+}
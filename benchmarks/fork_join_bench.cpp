@@ -0,0 +1,104 @@
+#include "bench.hpp"
+#include "../containers/deque.hpp"
+#include "../containers/work_stealing_deque.hpp"
+#include "../utilities/thread_pool.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+// Fork-join scaling of the work-stealing thread_pool (parallel fib and parallel
+// sum), plus owner push/pop cost of work_stealing_deque against the
+// mutex-guarded mystl::deque it replaces as a per-worker task list.
+
+long long fib_seq(int n) {
+    return n < 2 ? n : fib_seq(n - 1) + fib_seq(n - 2);
+}
+
+long long fib_par(mystl::thread_pool& pool, int n) {
+    if (n < 20) return fib_seq(n);
+    long long a = 0, b = 0;
+    mystl::task_group group(pool);
+    group.run([&] { a = fib_par(pool, n - 1); });
+    b = fib_par(pool, n - 2);
+    group.wait();
+    return a + b;
+}
+
+long long sum_par(mystl::thread_pool& pool, const long long* data, size_t n) {
+    if (n <= 64 * 1024) return std::accumulate(data, data + n, 0LL);
+    long long left = 0, right = 0;
+    mystl::task_group group(pool);
+    group.run([&] { left = sum_par(pool, data, n / 2); });
+    right = sum_par(pool, data + n / 2, n - n / 2);
+    group.wait();
+    return left + right;
+}
+
+void owner_push_pop() {
+    const long long ops = 10 * 1000 * 1000;
+    mystl::work_stealing_deque<long long> ws;
+    long long sum = 0;
+    bench::run("work_stealing_deque owner push+pop", 2 * ops, [&] {
+        for (long long i = 0; i < ops; i++) {
+            ws.push(i);
+            long long v;
+            if (ws.try_pop(v)) sum += v;
+        }
+    });
+
+    mystl::deque<long long> dq;
+    std::mutex m;
+    bench::run("mutex + mystl::deque push+pop", 2 * ops, [&] {
+        for (long long i = 0; i < ops; i++) {
+            {
+                std::lock_guard<std::mutex> lock(m);
+                dq.push_back(i);
+            }
+            std::lock_guard<std::mutex> lock(m);
+            sum += dq.back();
+            dq.pop_back();
+        }
+    });
+    bench::do_not_optimize(sum);
+}
+
+int main() {
+    owner_push_pop();
+
+    const int fibN = 38;
+    std::vector<long long> data(1 << 25);
+    std::iota(data.begin(), data.end(), 0);
+
+    double fibBase = 0, sumBase = 0;
+    {
+        auto start = bench::clock::now();
+        bench::do_not_optimize(fib_seq(fibN));
+        fibBase = bench::seconds_since(start);
+        start = bench::clock::now();
+        bench::do_not_optimize(std::accumulate(data.begin(), data.end(), 0LL));
+        sumBase = bench::seconds_since(start);
+    }
+    std::printf("sequential: fib(%d) %.1f ms, sum(%zu) %.1f ms\n", fibN, fibBase * 1e3, data.size(), sumBase * 1e3);
+
+    unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned threads = 1; threads <= std::max(hw, 8u); threads *= 2) {
+        mystl::thread_pool pool(threads);
+        long long result = 0;
+
+        auto start = bench::clock::now();
+        result += fib_par(pool, fibN);
+        double fibTime = bench::seconds_since(start);
+
+        start = bench::clock::now();
+        result += sum_par(pool, data.data(), data.size());
+        double sumTime = bench::seconds_since(start);
+
+        bench::do_not_optimize(result);
+        std::printf("%2u threads: fib %8.1f ms (x%.2f)   sum %8.1f ms (x%.2f)\n", threads, fibTime * 1e3,
+                    fibBase / fibTime, sumTime * 1e3, sumBase / sumTime);
+    }
+    return 0;
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// Synthetic weighted digraph in CSR form shared by the shortest-path benchmarks.
+struct Graph {
+    std::vector<uint32_t> offsets;
+    std::vector<uint32_t> targets;
+    std::vector<uint32_t> weights;
+};
+
+inline Graph make_graph(uint32_t nodes, uint32_t degree, uint32_t seed) {
+    std::mt19937 rng(seed);
+    Graph g;
+    g.offsets.resize(nodes + 1);
+    g.targets.reserve(static_cast<size_t>(nodes) * (degree + 1));
+    g.weights.reserve(g.targets.capacity());
+    for (uint32_t u = 0; u < nodes; u++) {
+        g.offsets[u] = static_cast<uint32_t>(g.targets.size());
+        // ring edge keeps every node reachable
+        g.targets.push_back((u + 1) % nodes);
+        g.weights.push_back(1 + rng() % 1000);
+        for (uint32_t e = 0; e < degree; e++) {
+            g.targets.push_back(rng() % nodes);
+            g.weights.push_back(1 + rng() % 1000);
+        }
+    }
+    g.offsets[nodes] = static_cast<uint32_t>(g.targets.size());
+    return g;
+}
@@ -0,0 +1,109 @@
+#include "bench.hpp"
+#include "graph.hpp"
+#include "../containers/pairing_heap.hpp"
+#include "../containers/priority_queue.hpp"
+#include "../containers/radix_heap.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+// mystl::priority_queue, mystl::pairing_heap and mystl::radix_heap on two
+// monotone min-heap workloads: a timer queue (expire everything due, schedule
+// new deadlines relative to now) and Dijkstra with integer weights.
+
+using Key = uint64_t;
+using Item = std::pair<Key, uint32_t>;
+
+// uniform key/value surface over the three engines
+struct BinaryHeap {
+    mystl::priority_queue<Item, std::greater<Item>> h;
+    void push(Key k, uint32_t v) { h.push({k, v}); }
+    Key top_key() const { return h.top().first; }
+    uint32_t top_value() const { return h.top().second; }
+    void pop() { h.pop(); }
+    bool empty() const { return h.empty(); }
+};
+
+struct PairingHeap {
+    mystl::pairing_heap<Item, std::greater<Item>> h;
+    void push(Key k, uint32_t v) { h.push({k, v}); }
+    Key top_key() const { return h.top().first; }
+    uint32_t top_value() const { return h.top().second; }
+    void pop() { h.pop(); }
+    bool empty() const { return h.empty(); }
+};
+
+struct RadixHeap {
+    mystl::radix_heap<Key, uint32_t> h;
+    void push(Key k, uint32_t v) { h.push(k, v); }
+    Key top_key() const { return h.top().first; }
+    uint32_t top_value() const { return h.top().second; }
+    void pop() { h.pop(); }
+    bool empty() const { return h.empty(); }
+};
+
+// 100k live timers; each tick fires the due ones and re-arms them 1-10000 ticks out
+template <typename Heap>
+void timers(const char* label) {
+    std::mt19937 rng(3);
+    Heap heap;
+    const int live = 100000;
+    for (int i = 0; i < live; i++) heap.push(1 + rng() % 10000, i);
+
+    const Key ticks = 20000;
+    long long fired = 0;
+    auto start = bench::clock::now();
+    for (Key now = 1; now <= ticks; now++) {
+        while (!heap.empty() && heap.top_key() <= now) {
+            uint32_t id = heap.top_value();
+            heap.pop();
+            heap.push(now + 1 + rng() % 10000, id);
+            fired++;
+        }
+    }
+    double elapsed = bench::seconds_since(start);
+    std::printf("%-48s %10.3f ms %14.0f timers/s\n", label, elapsed * 1e3, fired / elapsed);
+}
+
+template <typename Heap>
+void dijkstra(const char* label, const Graph& g) {
+    size_t n = g.offsets.size() - 1;
+    std::vector<Key> dist(n, std::numeric_limits<Key>::max());
+    Key checksum = 0;
+    bench::run(label, g.targets.size(), [&] {
+        Heap heap;
+        dist[0] = 0;
+        heap.push(0, 0);
+        while (!heap.empty()) {
+            Key d = heap.top_key();
+            uint32_t u = heap.top_value();
+            heap.pop();
+            if (d != dist[u]) continue;
+            for (uint32_t e = g.offsets[u]; e < g.offsets[u + 1]; e++) {
+                uint32_t v = g.targets[e];
+                Key nd = d + g.weights[e];
+                if (nd < dist[v]) {
+                    dist[v] = nd;
+                    heap.push(nd, v);
+                }
+            }
+        }
+    });
+    for (Key d : dist) checksum += d;
+    bench::do_not_optimize(checksum);
+}
+
+int main() {
+    timers<BinaryHeap>("timers: priority_queue");
+    timers<PairingHeap>("timers: pairing_heap");
+    timers<RadixHeap>("timers: radix_heap");
+
+    Graph g = make_graph(1000000, 8, 7);
+    dijkstra<BinaryHeap>("dijkstra 1M nodes: priority_queue", g);
+    dijkstra<PairingHeap>("dijkstra 1M nodes: pairing_heap", g);
+    dijkstra<RadixHeap>("dijkstra 1M nodes: radix_heap", g);
+    return 0;
+}
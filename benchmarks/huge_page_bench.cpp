@@ -0,0 +1,81 @@
+#include "bench.hpp"
+#include "../containers/unordered_map.hpp"
+#include "../containers/vector.hpp"
+#include "../utilities/page_allocation.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+// Random-access throughput over large arrays with the default heap allocation
+// versus mapped_allocation: huge pages (explicit if reserved in
+// /proc/sys/vm/nr_hugepages, else transparent huge pages via madvise) and
+// NUMA interleaving. Random probes into a table much larger than the TLB
+// reach of 4 KB pages miss the TLB on nearly every access; 2 MB pages cover
+// 512x more memory per entry.
+//
+// Pass a size in MB to override the vector size, e.g. `./huge_page_bench 4096`.
+
+// AnonHugePages from /proc/self/smaps_rollup, in MB (0 if unavailable)
+long anon_huge_mb() {
+    long kb = 0;
+    if (FILE* f = std::fopen("/proc/self/smaps_rollup", "r")) {
+        char line[256];
+        while (std::fgets(line, sizeof(line), f))
+            if (std::sscanf(line, "AnonHugePages: %ld kB", &kb) == 1) break;
+        std::fclose(f);
+    }
+    return kb / 1024;
+}
+
+template <typename Allocation>
+void gather(const char* label, size_t n, const mystl::vector<uint64_t>& probes) {
+    mystl::vector<uint64_t, Allocation> table;
+    table.reserve(n);
+    for (size_t i = 0; i < n; i++) table.push_back(i * 0x9E3779B97F4A7C15ull);
+    long huge = anon_huge_mb();
+
+    uint64_t sum = 0;
+    const uint64_t* data = table.data();
+    bench::run(label, probes.size(), [&] {
+        for (size_t i = 0; i < probes.size(); i++) sum += data[probes[i] % n];
+    });
+    bench::do_not_optimize(sum);
+    std::printf("    AnonHugePages while mapped: %ld MB\n", huge);
+}
+
+template <typename Allocation>
+void lookups(const char* label, size_t keys, const mystl::vector<uint64_t>& probes) {
+    mystl::unordered_map<uint64_t, uint64_t, std::hash<uint64_t>, Allocation> table;
+    for (size_t i = 0; i < keys; i++) table.insert(i * 7919, i);
+
+    uint64_t hits = 0;
+    bench::run(label, probes.size(), [&] {
+        for (size_t i = 0; i < probes.size(); i++) hits += table.contains((probes[i] % keys) * 7919);
+    });
+    bench::do_not_optimize(hits);
+    std::printf("    %zu buckets (%.0f MB bucket array)\n", table.bucket_count(),
+                table.bucket_count() * sizeof(void*) / 1e6);
+}
+
+int main(int argc, char** argv) {
+    size_t megabytes = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1024;
+    size_t n = megabytes * (1 << 20) / sizeof(uint64_t);
+
+    std::mt19937_64 rng(23);
+    mystl::vector<uint64_t> probes;
+    probes.reserve(1 << 24);
+    for (int i = 0; i < (1 << 24); i++) probes.push_back(rng());
+
+    std::printf("-- random reads, vector<uint64_t> of %zu MB\n", megabytes);
+    gather<mystl::heap_allocation>("heap", n, probes);
+    gather<mystl::huge_page_allocation<>>("huge pages", n, probes);
+    gather<mystl::huge_page_allocation<mystl::numa_placement::interleave>>("huge pages, NUMA interleaved", n, probes);
+
+    size_t keys = 1 << 22;
+    std::printf("-- random contains(), unordered_map with %zu keys\n", keys);
+    lookups<mystl::heap_allocation>("heap buckets", keys, probes);
+    lookups<mystl::huge_page_allocation<>>("huge-page buckets", keys, probes);
+    return 0;
+}
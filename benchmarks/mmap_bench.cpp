@@ -0,0 +1,97 @@
+#include "bench.hpp"
+#include "../containers/mmap_unordered_map.hpp"
+#include "../containers/mmap_vector.hpp"
+#include "../containers/unordered_map.hpp"
+#include "../containers/vector.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+// Startup cost of getting a large data set ready to query: rebuilding
+// vector/unordered_map from a text file (what a process without persistent
+// containers does on every start) versus reopening mmap_vector /
+// mmap_unordered_map files written by an earlier run. Reopening maps the file
+// and validates a header; pages fault in lazily as the first queries touch
+// them, so the first-query pass is timed separately.
+//
+// Files go to the directory given as the first argument (default /tmp).
+
+constexpr size_t kCount = 1 << 22;
+constexpr size_t kProbes = 1 << 20;
+
+uint64_t keyOf(size_t i) {
+    return i * 0x9E3779B97F4A7C15ull;
+}
+
+void writeText(const std::string& path) {
+    FILE* f = std::fopen(path.c_str(), "w");
+    if (!f) std::exit(1);
+    for (size_t i = 0; i < kCount; i++) std::fprintf(f, "%llu %zu\n", (unsigned long long)keyOf(i), i);
+    std::fclose(f);
+}
+
+void writeMapped(const std::string& vectorPath, const std::string& mapPath) {
+    std::remove(vectorPath.c_str());
+    std::remove(mapPath.c_str());
+    mystl::mmap_vector<uint64_t> v(vectorPath, kCount);
+    mystl::mmap_unordered_map<uint64_t, uint64_t> m(mapPath, kCount);
+    for (size_t i = 0; i < kCount; i++) {
+        v.push_back(keyOf(i));
+        m.insert(keyOf(i), i);
+    }
+}
+
+template <typename Map>
+uint64_t probe(const Map& m) {
+    uint64_t sum = 0;
+    for (size_t i = 0; i < kProbes; i++) sum += m.getValue(keyOf(i * 7 % kCount));
+    return sum;
+}
+
+int main(int argc, char** argv) {
+    std::string dir = argc > 1 ? argv[1] : "/tmp";
+    std::string textPath = dir + "/mystl_mmap_bench.txt";
+    std::string vectorPath = dir + "/mystl_mmap_bench.vec";
+    std::string mapPath = dir + "/mystl_mmap_bench.map";
+
+    writeText(textPath);
+    writeMapped(vectorPath, mapPath);
+    std::printf("-- %zu entries, files in %s (page cache warm)\n", kCount, dir.c_str());
+
+    uint64_t sum = 0;
+    {
+        mystl::vector<uint64_t> keys;
+        mystl::unordered_map<uint64_t, uint64_t> table;
+        bench::run("rebuild vector + unordered_map from text", kCount, [&] {
+            FILE* f = std::fopen(textPath.c_str(), "r");
+            unsigned long long key;
+            size_t value;
+            keys.reserve(kCount);
+            while (std::fscanf(f, "%llu %zu", &key, &value) == 2) {
+                keys.push_back(key);
+                table.insert(key, value);
+            }
+            std::fclose(f);
+        });
+        bench::run("  first queries", kProbes, [&] { sum += probe(table); });
+    }
+    {
+        double elapsed = bench::run("reopen mmap_vector + mmap_unordered_map", kCount, [&] {
+            mystl::mmap_vector<uint64_t> keys(vectorPath);
+            mystl::mmap_unordered_map<uint64_t, uint64_t> table(mapPath);
+            sum += keys.size() + table.size();
+        });
+        std::printf("    %.1f us per open\n", elapsed * 1e6 / 2);
+        mystl::mmap_unordered_map<uint64_t, uint64_t> table(mapPath);
+        bench::run("  first queries (faulting pages in)", kProbes, [&] { sum += probe(table); });
+        bench::run("  repeat queries", kProbes, [&] { sum += probe(table); });
+    }
+    bench::do_not_optimize(sum);
+
+    std::remove(textPath.c_str());
+    std::remove(vectorPath.c_str());
+    std::remove(mapPath.c_str());
+    return 0;
+}
@@ -0,0 +1,87 @@
+#include "bench.hpp"
+#include "../utilities/pair.hpp"
+#include "../utilities/tuple.hpp"
+
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+// Sort and copy throughput for vectors of pairs. legacy_pair reproduces the
+// old mystl::pair (user-provided copy constructor and assignment, no moves),
+// which keeps std::vector and std::copy off their memmove paths.
+
+constexpr int kElements = 1 << 20;
+constexpr int kRounds = 20;
+
+template <typename T1, typename T2>
+struct legacy_pair {
+    T1 first;
+    T2 second;
+
+    legacy_pair() : first(), second() {}
+    legacy_pair(const T1& a, const T2& b) : first(a), second(b) {}
+    legacy_pair(const legacy_pair& other) : first(other.first), second(other.second) {}
+
+    legacy_pair& operator=(const legacy_pair& other) {
+        if (this != &other) {
+            first = other.first;
+            second = other.second;
+        }
+        return *this;
+    }
+
+    bool operator<(const legacy_pair& rhs) const {
+        return first < rhs.first || (!(rhs.first < first) && second < rhs.second);
+    }
+};
+
+template <typename P>
+std::vector<P> random_pairs() {
+    std::mt19937 rng(7);
+    std::vector<P> v;
+    v.reserve(kElements);
+    for (int i = 0; i < kElements; i++)
+        v.push_back(P(static_cast<int>(rng() % 1000), static_cast<int>(rng())));
+    return v;
+}
+
+template <typename P>
+void workload(const char* name) {
+    std::vector<P> source = random_pairs<P>();
+    char label[96];
+
+    std::snprintf(label, sizeof(label), "%s copy", name);
+    double copySeconds = bench::run(label, 1LL * kElements * kRounds, [&] {
+        std::vector<P> dst(source.size());
+        for (int r = 0; r < kRounds; r++) {
+            std::copy(source.begin(), source.end(), dst.begin());
+            bench::do_not_optimize(dst[r]);
+        }
+    });
+    std::printf("%-48s %10.2f GB/s\n", "", 1.0 * kElements * kRounds * sizeof(P) / copySeconds / 1e9);
+
+    std::snprintf(label, sizeof(label), "%s vector growth", name);
+    bench::run(label, 1LL * kElements * 4, [&] {
+        for (int r = 0; r < 4; r++) {
+            std::vector<P> grown;
+            for (int i = 0; i < kElements; i++) grown.push_back(source[i]);
+            bench::do_not_optimize(grown.back());
+        }
+    });
+
+    std::snprintf(label, sizeof(label), "%s sort", name);
+    bench::run(label, kElements, [&] {
+        std::vector<P> v = source;
+        std::sort(v.begin(), v.end());
+        bench::do_not_optimize(v.front());
+    });
+}
+
+int main() {
+    workload<legacy_pair<int, int>>("legacy pair<int,int>");
+    workload<mystl::pair<int, int>>("mystl::pair<int,int>");
+    workload<std::pair<int, int>>("std::pair<int,int>");
+    workload<mystl::tuple<int, int>>("mystl::tuple<int,int>");
+    return 0;
+}
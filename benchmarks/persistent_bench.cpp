@@ -0,0 +1,105 @@
+#include "bench.hpp"
+#include "../containers/map.hpp"
+#include "../containers/persistent_map.hpp"
+#include "../containers/persistent_vector.hpp"
+#include "../containers/vector.hpp"
+
+#include <random>
+#include <vector>
+
+// Snapshot-heavy workload: a writer applies random updates and, every
+// `interval` updates, a reader takes a snapshot and does a few lookups in it.
+// The mutable containers have to deep-copy to give the reader a stable view;
+// the persistent ones hand out the current version in O(1).
+
+constexpr int kMapKeys = 1 << 15;
+constexpr int kVectorSize = 1 << 16;
+constexpr int kUpdates = 5000;
+constexpr int kReadsPerSnapshot = 16;
+
+template <typename Fn>
+void report(const char* what, int interval, Fn&& fn) {
+    char label[96];
+    std::snprintf(label, sizeof(label), "%s, snapshot every %d", what, interval);
+    bench::run(label, kUpdates, fn);
+}
+
+void map_workload(int interval) {
+    mystl::map<int, int> mutableMap;
+    mystl::persistent_map<int, int> persistentMap;
+    for (int i = 0; i < kMapKeys; i += 2) {
+        mutableMap.insert(i, i);
+        persistentMap = persistentMap.insert(i, i);
+    }
+
+    report("map deep copy", interval, [&] {
+        std::mt19937 rng(1);
+        long long sum = 0;
+        for (int i = 0; i < kUpdates; i++) {
+            mutableMap.insert(static_cast<int>(rng() % kMapKeys), i);
+            if (i % interval == 0) {
+                mystl::map<int, int> snapshot = mutableMap;
+                for (int r = 0; r < kReadsPerSnapshot; r++) sum += snapshot[static_cast<int>(rng() % kMapKeys) & ~1];
+            }
+        }
+        bench::do_not_optimize(sum);
+    });
+
+    report("persistent_map", interval, [&] {
+        std::mt19937 rng(1);
+        long long sum = 0;
+        for (int i = 0; i < kUpdates; i++) {
+            persistentMap = persistentMap.insert(static_cast<int>(rng() % kMapKeys), i);
+            if (i % interval == 0) {
+                mystl::persistent_map<int, int> snapshot = persistentMap;
+                for (int r = 0; r < kReadsPerSnapshot; r++) sum += snapshot[static_cast<int>(rng() % kMapKeys) & ~1];
+            }
+        }
+        bench::do_not_optimize(sum);
+    });
+}
+
+void vector_workload(int interval) {
+    mystl::vector<int> mutableVector;
+    mystl::persistent_vector<int> persistentVector;
+    for (int i = 0; i < kVectorSize; i++) {
+        mutableVector.push_back(i);
+        persistentVector = persistentVector.push_back(i);
+    }
+
+    report("vector deep copy", interval, [&] {
+        std::mt19937 rng(1);
+        long long sum = 0;
+        for (int i = 0; i < kUpdates; i++) {
+            mutableVector[static_cast<int>(rng() % kVectorSize)] = i;
+            if (i % interval == 0) {
+                mystl::vector<int> snapshot = mutableVector;
+                for (int r = 0; r < kReadsPerSnapshot; r++) sum += snapshot[static_cast<int>(rng() % kVectorSize)];
+            }
+        }
+        bench::do_not_optimize(sum);
+    });
+
+    report("persistent_vector", interval, [&] {
+        std::mt19937 rng(1);
+        long long sum = 0;
+        for (int i = 0; i < kUpdates; i++) {
+            persistentVector = persistentVector.set(static_cast<int>(rng() % kVectorSize), i);
+            if (i % interval == 0) {
+                mystl::persistent_vector<int> snapshot = persistentVector;
+                for (int r = 0; r < kReadsPerSnapshot; r++) sum += snapshot[static_cast<int>(rng() % kVectorSize)];
+            }
+        }
+        bench::do_not_optimize(sum);
+    });
+}
+
+int main() {
+    std::printf("-- map, %d keys, updates/s --\n", kMapKeys / 2);
+    for (int interval : {1, 16, 256})
+        map_workload(interval);
+
+    std::printf("-- vector, %d elements, updates/s --\n", kVectorSize);
+    for (int interval : {1, 16, 256})
+        vector_workload(interval);
+}
@@ -0,0 +1,86 @@
+#include "bench.hpp"
+#include "../containers/priority_queue.hpp"
+
+#include <array>
+#include <random>
+#include <string>
+#include <vector>
+
+// push/pop throughput of mystl::priority_queue across heap arities and element
+// sizes, plus push_range (Floyd heapify) against pushing one element at a time.
+
+template <std::size_t Bytes>
+struct Payload {
+    unsigned key;
+    std::array<char, Bytes - sizeof(unsigned)> pad;
+
+    Payload(unsigned k = 0) : key(k), pad() {}
+    bool operator<(const Payload& other) const { return key < other.key; }
+};
+
+struct StringKey {
+    std::string s;
+
+    StringKey(unsigned k = 0) : s(24, 'a') { s.replace(0, sizeof(k), reinterpret_cast<const char*>(&k), sizeof(k)); }
+    bool operator<(const StringKey& other) const { return s < other.s; }
+};
+
+constexpr int kElements = 1 << 20;
+
+template <typename T, std::size_t Arity>
+void push_pop(const char* type, const std::vector<unsigned>& keys) {
+    char label[96];
+    std::snprintf(label, sizeof(label), "%-14s arity %zu push+pop", type, Arity);
+    mystl::priority_queue<T, std::less<T>, Arity> pq;
+    pq.reserve(keys.size());
+    unsigned checksum = 0;
+    bench::run(label, 2LL * keys.size(), [&] {
+        for (unsigned k : keys) pq.push(T(k));
+        while (!pq.empty()) {
+            checksum += 1;
+            pq.pop();
+        }
+    });
+    bench::do_not_optimize(checksum);
+}
+
+template <typename T>
+void all_arities(const char* type, const std::vector<unsigned>& keys) {
+    push_pop<T, 2>(type, keys);
+    push_pop<T, 4>(type, keys);
+    push_pop<T, 8>(type, keys);
+}
+
+template <std::size_t Arity>
+void bulk_build(const std::vector<unsigned>& keys) {
+    char label[96];
+    std::snprintf(label, sizeof(label), "arity %zu push_range (Floyd)", Arity);
+    bench::run(label, keys.size(), [&] {
+        mystl::priority_queue<unsigned, std::less<unsigned>, Arity> pq;
+        pq.push_range(keys.begin(), keys.end());
+        bench::do_not_optimize(pq.top());
+    });
+
+    std::snprintf(label, sizeof(label), "arity %zu push one by one", Arity);
+    bench::run(label, keys.size(), [&] {
+        mystl::priority_queue<unsigned, std::less<unsigned>, Arity> pq;
+        for (unsigned k : keys) pq.push(k);
+        bench::do_not_optimize(pq.top());
+    });
+}
+
+int main() {
+    std::mt19937 rng(42);
+    std::vector<unsigned> keys(kElements);
+    for (auto& k : keys) k = rng();
+
+    bulk_build<2>(keys);
+    bulk_build<4>(keys);
+    bulk_build<8>(keys);
+
+    all_arities<unsigned>("uint32", keys);
+    all_arities<Payload<32>>("32B struct", keys);
+    all_arities<Payload<128>>("128B struct", keys);
+    all_arities<StringKey>("std::string", keys);
+    return 0;
+}
@@ -0,0 +1,156 @@
+#include "bench.hpp"
+#include "../containers/unordered_map.hpp"
+#include "../utilities/rcu_ptr.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Reader throughput on a lookup table while a writer keeps rebuilding and
+// republishing it. Each read is one lookup, so the cost of getting at the
+// current version dominates. Compares rcu_ptr with the usual alternatives:
+// a shared_mutex around the table pointer, and a mutex-guarded shared_ptr that
+// readers copy (an atomic increment and decrement per read). The batched rcu_ptr
+// run holds one read handle across 256 lookups.
+
+constexpr int kKeys = 4096;
+constexpr double kSeconds = 0.5;
+
+using Table = mystl::unordered_map<int, int>;
+
+std::unique_ptr<Table> build(int generation) {
+    auto table = std::make_unique<Table>();
+    for (int k = 0; k < kKeys; k++) table->insert(k, k + generation);
+    return table;
+}
+
+class rcu_table {
+    mystl::rcu_ptr<Table> table{build(0)};
+
+public:
+    int lookup(int key) { return table.read()->getValue(key); }
+
+    template <typename Fn>
+    void batch(Fn&& fn) { fn(*this); }
+    void publish(std::unique_ptr<Table> next) { table.publish(std::move(next)); }
+};
+
+// one pinned handle per batch of lookups, the intended pattern for hot loops
+class rcu_batched_table {
+    mystl::rcu_ptr<Table> table{build(0)};
+
+public:
+    template <typename Fn>
+    void batch(Fn&& fn) {
+        auto current = table.read();
+        fn(*current);
+    }
+
+    void publish(std::unique_ptr<Table> next) { table.publish(std::move(next)); }
+};
+
+class rwlock_table {
+    std::unique_ptr<Table> table = build(0);
+    std::shared_mutex lock;
+
+public:
+    int lookup(int key) {
+        std::shared_lock<std::shared_mutex> guard(lock);
+        return table->getValue(key);
+    }
+
+    template <typename Fn>
+    void batch(Fn&& fn) { fn(*this); }
+
+    void publish(std::unique_ptr<Table> next) {
+        std::unique_lock<std::shared_mutex> guard(lock);
+        table.swap(next);
+    }
+};
+
+class shared_ptr_table {
+    std::shared_ptr<const Table> table = build(0);
+    std::mutex lock;
+
+public:
+    int lookup(int key) {
+        std::shared_ptr<const Table> snapshot;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            snapshot = table;
+        }
+        return snapshot->getValue(key);
+    }
+
+    template <typename Fn>
+    void batch(Fn&& fn) { fn(*this); }
+
+    void publish(std::unique_ptr<Table> next) {
+        std::shared_ptr<const Table> fresh(std::move(next));
+        std::lock_guard<std::mutex> guard(lock);
+        table.swap(fresh);
+    }
+};
+
+template <typename Source>
+int lookup(Source& source, int key) {
+    if constexpr (std::is_same_v<Source, const Table>) return source.getValue(key);
+    else return source.lookup(key);
+}
+
+// run readers for kSeconds with or without a republishing writer
+template <typename Impl>
+void run(const char* name, int readers, bool republish) {
+    Impl impl;
+    std::atomic<bool> stop{false};
+    std::atomic<long long> reads{0};
+    long long publishes = 0;
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < readers; t++) {
+        workers.emplace_back([&, t] {
+            unsigned key = t * 7919;
+            long long local = 0, sum = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                impl.batch([&](auto& source) {
+                    for (int i = 0; i < 256; i++) {
+                        key = key * 1103515245 + 12345;
+                        sum += lookup(source, static_cast<int>((key >> 8) % kKeys));
+                    }
+                });
+                local += 256;
+            }
+            bench::do_not_optimize(sum);
+            reads += local;
+        });
+    }
+
+    auto start = bench::clock::now();
+    if (republish) {
+        while (bench::seconds_since(start) < kSeconds) impl.publish(build(static_cast<int>(++publishes)));
+    } else {
+        std::this_thread::sleep_for(std::chrono::duration<double>(kSeconds));
+    }
+    stop = true;
+    for (auto& w : workers) w.join();
+    double elapsed = bench::seconds_since(start);
+
+    std::printf("%-18s %2d readers, %-11s %14.0f reads/s %8.0f publishes/s\n", name, readers,
+                republish ? "republish" : "static", reads / elapsed, publishes / elapsed);
+}
+
+int main() {
+    int hw = static_cast<int>(std::max(2u, std::thread::hardware_concurrency()));
+    for (int readers : {1, hw}) {
+        for (bool republish : {false, true}) {
+            run<rcu_table>("rcu_ptr", readers, republish);
+            run<rcu_batched_table>("rcu_ptr batched", readers, republish);
+            run<rwlock_table>("shared_mutex", readers, republish);
+            run<shared_ptr_table>("mutex+shared_ptr", readers, republish);
+        }
+    }
+}
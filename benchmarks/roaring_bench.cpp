@@ -0,0 +1,130 @@
+#include "bench.hpp"
+#include "../containers/roaring_set.hpp"
+#include "../containers/set.hpp"
+#include "../containers/unordered_set.hpp"
+
+#include <malloc.h>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Memory footprint and set-algebra throughput of roaring_set against the
+// node-based set and unordered_set, on sparse, dense and clustered 32-bit IDs.
+// Memory is the growth of the glibc heap while building each container. The
+// tree and hash baselines intersect by merging in-order walks and by probing
+// respectively, and unite by inserting both inputs into a fresh container.
+
+constexpr size_t kValues = 1 << 20;
+
+size_t heap_in_use() {
+    return mallinfo2().uordblks;
+}
+
+std::vector<uint32_t> make_values(const std::string& kind, uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::vector<uint32_t> values;
+    values.reserve(kValues);
+    while (values.size() < kValues) {
+        if (kind == "sparse") {
+            values.push_back(rng());
+        } else if (kind == "dense") {
+            values.push_back(rng() % (2 * kValues));
+        } else {
+            uint32_t start = rng() % (1u << 28);
+            for (uint32_t i = 0; i < 1000 && values.size() < kValues; i++) values.push_back(start + i);
+        }
+    }
+    return values;
+}
+
+template <typename Build>
+auto measure_build(const char* label, Build&& build) {
+    size_t before = heap_in_use();
+    auto start = bench::clock::now();
+    auto container = build();
+    double seconds = bench::seconds_since(start);
+    size_t bytes = heap_in_use() - before;
+    std::printf("%-32s build %9.1f ms %10.2f MB %7.2f bytes/value\n", label, seconds * 1e3, bytes / 1e6,
+                static_cast<double>(bytes) / kValues);
+    return container;
+}
+
+void run(const std::string& kind) {
+    std::printf("-- %s, %zu values per set --\n", kind.c_str(), kValues);
+    std::vector<uint32_t> a = make_values(kind, 1), b = make_values(kind, 2);
+
+    auto roaringA = measure_build("roaring_set", [&] {
+        mystl::roaring_set s(a.begin(), a.end());
+        s.run_optimize();
+        return s;
+    });
+    mystl::roaring_set roaringB(b.begin(), b.end());
+    roaringB.run_optimize();
+
+    auto* treeA = measure_build("set<uint32_t>", [&] {
+        auto* s = new mystl::set<uint32_t>();
+        for (uint32_t v : a) s->insert(v);
+        return s;
+    });
+    mystl::set<uint32_t> treeB;
+    for (uint32_t v : b) treeB.insert(v);
+
+    auto* hashA = measure_build("unordered_set<uint32_t>", [&] {
+        auto* s = new mystl::unordered_set<uint32_t>();
+        for (uint32_t v : a) s->insert(v);
+        return s;
+    });
+    mystl::unordered_set<uint32_t> hashB;
+    for (uint32_t v : b) hashB.insert(v);
+
+    size_t sink = 0;
+    bench::run("roaring_set a & b", kValues, [&] { sink += (roaringA & roaringB).size(); });
+    bench::run("roaring_set a | b", kValues, [&] { sink += (roaringA | roaringB).size(); });
+    bench::run("roaring_set a - b", kValues, [&] { sink += (roaringA - roaringB).size(); });
+
+    bench::run("set a & b (merge walk)", kValues, [&] {
+        auto i = treeA->begin(), j = treeB.begin();
+        while (i != treeA->end() && j != treeB.end()) {
+            if (*i < *j) ++i;
+            else if (*j < *i) ++j;
+            else { sink++; ++i; ++j; }
+        }
+    });
+    bench::run("set a | b (insert both)", kValues, [&] {
+        mystl::set<uint32_t> result;
+        for (uint32_t v : *treeA) result.insert(v);
+        for (uint32_t v : treeB) result.insert(v);
+        sink += result.begin() != result.end();
+    });
+
+    bench::run("unordered_set a & b (probe)", kValues, [&] {
+        for (auto it = hashA->begin(); it != hashA->end(); ++it) sink += hashB.find(*it) != hashB.end();
+    });
+    bench::run("unordered_set a | b (insert both)", kValues, [&] {
+        mystl::unordered_set<uint32_t> result;
+        for (auto it = hashA->begin(); it != hashA->end(); ++it) result.insert(*it);
+        for (auto it = hashB.begin(); it != hashB.end(); ++it) result.insert(*it);
+        sink += result.size();
+    });
+
+    bench::run("roaring_set ordered iteration", roaringA.size(), [&] {
+        for (uint32_t v : roaringA) sink += v;
+    });
+
+    std::stringstream buffer;
+    bench::run("roaring_set serialize", roaringA.size(), [&] { roaringA.serialize(buffer); });
+    std::printf("serialized %.2f MB\n", buffer.str().size() / 1e6);
+    bench::run("roaring_set deserialize", roaringA.size(), [&] {
+        sink += mystl::roaring_set::deserialize(buffer).size();
+    });
+    bench::do_not_optimize(sink);
+
+    delete treeA;
+    delete hashA;
+}
+
+int main() {
+    for (const char* kind : {"sparse", "dense", "clustered"})
+        run(kind);
+}
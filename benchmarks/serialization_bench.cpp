@@ -0,0 +1,84 @@
+#include "bench.hpp"
+#include "../containers/map.hpp"
+#include "../containers/string.hpp"
+#include "../containers/unordered_map.hpp"
+#include "../containers/vector.hpp"
+#include "../utilities/serialization.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <sstream>
+#include <string>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+// Serialize / deserialize throughput in GB/s of encoded bytes, to an in-memory
+// stream and through a file descriptor (page cache, no fsync). vector<double>
+// is one bulk write and one bulk read; map is loaded with the O(n) sorted
+// bottom-up build, compared with inserting the same keys one at a time;
+// unordered_map loads into a bucket array sized up front.
+//
+// Pass a directory for the fd runs as the first argument (default /tmp).
+
+constexpr size_t kDoubles = 1 << 25;   // 256 MB
+constexpr size_t kKeys = 1 << 20;
+
+template <typename T>
+void roundTrip(const char* label, const T& value, const std::string& path) {
+    std::stringstream stream;
+    auto start = bench::clock::now();
+    mystl::serialize(stream, value);
+    double writeSeconds = bench::seconds_since(start);
+    double bytes = static_cast<double>(stream.tellp());
+
+    start = bench::clock::now();
+    T copy = mystl::deserialize<T>(stream);
+    double readSeconds = bench::seconds_since(start);
+    bench::do_not_optimize(copy);
+    std::printf("%-40s %8.1f MB  stream  write %6.2f GB/s  read %6.2f GB/s\n", label, bytes / 1e6,
+                bytes / writeSeconds / 1e9, bytes / readSeconds / 1e9);
+
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return;
+    start = bench::clock::now();
+    mystl::serialize(fd, value);
+    writeSeconds = bench::seconds_since(start);
+    lseek(fd, 0, SEEK_SET);
+    start = bench::clock::now();
+    T fromFile = mystl::deserialize<T>(fd);
+    readSeconds = bench::seconds_since(start);
+    bench::do_not_optimize(fromFile);
+    ::close(fd);
+    std::remove(path.c_str());
+    std::printf("%-40s %8s     fd      write %6.2f GB/s  read %6.2f GB/s\n", "", "",
+                bytes / writeSeconds / 1e9, bytes / readSeconds / 1e9);
+}
+
+int main(int argc, char** argv) {
+    std::string path = std::string(argc > 1 ? argv[1] : "/tmp") + "/mystl_serialization_bench.bin";
+
+    mystl::vector<double> doubles;
+    doubles.reserve(kDoubles);
+    for (size_t i = 0; i < kDoubles; i++) doubles.push_back(i * 0.5);
+    roundTrip("vector<double>", doubles, path);
+
+    mystl::vector<mystl::string> strings;
+    for (size_t i = 0; i < kKeys; i++) strings.push_back(mystl::string(std::to_string(i * 7919).c_str()));
+    roundTrip("vector<string>", strings, path);
+
+    mystl::map<uint64_t, uint64_t> tree;
+    for (size_t i = 0; i < kKeys; i++) tree.insert(i * 0x9E3779B97F4A7C15ull, i);
+    roundTrip("map<uint64_t, uint64_t>", tree, path);
+
+    bench::run("  map rebuilt by insert() instead", kKeys, [&] {
+        mystl::map<uint64_t, uint64_t> copy;
+        for (auto [k, v] : tree) copy.insert(k, v);
+        bench::do_not_optimize(copy);
+    });
+
+    mystl::unordered_map<uint64_t, uint64_t> table;
+    for (size_t i = 0; i < kKeys; i++) table.insert(i * 0x9E3779B97F4A7C15ull, i);
+    roundTrip("unordered_map<uint64_t, uint64_t>", table, path);
+    return 0;
+}
@@ -0,0 +1,102 @@
+#include "bench.hpp"
+#include "graph.hpp"
+#include "../containers/indexed_priority_queue.hpp"
+#include "../containers/priority_queue.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+// Dijkstra on a synthetic million-node graph: mystl::priority_queue with lazy
+// deletion (push duplicates, skip stale entries) against
+// mystl::indexed_priority_queue with decrease_key. Reports runtime and peak heap size.
+
+using Dist = uint64_t;
+constexpr Dist kInf = std::numeric_limits<Dist>::max();
+
+struct Stats {
+    Dist checksum = 0;
+    size_t peakHeap = 0;
+    size_t pushes = 0;
+};
+
+Stats dijkstra_lazy(const Graph& g, uint32_t source) {
+    size_t n = g.offsets.size() - 1;
+    std::vector<Dist> dist(n, kInf);
+    mystl::priority_queue<std::pair<Dist, uint32_t>, std::greater<std::pair<Dist, uint32_t>>, 4> pq;
+    Stats s;
+
+    dist[source] = 0;
+    pq.push({0, source});
+    s.pushes++;
+    while (!pq.empty()) {
+        auto [d, u] = pq.top();
+        pq.pop();
+        if (d != dist[u]) continue;  // stale duplicate
+        for (uint32_t e = g.offsets[u]; e < g.offsets[u + 1]; e++) {
+            uint32_t v = g.targets[e];
+            Dist nd = d + g.weights[e];
+            if (nd < dist[v]) {
+                dist[v] = nd;
+                pq.push({nd, v});
+                s.pushes++;
+                if (static_cast<size_t>(pq.size()) > s.peakHeap) s.peakHeap = pq.size();
+            }
+        }
+    }
+    for (Dist d : dist) s.checksum += d;
+    return s;
+}
+
+Stats dijkstra_indexed(const Graph& g, uint32_t source) {
+    using PQ = mystl::indexed_priority_queue<std::pair<Dist, uint32_t>, std::greater<std::pair<Dist, uint32_t>>, 4>;
+    size_t n = g.offsets.size() - 1;
+    std::vector<Dist> dist(n, kInf);
+    std::vector<PQ::handle> handleOf(n);
+    std::vector<bool> queued(n, false);
+    PQ pq;
+    Stats s;
+
+    dist[source] = 0;
+    handleOf[source] = pq.push({0, source});
+    queued[source] = true;
+    s.pushes++;
+    while (!pq.empty()) {
+        auto [d, u] = pq.top();
+        pq.pop();
+        queued[u] = false;
+        for (uint32_t e = g.offsets[u]; e < g.offsets[u + 1]; e++) {
+            uint32_t v = g.targets[e];
+            Dist nd = d + g.weights[e];
+            if (nd < dist[v]) {
+                if (queued[v]) {
+                    pq.decrease_key(handleOf[v], {nd, v});
+                } else {
+                    handleOf[v] = pq.push({nd, v});
+                    queued[v] = true;
+                    s.pushes++;
+                    if (static_cast<size_t>(pq.size()) > s.peakHeap) s.peakHeap = pq.size();
+                }
+                dist[v] = nd;
+            }
+        }
+    }
+    for (Dist d : dist) s.checksum += d;
+    return s;
+}
+
+int main() {
+    const uint32_t nodes = 1000000;
+    Graph g = make_graph(nodes, 8, 7);
+    std::printf("graph: %u nodes, %zu edges\n", nodes, g.targets.size());
+
+    Stats lazy, indexed;
+    bench::run("priority_queue + lazy deletion", g.targets.size(), [&] { lazy = dijkstra_lazy(g, 0); });
+    bench::run("indexed_priority_queue + decrease_key", g.targets.size(), [&] { indexed = dijkstra_indexed(g, 0); });
+
+    std::printf("lazy:    peak heap %9zu  pushes %9zu\n", lazy.peakHeap, lazy.pushes);
+    std::printf("indexed: peak heap %9zu  pushes %9zu\n", indexed.peakHeap, indexed.pushes);
+    std::printf("distances %s\n", lazy.checksum == indexed.checksum ? "match" : "DIFFER");
+    return 0;
+}
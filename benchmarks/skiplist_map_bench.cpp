@@ -0,0 +1,110 @@
+#include "bench.hpp"
+#include "../containers/map.hpp"
+#include "../containers/skiplist_map.hpp"
+
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+// Mixed read/write scaling of skiplist_map against a mutex-wrapped mystl::map.
+// Even keys are prefilled and only ever read; writes insert and erase odd keys,
+// so every read hits and both maps see the same key population.
+
+constexpr int kKeys = 1 << 18;
+constexpr long long kOpsPerRun = 2000000;
+
+class locked_map {
+    mystl::map<int, int> m;
+    std::mutex lock;
+
+public:
+    void insert(int k, int v) {
+        std::lock_guard<std::mutex> guard(lock);
+        m.insert(k, v);
+    }
+
+    void erase(int k) {
+        std::lock_guard<std::mutex> guard(lock);
+        m.erase(k);
+    }
+
+    int read(int k) {
+        std::lock_guard<std::mutex> guard(lock);
+        return m[k];
+    }
+
+    // sum of up to n entries starting at the beginning: the map has no lower_bound
+    long long scan(int, int n) {
+        std::lock_guard<std::mutex> guard(lock);
+        long long sum = 0;
+        for (auto it = m.begin(); it != m.end() && n-- > 0; ++it) sum += (*it).second;
+        return sum;
+    }
+};
+
+class lockfree_map {
+    mystl::skiplist_map<int, int> m;
+
+public:
+    void insert(int k, int v) { m.insert(k, v); }
+    void erase(int k) { m.erase(k); }
+    int read(int k) { return m.getValue(k); }
+
+    long long scan(int from, int n) {
+        long long sum = 0;
+        for (auto it = m.lower_bound(from); it != m.end() && n-- > 0; ++it) sum += (*it).second;
+        return sum;
+    }
+};
+
+// writePercent of operations are writes, 1% are 16-entry range scans, the rest point reads
+template <typename Map>
+double run(Map& m, int threads, int writePercent) {
+    long long perThread = kOpsPerRun / threads;
+    auto start = bench::clock::now();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t] {
+            std::mt19937 rng(t + 1);
+            long long sum = 0;
+            for (long long i = 0; i < perThread; i++) {
+                int dice = rng() % 100;
+                int key = static_cast<int>(rng() % kKeys);
+                if (dice < writePercent) {
+                    int odd = key | 1;
+                    if (rng() & 1) m.insert(odd, odd);
+                    else m.erase(odd);
+                } else if (dice == 99) {
+                    sum += m.scan(key, 16);
+                } else {
+                    sum += m.read(key & ~1);
+                }
+            }
+            bench::do_not_optimize(sum);
+        });
+    }
+    for (auto& w : workers) w.join();
+    return kOpsPerRun / bench::seconds_since(start);
+}
+
+template <typename Map>
+void prefill(Map& m) {
+    for (int k = 0; k < kKeys; k += 2) m.insert(k, k);
+}
+
+int main() {
+    for (int writePercent : {1, 10, 50}) {
+        std::printf("\n%d%% writes\n%-8s %18s %18s\n", writePercent, "threads", "mutex+map ops/s", "skiplist_map ops/s");
+        for (int threads = 1; threads <= 16; threads *= 2) {
+            locked_map locked;
+            lockfree_map skiplist;
+            prefill(locked);
+            prefill(skiplist);
+            double a = run(locked, threads, writePercent);
+            double b = run(skiplist, threads, writePercent);
+            std::printf("%-8d %18.0f %18.0f\n", threads, a, b);
+        }
+    }
+    return 0;
+}
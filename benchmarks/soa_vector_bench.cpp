@@ -0,0 +1,99 @@
+#include "bench.hpp"
+#include "../containers/soa_vector.hpp"
+#include "../containers/vector.hpp"
+
+#include <random>
+
+// Column scans over a table of trades stored two ways: an array of 64-byte
+// structs in mystl::vector, and one array per field in mystl::soa_vector.
+// The scans touch one or two 8-byte fields, so the struct layout drags
+// 64 bytes through the cache for every 8 or 16 it uses.
+
+constexpr int kRows = 1 << 20;
+constexpr int kRounds = 50;
+
+struct Trade {
+    long long id;
+    double price;
+    double quantity;
+    long long timestamp;
+    int venue;
+    int flags;
+    char symbol[24];
+};
+
+using TradeTable = mystl::soa_vector<long long, double, double, long long, int, int>;
+enum { kId, kPrice, kQuantity, kTimestamp, kVenue, kFlags };
+
+int main() {
+    std::mt19937 rng(3);
+    mystl::vector<Trade> aos;
+    aos.reserve(kRows);
+    TradeTable soa;
+    soa.reserve(kRows);
+    for (int i = 0; i < kRows; i++) {
+        Trade t{};
+        t.id = i;
+        t.price = 100.0 + rng() % 1000 / 100.0;
+        t.quantity = rng() % 500;
+        t.timestamp = i * 10LL;
+        t.venue = static_cast<int>(rng() % 8);
+        aos.push_back(t);
+        soa.emplace_back(t.id, t.price, t.quantity, t.timestamp, t.venue, t.flags);
+    }
+    const Trade* rows = &aos[0];
+    long long ops = 1LL * kRows * kRounds;
+
+    bench::run("aos sum(price)", ops, [&] {
+        double sum = 0;
+        for (int r = 0; r < kRounds; r++)
+            for (int i = 0; i < kRows; i++) sum += rows[i].price;
+        bench::do_not_optimize(sum);
+    });
+
+    bench::run("soa sum(price)", ops, [&] {
+        double sum = 0;
+        for (int r = 0; r < kRounds; r++)
+            for (double p : soa.column<kPrice>()) sum += p;
+        bench::do_not_optimize(sum);
+    });
+
+    bench::run("aos sum(price * quantity)", ops, [&] {
+        double sum = 0;
+        for (int r = 0; r < kRounds; r++)
+            for (int i = 0; i < kRows; i++) sum += rows[i].price * rows[i].quantity;
+        bench::do_not_optimize(sum);
+    });
+
+    bench::run("soa sum(price * quantity)", ops, [&] {
+        double sum = 0;
+        auto price = soa.column<kPrice>();
+        auto quantity = soa.column<kQuantity>();
+        for (int r = 0; r < kRounds; r++)
+            for (std::size_t i = 0; i < price.size(); i++) sum += price[i] * quantity[i];
+        bench::do_not_optimize(sum);
+    });
+
+    bench::run("aos count(venue == 3)", ops, [&] {
+        long long count = 0;
+        for (int r = 0; r < kRounds; r++)
+            for (int i = 0; i < kRows; i++) count += rows[i].venue == 3;
+        bench::do_not_optimize(count);
+    });
+
+    bench::run("soa count(venue == 3)", ops, [&] {
+        long long count = 0;
+        for (int r = 0; r < kRounds; r++)
+            for (int v : soa.column<kVenue>()) count += v == 3;
+        bench::do_not_optimize(count);
+    });
+
+    // whole-row access pays for the tuple of references but stays correct
+    bench::run("soa row access sum(price)", 1LL * kRows, [&] {
+        double sum = 0;
+        for (auto row : soa) sum += mystl::get<kPrice>(row);
+        bench::do_not_optimize(sum);
+    });
+
+    return 0;
+}
@@ -0,0 +1,126 @@
+#include "bench.hpp"
+#include "../algorithms/sort.hpp"
+#include "../containers/vector.hpp"
+#include "../utilities/pair.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+#include <string>
+
+// mystl::sort / stable_sort against std::sort / std::stable_sort on
+// mystl::vector data, across sizes, key distributions and thread counts.
+// Integer and pair keys with the default order take the radix path; the
+// lambda comparator forces the comparison sorts. Pass a size to override
+// the largest run, e.g. `./sort_bench 50000000`.
+
+enum class Distribution { Uniform, FewDistinct, Sorted, Reversed };
+
+const char* name_of(Distribution d) {
+    switch (d) {
+    case Distribution::Uniform: return "uniform";
+    case Distribution::FewDistinct: return "16 distinct";
+    case Distribution::Sorted: return "sorted";
+    default: return "reversed";
+    }
+}
+
+mystl::vector<uint32_t> make_keys(int n, Distribution d) {
+    std::mt19937 rng(42);
+    mystl::vector<uint32_t> v;
+    v.reserve(n);
+    for (int i = 0; i < n; i++) {
+        switch (d) {
+        case Distribution::Uniform: v.push_back(rng()); break;
+        case Distribution::FewDistinct: v.push_back(rng() % 16); break;
+        case Distribution::Sorted: v.push_back(i); break;
+        case Distribution::Reversed: v.push_back(n - i); break;
+        }
+    }
+    return v;
+}
+
+template <typename T, typename Fn>
+void time_sort(const char* label, const mystl::vector<T>& input, Fn&& sorter) {
+    mystl::vector<T> v = input;
+    bench::run(label, v.size(), [&] { sorter(v); });
+    for (size_t i = 1; i < v.size(); i++) {
+        if (v[i] < v[i - 1]) {
+            std::printf("  NOT SORTED at %zu\n", i);
+            break;
+        }
+    }
+}
+
+void key_suite(int n, Distribution d, mystl::thread_pool& pool) {
+    std::printf("-- uint32 keys, n = %d, %s\n", n, name_of(d));
+    mystl::vector<uint32_t> keys = make_keys(n, d);
+    auto less = [](uint32_t a, uint32_t b) { return a < b; };
+
+    time_sort("std::sort", keys, [](auto& v) { std::sort(v.data(), v.data() + v.size()); });
+    time_sort("mystl::sort (radix)", keys, [](auto& v) { mystl::sort(v); });
+    time_sort("mystl::sort (comparator)", keys, [&](auto& v) { mystl::sort(v, less); });
+    time_sort("mystl::sort (comparator, pool)", keys, [&](auto& v) { mystl::sort(pool, v, less); });
+    time_sort("std::stable_sort", keys, [](auto& v) { std::stable_sort(v.data(), v.data() + v.size()); });
+    time_sort("mystl::stable_sort (comparator)", keys, [&](auto& v) { mystl::stable_sort(v, less); });
+    time_sort("mystl::stable_sort (comparator, pool)", keys, [&](auto& v) { mystl::stable_sort(pool, v, less); });
+}
+
+void pair_suite(int n, mystl::thread_pool& pool) {
+    std::printf("-- pair<uint32, uint32>, n = %d, uniform keys\n", n);
+    std::mt19937 rng(7);
+    mystl::vector<mystl::pair<uint32_t, uint32_t>> pairs;
+    pairs.reserve(n);
+    for (int i = 0; i < n; i++) pairs.push_back(mystl::make_pair(static_cast<uint32_t>(rng()), static_cast<uint32_t>(i)));
+
+    time_sort("std::sort", pairs, [](auto& v) { std::sort(v.data(), v.data() + v.size()); });
+    time_sort("mystl::sort (radix)", pairs, [](auto& v) { mystl::sort(v); });
+    time_sort("mystl::sort (pool)", pairs, [&](auto& v) { mystl::sort(pool, v); });
+    time_sort("mystl::stable_sort (radix)", pairs, [](auto& v) { mystl::stable_sort(v); });
+}
+
+void float_suite(int n, mystl::thread_pool& pool) {
+    std::printf("-- float, n = %d, normal distribution\n", n);
+    std::mt19937 rng(9);
+    std::normal_distribution<float> normal(0.0f, 100.0f);
+    mystl::vector<float> values;
+    values.reserve(n);
+    for (int i = 0; i < n; i++) values.push_back(normal(rng));
+
+    time_sort("std::sort", values, [](auto& v) { std::sort(v.data(), v.data() + v.size()); });
+    time_sort("mystl::sort (radix)", values, [](auto& v) { mystl::sort(v); });
+    time_sort("mystl::sort (pool)", values, [&](auto& v) { mystl::sort(pool, v); });
+}
+
+void string_suite(int n, mystl::thread_pool& pool) {
+    std::printf("-- std::string, n = %d\n", n);
+    std::mt19937 rng(3);
+    mystl::vector<std::string> words;
+    words.reserve(n);
+    for (int i = 0; i < n; i++) words.push_back("key-" + std::to_string(rng()));
+
+    time_sort("std::sort", words, [](auto& v) { std::sort(v.data(), v.data() + v.size()); });
+    time_sort("mystl::sort", words, [](auto& v) { mystl::sort(v); });
+    time_sort("mystl::sort (pool)", words, [&](auto& v) { mystl::sort(pool, v); });
+    time_sort("mystl::stable_sort (pool)", words, [&](auto& v) { mystl::stable_sort(pool, v); });
+}
+
+int main(int argc, char** argv) {
+    int largest = argc > 1 ? std::atoi(argv[1]) : 1 << 23;
+    for (size_t threads : {size_t(1), size_t(2), size_t(4), size_t(std::thread::hardware_concurrency())}) {
+        if (threads == 0) continue;
+        mystl::thread_pool pool(threads);
+        std::printf("== pool of %zu threads\n", threads);
+        for (int n : {1 << 12, 1 << 16, 1 << 20, largest}) {
+            if (n > largest) continue;
+            key_suite(n, Distribution::Uniform, pool);
+        }
+        key_suite(largest, Distribution::FewDistinct, pool);
+        key_suite(largest, Distribution::Sorted, pool);
+        key_suite(largest, Distribution::Reversed, pool);
+        pair_suite(largest, pool);
+        float_suite(largest, pool);
+        string_suite(largest / 8, pool);
+    }
+    return 0;
+}
@@ -0,0 +1,93 @@
+#include "bench.hpp"
+#include "../containers/deque.hpp"
+#include "../containers/queue.hpp"
+#include "../containers/stack.hpp"
+
+#include <string>
+
+// Compares the contiguous default backing of mystl::stack / mystl::queue with the
+// linked-node layout they used to have (reproduced here by backing them with mystl::deque).
+
+constexpr int kRounds = 200;
+constexpr int kBurst = 10000;
+
+template <typename Stack>
+void stack_cycle(const char* label) {
+    Stack s;
+    long long sum = 0;
+    bench::run(label, 2LL * kRounds * kBurst, [&] {
+        for (int r = 0; r < kRounds; r++) {
+            for (int i = 0; i < kBurst; i++) s.push(i);
+            while (!s.empty()) {
+                sum += s.top();
+                s.pop();
+            }
+        }
+    });
+    bench::do_not_optimize(sum);
+}
+
+template <typename Queue>
+void queue_cycle(const char* label) {
+    Queue q;
+    long long sum = 0;
+    bench::run(label, 2LL * kRounds * kBurst, [&] {
+        for (int r = 0; r < kRounds; r++) {
+            for (int i = 0; i < kBurst; i++) q.push(i);
+            while (!q.empty()) {
+                sum += q.front();
+                q.pop();
+            }
+        }
+    });
+    bench::do_not_optimize(sum);
+}
+
+// steady state: queue hovers around a fixed depth, the shape of a work queue
+template <typename Queue>
+void queue_steady(const char* label) {
+    Queue q;
+    for (int i = 0; i < 1024; i++) q.push(i);
+    long long sum = 0;
+    const long long ops = 4LL * 1000 * 1000;
+    bench::run(label, 2 * ops, [&] {
+        for (long long i = 0; i < ops; i++) {
+            q.push(static_cast<int>(i));
+            sum += q.front();
+            q.pop();
+        }
+    });
+    bench::do_not_optimize(sum);
+}
+
+template <typename Queue>
+void queue_strings(const char* label) {
+    Queue q;
+    std::string payload(48, 'x');
+    const long long ops = 1000 * 1000;
+    size_t total = 0;
+    bench::run(label, 2 * ops, [&] {
+        for (long long i = 0; i < ops; i++) {
+            q.emplace(payload);
+            std::string out;
+            q.try_pop(out);
+            total += out.size();
+        }
+    });
+    bench::do_not_optimize(total);
+}
+
+int main() {
+    stack_cycle<mystl::stack<int>>("stack<int> vector (burst)");
+    stack_cycle<mystl::stack<int, mystl::deque<int>>>("stack<int> linked nodes (burst)");
+
+    queue_cycle<mystl::queue<int>>("queue<int> circular_buffer (burst)");
+    queue_cycle<mystl::queue<int, mystl::deque<int>>>("queue<int> linked nodes (burst)");
+
+    queue_steady<mystl::queue<int>>("queue<int> circular_buffer (steady)");
+    queue_steady<mystl::queue<int, mystl::deque<int>>>("queue<int> linked nodes (steady)");
+
+    queue_strings<mystl::queue<std::string>>("queue<string> circular_buffer (move out)");
+    queue_strings<mystl::queue<std::string, mystl::deque<std::string>>>("queue<string> linked nodes (move out)");
+    return 0;
+}
@@ -0,0 +1,115 @@
+#include "bench.hpp"
+#include "../containers/priority_queue.hpp"
+#include "../containers/timer_wheel.hpp"
+
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+// High-cancellation timeout workload: every tick schedules a burst of timeouts
+// 1-10000 ticks out and cancels 90% of them before they fire (the common fate of
+// request timeouts). timer_wheel against the plain approach of a
+// mystl::priority_queue of deadlines plus a cancelled flag checked on pop.
+
+constexpr uint64_t kTicks = 20000;
+constexpr int kPerTick = 200;
+constexpr int kCancelPercent = 90;
+
+// baseline: heap of (deadline, id), cancellation is a tombstone
+class heap_timers {
+    mystl::priority_queue<std::pair<uint64_t, uint32_t>, std::greater<std::pair<uint64_t, uint32_t>>> heap;
+    std::vector<bool> cancelled;
+
+public:
+    uint32_t schedule(uint64_t deadline) {
+        uint32_t id = static_cast<uint32_t>(cancelled.size());
+        cancelled.push_back(false);
+        heap.push({deadline, id});
+        return id;
+    }
+
+    void cancel(uint32_t id) {
+        cancelled[id] = true;
+    }
+
+    void advance(uint64_t now, std::vector<uint32_t>& out) {
+        while (!heap.empty() && heap.top().first <= now) {
+            uint32_t id = heap.top().second;
+            heap.pop();
+            if (!cancelled[id]) out.push_back(id);
+        }
+    }
+
+    size_t peak = 0;
+    void sample() {
+        if (static_cast<size_t>(heap.size()) > peak) peak = heap.size();
+    }
+};
+
+struct Pending {
+    uint64_t cancelAt;
+    uint64_t id;
+};
+
+template <typename Schedule, typename Cancel, typename Advance>
+long long drive(Schedule schedule, Cancel cancel, Advance advance) {
+    std::mt19937 rng(11);
+    std::vector<std::vector<uint64_t>> cancelBuckets(kTicks + 10001);
+    long long fired = 0;
+    for (uint64_t now = 1; now <= kTicks; now++) {
+        for (int i = 0; i < kPerTick; i++) {
+            uint64_t deadline = now + 1 + rng() % 10000;
+            uint64_t id = schedule(deadline, static_cast<uint32_t>(now * kPerTick + i));
+            if (static_cast<int>(rng() % 100) < kCancelPercent) {
+                // cancelled somewhere before its deadline
+                uint64_t cancelAt = now + rng() % (deadline - now);
+                cancelBuckets[cancelAt].push_back(id);
+            }
+        }
+        for (uint64_t id : cancelBuckets[now]) cancel(id);
+        cancelBuckets[now].clear();
+        fired += advance(now);
+    }
+    return fired;
+}
+
+int main() {
+    const long long ops = static_cast<long long>(kTicks) * kPerTick;
+
+    long long wheelFired = 0;
+    {
+        mystl::timer_wheel<uint32_t> wheel;
+        std::vector<uint32_t> expired;
+        bench::run("timer_wheel schedule/cancel/advance", ops, [&] {
+            wheelFired = drive([&](uint64_t d, uint32_t v) { return wheel.schedule(d, v); },
+                               [&](uint64_t id) { wheel.cancel(id); },
+                               [&](uint64_t now) {
+                                   expired.clear();
+                                   wheel.advance(now, expired);
+                                   return static_cast<long long>(expired.size());
+                               });
+        });
+        std::printf("  live timers at end %zu\n", wheel.size());
+    }
+
+    long long heapFired = 0;
+    {
+        heap_timers heap;
+        std::vector<uint32_t> expired;
+        bench::run("priority_queue + tombstones", ops, [&] {
+            heapFired = drive([&](uint64_t d, uint32_t) { return static_cast<uint64_t>(heap.schedule(d)); },
+                              [&](uint64_t id) { heap.cancel(static_cast<uint32_t>(id)); },
+                              [&](uint64_t now) {
+                                  expired.clear();
+                                  heap.advance(now, expired);
+                                  heap.sample();
+                                  return static_cast<long long>(expired.size());
+                              });
+        });
+        std::printf("  peak heap entries %zu (cancelled timers stay until their deadline)\n", heap.peak);
+    }
+
+    std::printf("fired: wheel %lld, heap %lld\n", wheelFired, heapFired);
+    return 0;
+}
@@ -0,0 +1,83 @@
+#include "bench.hpp"
+#include "../containers/vector.hpp"
+
+#include <numeric>
+#include <random>
+
+// Tight loops over mystl::vector<int/float> through each access path: the
+// by-value get(), the always-checked at(), operator[], iterators and a raw
+// data() pointer. With bounds checks in the loop body the compiler has to
+// keep the scalar loop; without them it vectorizes. operator[] is only
+// unchecked in NDEBUG builds. The loops hoist size(): an int store through
+// b[i] may alias the vector's own int size, which would otherwise be reloaded
+// every iteration. Float sums stay scalar without -ffast-math since the
+// additions cannot be reordered. Compare
+//   g++ -std=c++17 -O3 vector_access_bench.cpp
+//   g++ -std=c++17 -O3 -DNDEBUG vector_access_bench.cpp
+
+template <typename Fn>
+void report(const char* label, int n, int rounds, Fn&& fn) {
+    auto start = bench::clock::now();
+    for (int r = 0; r < rounds; r++) fn();
+    double elapsed = bench::seconds_since(start);
+    std::printf("%-40s %10.3f ms %10.2f elems/ns\n", label, elapsed * 1e3, 1.0 * n * rounds / elapsed / 1e9);
+}
+
+template <typename T>
+void suite(const char* type, int n, int rounds) {
+    std::mt19937 rng(5);
+    mystl::vector<T> a, b;
+    a.reserve(n);
+    b.reserve(n);
+    for (int i = 0; i < n; i++) {
+        a.push_back(static_cast<T>(rng() % 1000));
+        b.push_back(static_cast<T>(rng() % 1000));
+    }
+    std::printf("-- %s, %d elements\n", type, n);
+
+    report("sum: get()", n, rounds, [&] {
+        T total = T();
+        for (size_t i = 0, size = a.size(); i < size; i++) total += a.get(i);
+        bench::do_not_optimize(total);
+    });
+    report("sum: at()", n, rounds, [&] {
+        T total = T();
+        for (size_t i = 0, size = a.size(); i < size; i++) total += a.at(i);
+        bench::do_not_optimize(total);
+    });
+    report("sum: operator[]", n, rounds, [&] {
+        T total = T();
+        for (size_t i = 0, size = a.size(); i < size; i++) total += a[i];
+        bench::do_not_optimize(total);
+    });
+    report("sum: range-for", n, rounds, [&] {
+        T total = T();
+        for (const T& x : a) total += x;
+        bench::do_not_optimize(total);
+    });
+    report("sum: std::accumulate(begin, end)", n, rounds, [&] {
+        bench::do_not_optimize(std::accumulate(a.begin(), a.end(), T()));
+    });
+
+    report("axpy: at()", n, rounds, [&] {
+        for (size_t i = 0, size = a.size(); i < size; i++) b.at(i) += 3 * a.at(i);
+        bench::do_not_optimize(b.front());
+    });
+    report("axpy: operator[]", n, rounds, [&] {
+        for (size_t i = 0, size = a.size(); i < size; i++) b[i] += 3 * a[i];
+        bench::do_not_optimize(b.front());
+    });
+    report("axpy: data()", n, rounds, [&] {
+        const T* __restrict src = a.data();
+        T* __restrict dst = b.data();
+        for (size_t i = 0, size = a.size(); i < size; i++) dst[i] += 3 * src[i];
+        bench::do_not_optimize(b.front());
+    });
+}
+
+int main() {
+    std::printf("operator[] bounds checks: %s\n", MYSTL_VECTOR_CHECKS ? "on" : "off");
+    suite<int>("int", 1 << 14, 20000);
+    suite<float>("float", 1 << 14, 20000);
+    return 0;
+}
@@ -0,0 +1,252 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include "../utilities/bit_words.hpp"
+
+namespace mystl {
+
+// Rank index of a bitset spanning more than one 512-bit block: the number of
+// ones before each block, built on first use. Bitsets of one block scan at
+// most eight words anyway and get the empty specialization, which costs no
+// space as a base class.
+template <size_t Blocks>
+struct bitset_rank_index {
+    mutable uint64_t blockRanks[Blocks + 1] = {};
+    mutable bool indexValid = false;
+};
+
+template <>
+struct bitset_rank_index<0> {};
+
+// Fixed-size sequence of N bits packed into 64-bit words. Bulk operations
+// (&, |, ^, count) run a word, or an AVX2 register, at a time. Bits past N in
+// the last word are kept zero so counts and comparisons need no masking.
+//
+// Past 512 bits, rank()/select() answer from a block index like
+// dynamic_bitset's (one table load, or a binary search over the blocks, plus
+// at most eight popcounts), dropped on the next modification. Building it
+// mutates internal state, so concurrent const calls of rank()/select() need
+// external synchronization until it exists.
+template <size_t N>
+class bitset : private bitset_rank_index<(N > 512 ? (N + 511) / 512 : 0)> {
+private:
+    static constexpr size_t numWords = N == 0 ? 1 : (N + 63) / 64;
+    static constexpr size_t wordsPerBlock = 8;
+    static constexpr size_t numBlocks = N > 512 ? (N + 511) / 512 : 0;  // as in the base class
+    static constexpr bool indexed = numBlocks > 0;
+
+    uint64_t words[numWords] = {};
+
+    void buildIndex() const {
+        uint64_t ones = 0;
+        for (size_t b = 0; b < numBlocks; b++) {
+            this->blockRanks[b] = ones;
+            size_t first = b * wordsPerBlock;
+            size_t n = numWords - first < wordsPerBlock ? numWords - first : wordsPerBlock;
+            ones += bits::popcount_words(words + first, n);
+        }
+        this->blockRanks[numBlocks] = ones;
+        this->indexValid = true;
+    }
+
+    void ensureIndex() const {
+        if constexpr (indexed)
+            if (!this->indexValid) buildIndex();
+    }
+
+    void invalidateIndex() {
+        if constexpr (indexed) this->indexValid = false;
+    }
+
+    // ones in the words before word, counted from the start of its block
+    size_t onesBefore(size_t word) const {
+        if constexpr (indexed) {
+            size_t block = word / wordsPerBlock;
+            return this->blockRanks[block] +
+                   bits::popcount_words(words + block * wordsPerBlock, word - block * wordsPerBlock);
+        } else {
+            return bits::popcount_words(words, word);
+        }
+    }
+
+    void trim() {
+        if (N % 64) words[numWords - 1] &= (1ULL << (N % 64)) - 1;
+        if (N == 0) words[0] = 0;
+    }
+
+    void checkIndex(size_t pos) const {
+        if (pos >= N) throw std::out_of_range("bitset index out of range");
+    }
+
+public:
+    static constexpr size_t npos = bits::npos;
+
+    bitset() = default;
+
+    // low bits taken from value
+    bitset(uint64_t value) {
+        words[0] = value;
+        trim();
+    }
+
+    static constexpr size_t size() {
+        return N;
+    }
+
+    bool test(size_t pos) const {
+        checkIndex(pos);
+        return (*this)[pos];
+    }
+
+    // unchecked; use test() for a bounds-checked read
+    bool operator[](size_t pos) const {
+        return (words[pos / 64] >> (pos % 64)) & 1;
+    }
+
+    bitset& set() {
+        for (uint64_t& word : words) word = ~0ULL;
+        trim();
+        invalidateIndex();
+        return *this;
+    }
+
+    bitset& set(size_t pos, bool value = true) {
+        checkIndex(pos);
+        uint64_t mask = 1ULL << (pos % 64);
+        if (value) words[pos / 64] |= mask;
+        else words[pos / 64] &= ~mask;
+        invalidateIndex();
+        return *this;
+    }
+
+    bitset& reset() {
+        for (uint64_t& word : words) word = 0;
+        invalidateIndex();
+        return *this;
+    }
+
+    bitset& reset(size_t pos) {
+        return set(pos, false);
+    }
+
+    bitset& flip() {
+        for (uint64_t& word : words) word = ~word;
+        trim();
+        invalidateIndex();
+        return *this;
+    }
+
+    bitset& flip(size_t pos) {
+        checkIndex(pos);
+        words[pos / 64] ^= 1ULL << (pos % 64);
+        invalidateIndex();
+        return *this;
+    }
+
+    size_t count() const {
+        if constexpr (indexed)
+            if (this->indexValid) return this->blockRanks[numBlocks];
+        return bits::popcount_words(words, numWords);
+    }
+
+    bool any() const {
+        for (uint64_t word : words)
+            if (word) return true;
+        return false;
+    }
+
+    bool none() const {
+        return !any();
+    }
+
+    bool all() const {
+        return count() == N;
+    }
+
+    bitset& operator&=(const bitset& other) {
+        bits::and_words(words, other.words, numWords);
+        invalidateIndex();
+        return *this;
+    }
+
+    bitset& operator|=(const bitset& other) {
+        bits::or_words(words, other.words, numWords);
+        invalidateIndex();
+        return *this;
+    }
+
+    bitset& operator^=(const bitset& other) {
+        bits::xor_words(words, other.words, numWords);
+        invalidateIndex();
+        return *this;
+    }
+
+    bitset operator~() const {
+        bitset result = *this;
+        return result.flip();
+    }
+
+    friend bitset operator&(bitset a, const bitset& b) { return a &= b; }
+    friend bitset operator|(bitset a, const bitset& b) { return a |= b; }
+    friend bitset operator^(bitset a, const bitset& b) { return a ^= b; }
+
+    bool operator==(const bitset& other) const {
+        for (size_t i = 0; i < numWords; i++)
+            if (words[i] != other.words[i]) return false;
+        return true;
+    }
+
+    bool operator!=(const bitset& other) const {
+        return !(*this == other);
+    }
+
+    // index of the first set bit, or npos
+    size_t find_first() const {
+        return bits::find_next(words, numWords, 0);
+    }
+
+    // index of the first set bit after pos, or npos
+    size_t find_next(size_t pos) const {
+        return pos + 1 >= N ? npos : bits::find_next(words, numWords, pos + 1);
+    }
+
+    // number of set bits before pos
+    size_t rank(size_t pos) const {
+        if (pos > N) throw std::out_of_range("bitset index out of range");
+        ensureIndex();
+        size_t ones = onesBefore(pos / 64);
+        if (pos % 64) ones += static_cast<size_t>(__builtin_popcountll(words[pos / 64] & ((1ULL << (pos % 64)) - 1)));
+        return ones;
+    }
+
+    // index of the k-th set bit, counting from 0
+    size_t select(size_t k) const {
+        size_t first = 0;
+        if constexpr (indexed) {
+            ensureIndex();
+            if (k >= this->blockRanks[numBlocks]) throw std::out_of_range("bitset select past the last set bit");
+            // last block whose rank is <= k
+            size_t lo = 0, hi = numBlocks - 1;
+            while (lo < hi) {
+                size_t mid = (lo + hi + 1) / 2;
+                if (this->blockRanks[mid] <= k) lo = mid;
+                else hi = mid - 1;
+            }
+            k -= this->blockRanks[lo];
+            first = lo * wordsPerBlock;
+        }
+        for (size_t i = first; i < numWords; i++) {
+            size_t ones = static_cast<size_t>(__builtin_popcountll(words[i]));
+            if (k < ones) return i * 64 + bits::select_in_word(words[i], static_cast<unsigned>(k));
+            k -= ones;
+        }
+        throw std::out_of_range("bitset select past the last set bit");
+    }
+
+    const uint64_t* data() const {
+        return words;
+    }
+};
+
+}
@@ -0,0 +1,208 @@
+#pragma once
+#include <initializer_list>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include "../utilities/capacity.hpp"
+
+namespace mystl {
+
+// Growable ring buffer over a single contiguous allocation.
+// Capacity is always a power of two so wrapping is a mask, not a modulo.
+template <typename T>
+class circular_buffer {
+private:
+    T* data;
+    std::size_t head;
+    std::size_t _size;
+    std::size_t capacity;
+
+    std::size_t slot(std::size_t index) const {
+        return (head + index) & (capacity - 1);
+    }
+
+    // move the live elements into newData, unwrapping them so the front lands
+    // at index 0, and release the old buffer
+    void relocate(T* newData, std::size_t newCapacity) {
+        for (std::size_t i = 0; i < _size; i++) {
+            T& element = data[slot(i)];
+            new (newData + i) T(std::move(element));
+            element.~T();
+        }
+        ::operator delete(data);
+        data = newData;
+        head = 0;
+        capacity = newCapacity;
+    }
+
+    void grow(std::size_t newCapacity) {
+        relocate(static_cast<T*>(::operator new(sizeof(T) * newCapacity)), newCapacity);
+    }
+
+    // full buffer: build the new element in the next buffer before the old
+    // elements move, since args may refer to one of them (q.push(q.front()))
+    template <typename... Args>
+    T& emplaceGrow(bool atFront, Args&&... args) {
+        std::size_t newCapacity = grown_capacity(capacity, 8, max_size(), "circular_buffer exceeds max_size");
+        T* newData = static_cast<T*>(::operator new(sizeof(T) * newCapacity));
+        std::size_t place = atFront ? newCapacity - 1 : _size;
+        try {
+            new (newData + place) T(std::forward<Args>(args)...);
+        } catch (...) {
+            ::operator delete(newData);
+            throw;
+        }
+        relocate(newData, newCapacity);
+        if (atFront) head = place;
+        _size++;
+        return data[place];
+    }
+
+public:
+    circular_buffer() : data(nullptr), head(0), _size(0), capacity(0) {}
+
+    circular_buffer(std::initializer_list<T> initList) : circular_buffer() {
+        reserve(initList.size());
+        for (const T& val : initList)
+            push_back(val);
+    }
+
+    circular_buffer(const circular_buffer& other) : circular_buffer() {
+        reserve(other._size);
+        for (std::size_t i = 0; i < other._size; i++)
+            push_back(other[i]);
+    }
+
+    circular_buffer(circular_buffer&& other) noexcept
+        : data(other.data), head(other.head), _size(other._size), capacity(other.capacity) {
+        other.data = nullptr;
+        other.head = other._size = other.capacity = 0;
+    }
+
+    circular_buffer& operator=(circular_buffer other) {
+        std::swap(data, other.data);
+        std::swap(head, other.head);
+        std::swap(_size, other._size);
+        std::swap(capacity, other.capacity);
+        return *this;
+    }
+
+    ~circular_buffer() {
+        clear();
+        ::operator delete(data);
+    }
+
+    void push_back(const T& val) {
+        emplace_back(val);
+    }
+
+    void push_back(T&& val) {
+        emplace_back(std::move(val));
+    }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (_size == capacity) return emplaceGrow(false, std::forward<Args>(args)...);
+        T* place = data + slot(_size);
+        new (place) T(std::forward<Args>(args)...);
+        _size++;
+        return *place;
+    }
+
+    void push_front(const T& val) {
+        emplace_front(val);
+    }
+
+    void push_front(T&& val) {
+        emplace_front(std::move(val));
+    }
+
+    template <typename... Args>
+    T& emplace_front(Args&&... args) {
+        if (_size == capacity) return emplaceGrow(true, std::forward<Args>(args)...);
+        std::size_t newHead = (head - 1) & (capacity - 1);
+        new (data + newHead) T(std::forward<Args>(args)...);
+        head = newHead;
+        _size++;
+        return data[head];
+    }
+
+    void pop_front() {
+        if (empty()) throw std::runtime_error("circular_buffer Underflow");
+        data[head].~T();
+        head = slot(1);
+        _size--;
+    }
+
+    void pop_back() {
+        if (empty()) throw std::runtime_error("circular_buffer Underflow");
+        data[slot(_size - 1)].~T();
+        _size--;
+    }
+
+    T& front() {
+        if (empty()) throw std::runtime_error("circular_buffer is empty");
+        return data[head];
+    }
+
+    const T& front() const {
+        if (empty()) throw std::runtime_error("circular_buffer is empty");
+        return data[head];
+    }
+
+    T& back() {
+        if (empty()) throw std::runtime_error("circular_buffer is empty");
+        return data[slot(_size - 1)];
+    }
+
+    const T& back() const {
+        if (empty()) throw std::runtime_error("circular_buffer is empty");
+        return data[slot(_size - 1)];
+    }
+
+    T& operator[](std::size_t index) {
+        if (index >= _size) throw std::out_of_range("Index out of bounds");
+        return data[slot(index)];
+    }
+
+    const T& operator[](std::size_t index) const {
+        if (index >= _size) throw std::out_of_range("Index out of bounds");
+        return data[slot(index)];
+    }
+
+    // make room for at least newCapacity elements (rounded up to a power of two)
+    void reserve(std::size_t newCapacity) {
+        if (newCapacity <= capacity) return;
+        check_capacity(newCapacity, max_size(), "circular_buffer reserve exceeds max_size");
+        std::size_t rounded = capacity == 0 ? 8 : capacity;
+        while (rounded < newCapacity)
+            rounded *= 2;
+        grow(rounded);
+    }
+
+    void clear() {
+        for (std::size_t i = 0; i < _size; i++)
+            data[slot(i)].~T();
+        head = 0;
+        _size = 0;
+    }
+
+    bool empty() const {
+        return _size == 0;
+    }
+
+    std::size_t size() const {
+        return _size;
+    }
+
+    std::size_t get_capacity() const {
+        return capacity;
+    }
+
+    // largest size the buffer can reach; capacities stay powers of two
+    static constexpr std::size_t max_size() {
+        return floor_pow2(max_elements<T>());
+    }
+};
+
+}
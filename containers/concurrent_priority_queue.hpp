@@ -0,0 +1,147 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <utility>
+#include "priority_queue.hpp"
+#include "../utilities/cache_line.hpp"
+
+namespace mystl {
+
+// Relaxed concurrent priority queue (MultiQueue).
+//
+// Elements are spread over queuesPerThread * threads independent
+// mystl::priority_queue heaps, each behind its own spinlock. push locks one
+// random heap; try_pop samples popChoices random heaps and pops the best top
+// among them. Threads rarely meet on the same lock, so throughput scales with
+// the thread count, at the price of returning an element that is close to, but
+// not always, the global top. More heaps per thread means less contention and
+// more relaxation; more pop choices means better quality and more locking.
+template <typename T, typename Comparator = std::less<T>>
+class concurrent_priority_queue {
+private:
+    struct alignas(cache_line_size) SubQueue {
+        std::atomic<bool> locked{false};
+        std::atomic<std::size_t> count{0};
+        mystl::priority_queue<T, Comparator, 4> heap;
+
+        bool try_lock() {
+            return !locked.load(std::memory_order_relaxed) &&
+                   !locked.exchange(true, std::memory_order_acquire);
+        }
+
+        void unlock() {
+            locked.store(false, std::memory_order_release);
+        }
+    };
+
+    std::unique_ptr<SubQueue[]> queues;
+    size_t numQueues;
+    size_t popChoices;
+    Comparator comp;
+
+    static size_t randomIndex(size_t n) {
+        thread_local size_t seed = std::hash<std::thread::id>()(std::this_thread::get_id()) | 1;
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        return seed % n;
+    }
+
+    SubQueue& lockRandom() {
+        for (;;) {
+            SubQueue& q = queues[randomIndex(numQueues)];
+            if (q.try_lock()) return q;
+        }
+    }
+
+    void popLocked(SubQueue& q, T& out) {
+        q.heap.try_pop(out);
+        q.count.store(q.heap.size(), std::memory_order_relaxed);
+        q.unlock();
+    }
+
+    // sample popChoices heaps, keep the best locked candidate; nullptr if all were empty
+    SubQueue* lockBestOfSample() {
+        SubQueue* best = nullptr;
+        for (size_t i = 0; i < popChoices; i++) {
+            SubQueue& q = queues[randomIndex(numQueues)];
+            if (&q == best || q.count.load(std::memory_order_relaxed) == 0 || !q.try_lock()) continue;
+            if (q.heap.empty()) {
+                q.unlock();
+            } else if (!best || comp(best->heap.top(), q.heap.top())) {
+                if (best) best->unlock();
+                best = &q;
+            } else {
+                q.unlock();
+            }
+        }
+        return best;
+    }
+
+public:
+    // threads: expected number of concurrent users, sizes the number of heaps
+    explicit concurrent_priority_queue(size_t threads = std::thread::hardware_concurrency(),
+                                       size_t queuesPerThread = 2, size_t popChoices = 2)
+        : numQueues((threads ? threads : 1) * (queuesPerThread ? queuesPerThread : 1)),
+          popChoices(popChoices ? popChoices : 1) {
+        queues.reset(new SubQueue[numQueues]);
+    }
+
+    concurrent_priority_queue(const concurrent_priority_queue&) = delete;
+    concurrent_priority_queue& operator=(const concurrent_priority_queue&) = delete;
+
+    void push(const T& element) {
+        SubQueue& q = lockRandom();
+        q.heap.push(element);
+        q.count.store(q.heap.size(), std::memory_order_relaxed);
+        q.unlock();
+    }
+
+    void push(T&& element) {
+        SubQueue& q = lockRandom();
+        q.heap.push(std::move(element));
+        q.count.store(q.heap.size(), std::memory_order_relaxed);
+        q.unlock();
+    }
+
+    // Pop a near-top element into out. Returns false only when a full sweep over
+    // every heap found them all empty.
+    bool try_pop(T& out) {
+        for (int attempt = 0; attempt < 4; attempt++) {
+            if (SubQueue* q = lockBestOfSample()) {
+                popLocked(*q, out);
+                return true;
+            }
+        }
+
+        for (size_t i = 0; i < numQueues; i++) {
+            SubQueue& q = queues[i];
+            while (q.count.load(std::memory_order_relaxed) > 0) {
+                if (!q.try_lock()) continue;
+                if (!q.heap.empty()) {
+                    popLocked(q, out);
+                    return true;
+                }
+                q.unlock();
+            }
+        }
+        return false;
+    }
+
+    // snapshot only while other threads are active
+    std::size_t size() const {
+        std::size_t total = 0;
+        for (size_t i = 0; i < numQueues; i++)
+            total += queues[i].count.load(std::memory_order_relaxed);
+        return total;
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+};
+
+}
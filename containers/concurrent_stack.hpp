@@ -0,0 +1,141 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <utility>
+#include "../utilities/cache_line.hpp"
+#include "../utilities/hazard_pointer.hpp"
+
+namespace mystl {
+
+// Lock-free LIFO stack (Treiber stack) safe for any number of threads.
+//
+// push/try_pop CAS the top pointer; nodes are reclaimed through hazard pointers,
+// which also rules out ABA on the top pointer. Under contention a failed CAS
+// falls back to an elimination array where a concurrent push and pop can hand an
+// element over directly without touching the top pointer at all.
+template <typename T>
+class concurrent_stack {
+private:
+    struct Node {
+        T data;
+        Node* next;
+
+        template <typename... Args>
+        Node(Args&&... args) : data(std::forward<Args>(args)...), next(nullptr) {}
+    };
+
+    struct alignas(cache_line_size) EliminationSlot {
+        std::atomic<Node*> offer{nullptr};
+    };
+
+    alignas(cache_line_size) std::atomic<Node*> head{nullptr};
+    std::unique_ptr<EliminationSlot[]> elimination;
+    size_t eliminationSize;
+    static constexpr int kEliminationSpins = 64;
+
+    size_t eliminationIndex() const {
+        thread_local size_t seed = std::hash<std::thread::id>()(std::this_thread::get_id()) | 1;
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        return seed % eliminationSize;
+    }
+
+    // offer node to a concurrent pop; true if one took it
+    bool eliminatePush(Node* node) {
+        if (!eliminationSize) return false;
+        std::atomic<Node*>& offer = elimination[eliminationIndex()].offer;
+        Node* expected = nullptr;
+        if (!offer.compare_exchange_strong(expected, node)) return false;
+
+        for (int i = 0; i < kEliminationSpins; i++) {
+            if (offer.load(std::memory_order_acquire) != node) return true;
+        }
+        // withdraw the offer; failing means a pop took it in the meantime
+        expected = node;
+        return !offer.compare_exchange_strong(expected, nullptr);
+    }
+
+    // take a node offered by a concurrent push, or nullptr
+    Node* eliminatePop() {
+        if (!eliminationSize) return nullptr;
+        std::atomic<Node*>& offer = elimination[eliminationIndex()].offer;
+        for (int i = 0; i < kEliminationSpins; i++) {
+            Node* node = offer.load(std::memory_order_acquire);
+            if (node && offer.compare_exchange_strong(node, nullptr)) return node;
+        }
+        return nullptr;
+    }
+
+    void pushNode(Node* node) {
+        node->next = head.load(std::memory_order_relaxed);
+        while (!head.compare_exchange_weak(node->next, node, std::memory_order_release,
+                                           std::memory_order_relaxed)) {
+            if (eliminatePush(node)) return;
+            node->next = head.load(std::memory_order_relaxed);
+        }
+    }
+
+public:
+    // eliminationSlots = 0 disables the elimination-backoff array
+    explicit concurrent_stack(size_t eliminationSlots = 8)
+        : elimination(eliminationSlots ? new EliminationSlot[eliminationSlots] : nullptr),
+          eliminationSize(eliminationSlots) {}
+
+    concurrent_stack(const concurrent_stack&) = delete;
+    concurrent_stack& operator=(const concurrent_stack&) = delete;
+
+    // must not race with other operations
+    ~concurrent_stack() {
+        Node* node = head.load(std::memory_order_relaxed);
+        while (node) {
+            Node* next = node->next;
+            delete node;
+            node = next;
+        }
+    }
+
+    void push(const T& element) {
+        pushNode(new Node(element));
+    }
+
+    void push(T&& element) {
+        pushNode(new Node(std::move(element)));
+    }
+
+    template <typename... Args>
+    void emplace(Args&&... args) {
+        pushNode(new Node(std::forward<Args>(args)...));
+    }
+
+    // move the top element into out; false if the stack was empty
+    bool try_pop(T& out) {
+        hazard_pointer hp;
+        for (;;) {
+            Node* old = hp.protect(head);
+            if (!old) return false;
+            if (head.compare_exchange_weak(old, old->next, std::memory_order_acquire,
+                                           std::memory_order_relaxed)) {
+                hp.reset();
+                out = std::move(old->data);
+                retire(old);
+                return true;
+            }
+            if (Node* node = eliminatePop()) {
+                // an eliminated node was never visible on the stack, so it is ours alone
+                out = std::move(node->data);
+                delete node;
+                return true;
+            }
+        }
+    }
+
+    // snapshot only; other threads may change it immediately
+    bool empty() const {
+        return head.load(std::memory_order_acquire) == nullptr;
+    }
+};
+
+}
@@ -0,0 +1,188 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "../utilities/hash_mix.hpp"
+
+namespace mystl {
+
+// Cuckoo filter: approximate membership like a Bloom filter, but keys can also
+// be erased.
+//
+// Each key stores a 16-bit fingerprint in one of two candidate buckets. A bucket
+// holds four fingerprints packed into one 64-bit word, so a lookup is two word
+// loads and a SIMD-within-a-register compare of all four lanes at once. The
+// false positive rate is about 8 / 65536 (~0.01%). erase() must only be called
+// for keys that were inserted, or it may remove another key's fingerprint.
+template <typename K, typename Hash = std::hash<K>>
+class cuckoo_filter {
+private:
+    static constexpr int slotsPerBucket = 4;
+    static constexpr int maxKicks = 500;
+    static constexpr uint64_t lowLanes = 0x0001000100010001ULL;
+    static constexpr uint64_t highLanes = 0x8000800080008000ULL;
+
+    std::vector<uint64_t> buckets;
+    size_t mask;
+    size_t count = 0;
+    Hash hashFunc;
+    uint64_t rng = 0x9e3779b97f4a7c15ULL;
+
+    // a fingerprint evicted by a failed insert; the filter is full while set
+    bool hasVictim = false;
+    uint16_t victimFingerprint = 0;
+    size_t victimIndex = 0;
+
+    static size_t roundUpPow2(size_t n) {
+        size_t cap = 1;
+        while (cap < n) cap <<= 1;
+        return cap;
+    }
+
+    // bit 15 of each lane set where the lane of word is zero
+    static uint64_t zeroLanes(uint64_t word) {
+        return (word - lowLanes) & ~word & highLanes;
+    }
+
+    static uint64_t matchingLanes(uint64_t word, uint16_t fingerprint) {
+        return zeroLanes(word ^ (lowLanes * fingerprint));
+    }
+
+    static int firstLane(uint64_t lanes) {
+        return __builtin_ctzll(lanes) / 16;
+    }
+
+    static uint16_t laneValue(uint64_t word, int lane) {
+        return static_cast<uint16_t>(word >> (16 * lane));
+    }
+
+    static void setLane(uint64_t& word, int lane, uint16_t fingerprint) {
+        word = (word & ~(0xFFFFULL << (16 * lane))) | (static_cast<uint64_t>(fingerprint) << (16 * lane));
+    }
+
+    // the other candidate bucket; applying it twice gives back the first
+    size_t altIndex(size_t index, uint16_t fingerprint) const {
+        return (index ^ static_cast<size_t>(mix64(fingerprint))) & mask;
+    }
+
+    // fingerprint 0 marks an empty lane
+    void locate(const K& key, size_t& index, uint16_t& fingerprint) const {
+        uint64_t h = mix64(static_cast<uint64_t>(hashFunc(key)));
+        fingerprint = static_cast<uint16_t>(h >> 48);
+        if (fingerprint == 0) fingerprint = 1;
+        index = static_cast<size_t>(h) & mask;
+    }
+
+    bool tryPlace(size_t index, uint16_t fingerprint) {
+        uint64_t empty = zeroLanes(buckets[index]);
+        if (!empty) return false;
+        setLane(buckets[index], firstLane(empty), fingerprint);
+        return true;
+    }
+
+    // cuckoo displacement; on failure the last evicted fingerprint becomes the victim
+    bool place(size_t index, uint16_t fingerprint) {
+        if (tryPlace(index, fingerprint)) return true;
+        index = altIndex(index, fingerprint);
+        if (tryPlace(index, fingerprint)) return true;
+
+        for (int kick = 0; kick < maxKicks; kick++) {
+            rng ^= rng << 13;
+            rng ^= rng >> 7;
+            rng ^= rng << 17;
+            int lane = static_cast<int>(rng & (slotsPerBucket - 1));
+            uint16_t evicted = laneValue(buckets[index], lane);
+            setLane(buckets[index], lane, fingerprint);
+            fingerprint = evicted;
+            index = altIndex(index, fingerprint);
+            if (tryPlace(index, fingerprint)) return true;
+        }
+
+        hasVictim = true;
+        victimFingerprint = fingerprint;
+        victimIndex = index;
+        return false;
+    }
+
+public:
+    static constexpr bool supports_erase = true;
+
+    // sized so expectedItems keys fill about 90% of the slots
+    explicit cuckoo_filter(size_t expectedItems = 1024)
+        : buckets(roundUpPow2((expectedItems * 10 / 9 + slotsPerBucket - 1) / slotsPerBucket + 1), 0) {
+        mask = buckets.size() - 1;
+    }
+
+    // false when the filter is full. The key is still remembered (possibly by
+    // evicting another fingerprint into the victim slot), but no further keys
+    // fit; rebuild with a larger capacity.
+    bool insert(const K& key) {
+        if (hasVictim) return false;
+        size_t index;
+        uint16_t fingerprint;
+        locate(key, index, fingerprint);
+        count++;
+        return place(index, fingerprint);
+    }
+
+    // false means key is definitely not present
+    bool might_contain(const K& key) const {
+        size_t index;
+        uint16_t fingerprint;
+        locate(key, index, fingerprint);
+        size_t other = altIndex(index, fingerprint);
+        if (matchingLanes(buckets[index], fingerprint) | matchingLanes(buckets[other], fingerprint))
+            return true;
+        return hasVictim && victimFingerprint == fingerprint &&
+               (victimIndex == index || victimIndex == other);
+    }
+
+    bool erase(const K& key) {
+        size_t index;
+        uint16_t fingerprint;
+        locate(key, index, fingerprint);
+        size_t other = altIndex(index, fingerprint);
+
+        bool removed = false;
+        for (size_t candidate : {index, other}) {
+            uint64_t lanes = matchingLanes(buckets[candidate], fingerprint);
+            if (lanes) {
+                setLane(buckets[candidate], firstLane(lanes), 0);
+                removed = true;
+                break;
+            }
+        }
+        if (!removed && hasVictim && victimFingerprint == fingerprint &&
+            (victimIndex == index || victimIndex == other)) {
+            hasVictim = false;
+            removed = true;
+        } else if (removed && hasVictim) {
+            // there is room again: give the victim another try
+            hasVictim = false;
+            place(victimIndex, victimFingerprint);
+        }
+        if (removed) count--;
+        return removed;
+    }
+
+    void clear() {
+        for (uint64_t& bucket : buckets) bucket = 0;
+        hasVictim = false;
+        count = 0;
+    }
+
+    size_t size() const {
+        return count;
+    }
+
+    bool full() const {
+        return hasVictim;
+    }
+
+    size_t size_in_bytes() const {
+        return buckets.size() * sizeof(uint64_t);
+    }
+};
+
+}
@@ -1,4 +1,10 @@
-#include <initializer_list> 
+#pragma once
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+#include "../utilities/capacity.hpp"
+#include "../utilities/serialization.hpp"
+
 namespace mystl {
 
 template <typename T>
@@ -8,7 +14,7 @@ public:
     DNode* prev;
     DNode* next;
 
-    DNode(T val) : data(val), prev(nullptr), next(nullptr) {}
+    DNode(T val) : data(std::move(val)), prev(nullptr), next(nullptr) {}
 };
     
 template <typename T>
@@ -16,7 +22,9 @@ class deque {
 private:
     DNode<T>* head;
     DNode<T>* tail;
-    int _size;
+    std::size_t _size;
+
+    friend struct serial::codec<deque>;
     
     public:
     deque() : head(nullptr), tail(nullptr), _size(0) {}
@@ -28,6 +36,12 @@ private:
         }
     }
     
+    // nodes are owned, so a deque moves but is not copied
+    deque(deque&& other) noexcept : head(other.head), tail(other.tail), _size(other._size) {
+        other.head = other.tail = nullptr;
+        other._size = 0;
+    }
+
     ~deque() {
         clear();
     }
@@ -36,12 +50,45 @@ private:
         return _size == 0;
     }
     
-    int size() const {
+    std::size_t size() const {
         return _size;
     }
+
+    // one node per element, so the count is bounded by the nodes that fit in memory
+    static constexpr std::size_t max_size() {
+        return max_elements<DNode<T>>();
+    }
     
     void push_front(const T& val) {
-        DNode<T>* newNode = new DNode<T>(val);
+        linkFront(new DNode<T>(val));
+    }
+
+    void push_front(T&& val) {
+        linkFront(new DNode<T>(std::move(val)));
+    }
+
+    template <typename... Args>
+    T& emplace_front(Args&&... args) {
+        linkFront(new DNode<T>(T(std::forward<Args>(args)...)));
+        return head->data;
+    }
+
+    void push_back(const T& val) {
+        linkBack(new DNode<T>(val));
+    }
+
+    void push_back(T&& val) {
+        linkBack(new DNode<T>(std::move(val)));
+    }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        linkBack(new DNode<T>(T(std::forward<Args>(args)...)));
+        return tail->data;
+    }
+
+private:
+    void linkFront(DNode<T>* newNode) {
         if (!head) {
             head = tail = newNode;
         } else {
@@ -52,8 +99,7 @@ private:
         _size++;
     }
     
-    void push_back(const T& val) {
-        DNode<T>* newNode = new DNode<T>(val);
+    void linkBack(DNode<T>* newNode) {
         if (!tail) {
             head = tail = newNode;
         } else {
@@ -63,7 +109,8 @@ private:
         }
         _size++;
     }
-    
+
+public:
     void pop_front() {
         if (empty()) throw std::runtime_error("Deque Underflow");
         DNode<T>* temp = head;
@@ -93,14 +140,24 @@ private:
         if (empty()) throw std::runtime_error("Deque is empty");
         return tail->data;
     }
+
+    const T& front() const {
+        if (empty()) throw std::runtime_error("Deque is empty");
+        return head->data;
+    }
+
+    const T& back() const {
+        if (empty()) throw std::runtime_error("Deque is empty");
+        return tail->data;
+    }
     
-    const T& operator[](int index) const {
-        if (index < 0 || index >= _size) {
+    const T& operator[](std::size_t index) const {
+        if (index >= _size) {
             throw std::out_of_range("Index out of bounds");
         }
     
         DNode<T>* temp = head;
-        for (int i = 0; i < index; ++i) {
+        for (std::size_t i = 0; i < index; ++i) {
             temp = temp->next;
         }
     
@@ -117,6 +174,32 @@ private:
         _size = 0;
     }
 };
+
+namespace serial {
+
+template <typename T>
+struct codec<deque<T>> {
+    static constexpr uint8_t tag = tag_deque;
+
+    template <typename Sink>
+    static void write(Sink& sink, const deque<T>& d) {
+        write_count(sink, d._size);
+        for (const DNode<T>* node = d.head; node; node = node->next) {
+            write_value(sink, node->data);
+        }
+    }
+
+    template <typename Source>
+    static deque<T> read(Source& source) {
+        std::size_t n = read_count(source, deque<T>::max_size());
+        deque<T> d;
+        for (std::size_t i = 0; i < n; i++) {
+            d.push_back(read_value<T>(source));
+        }
+        return d;
+    }
+};
+
+}
     
-} 
-    
\ No newline at end of file
+}
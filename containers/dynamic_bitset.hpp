@@ -0,0 +1,289 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include "../utilities/bit_words.hpp"
+
+namespace mystl {
+
+// Resizable bitset: one bit per flag instead of a byte (or a heap node in an
+// unordered_set<int>). Bulk operations work a word or an AVX2 register at a
+// time, and rank()/select() answer from a small index that is built on first
+// use and dropped on the next modification:
+//   - every 512 bits, the number of ones before that block (1/8 of the bits'
+//     size), so rank is one table load plus at most eight popcounts;
+//   - every 1024th one, the block holding it, so select only binary searches
+//     the few blocks between two samples.
+// Building the index mutates internal state, so concurrent const calls of
+// rank()/select() need external synchronization until it exists.
+class dynamic_bitset {
+private:
+    static constexpr size_t wordsPerBlock = 8;
+    static constexpr size_t bitsPerBlock = 64 * wordsPerBlock;
+    static constexpr size_t selectSampleRate = 1024;
+
+    std::vector<uint64_t> words;
+    size_t numBits = 0;
+
+    mutable bool indexValid = false;
+    mutable std::vector<uint64_t> blockRanks;
+    mutable std::vector<uint32_t> selectSamples;
+
+    static size_t wordsFor(size_t n) {
+        return (n + 63) / 64;
+    }
+
+    void trim() {
+        if (numBits % 64) words.back() &= (1ULL << (numBits % 64)) - 1;
+    }
+
+    void checkIndex(size_t pos) const {
+        if (pos >= numBits) throw std::out_of_range("dynamic_bitset index out of range");
+    }
+
+    void checkSameSize(const dynamic_bitset& other) const {
+        if (numBits != other.numBits) throw std::invalid_argument("dynamic_bitset sizes differ");
+    }
+
+    void buildIndex() const {
+        size_t numBlocks = (words.size() + wordsPerBlock - 1) / wordsPerBlock;
+        blockRanks.assign(numBlocks + 1, 0);
+        selectSamples.clear();
+
+        uint64_t ones = 0;
+        for (size_t b = 0; b < numBlocks; b++) {
+            blockRanks[b] = ones;
+            size_t first = b * wordsPerBlock;
+            size_t n = std::min(wordsPerBlock, words.size() - first);
+            uint64_t blockOnes = bits::popcount_words(words.data() + first, n);
+            // samples for every multiple of selectSampleRate reached inside this block
+            while (selectSamples.size() * selectSampleRate < ones + blockOnes)
+                selectSamples.push_back(static_cast<uint32_t>(b));
+            ones += blockOnes;
+        }
+        blockRanks[numBlocks] = ones;
+        indexValid = true;
+    }
+
+    void ensureIndex() const {
+        if (!indexValid) buildIndex();
+    }
+
+public:
+    static constexpr size_t npos = bits::npos;
+
+    dynamic_bitset() = default;
+
+    explicit dynamic_bitset(size_t n, bool value = false)
+        : words(wordsFor(n), value ? ~0ULL : 0), numBits(n) {
+        trim();
+    }
+
+    size_t size() const {
+        return numBits;
+    }
+
+    bool empty() const {
+        return numBits == 0;
+    }
+
+    // bytes used by the bits themselves, excluding the rank/select index
+    size_t size_in_bytes() const {
+        return words.size() * sizeof(uint64_t);
+    }
+
+    void resize(size_t n, bool value = false) {
+        size_t old = numBits;
+        words.resize(wordsFor(n), value ? ~0ULL : 0);
+        numBits = n;
+        if (value && n > old && old % 64)
+            words[old / 64] |= ~0ULL << (old % 64);
+        trim();
+        indexValid = false;
+    }
+
+    void push_back(bool value) {
+        if (numBits % 64 == 0) words.push_back(0);
+        numBits++;
+        if (value) words.back() |= 1ULL << ((numBits - 1) % 64);
+        indexValid = false;
+    }
+
+    void clear() {
+        words.clear();
+        numBits = 0;
+        indexValid = false;
+    }
+
+    bool test(size_t pos) const {
+        checkIndex(pos);
+        return (*this)[pos];
+    }
+
+    // unchecked; use test() for a bounds-checked read
+    bool operator[](size_t pos) const {
+        return (words[pos / 64] >> (pos % 64)) & 1;
+    }
+
+    dynamic_bitset& set() {
+        for (uint64_t& word : words) word = ~0ULL;
+        trim();
+        indexValid = false;
+        return *this;
+    }
+
+    dynamic_bitset& set(size_t pos, bool value = true) {
+        checkIndex(pos);
+        uint64_t mask = 1ULL << (pos % 64);
+        if (value) words[pos / 64] |= mask;
+        else words[pos / 64] &= ~mask;
+        indexValid = false;
+        return *this;
+    }
+
+    dynamic_bitset& reset() {
+        for (uint64_t& word : words) word = 0;
+        indexValid = false;
+        return *this;
+    }
+
+    dynamic_bitset& reset(size_t pos) {
+        return set(pos, false);
+    }
+
+    dynamic_bitset& flip() {
+        for (uint64_t& word : words) word = ~word;
+        trim();
+        indexValid = false;
+        return *this;
+    }
+
+    dynamic_bitset& flip(size_t pos) {
+        checkIndex(pos);
+        words[pos / 64] ^= 1ULL << (pos % 64);
+        indexValid = false;
+        return *this;
+    }
+
+    size_t count() const {
+        if (indexValid) return blockRanks[blockRanks.size() - 1];
+        return bits::popcount_words(words.data(), words.size());
+    }
+
+    bool any() const {
+        for (uint64_t word : words)
+            if (word) return true;
+        return false;
+    }
+
+    bool none() const {
+        return !any();
+    }
+
+    bool all() const {
+        return count() == numBits;
+    }
+
+    dynamic_bitset& operator&=(const dynamic_bitset& other) {
+        checkSameSize(other);
+        bits::and_words(words.data(), other.words.data(), words.size());
+        indexValid = false;
+        return *this;
+    }
+
+    dynamic_bitset& operator|=(const dynamic_bitset& other) {
+        checkSameSize(other);
+        bits::or_words(words.data(), other.words.data(), words.size());
+        indexValid = false;
+        return *this;
+    }
+
+    dynamic_bitset& operator^=(const dynamic_bitset& other) {
+        checkSameSize(other);
+        bits::xor_words(words.data(), other.words.data(), words.size());
+        indexValid = false;
+        return *this;
+    }
+
+    // clear every bit that is set in other
+    dynamic_bitset& operator-=(const dynamic_bitset& other) {
+        checkSameSize(other);
+        bits::andnot_words(words.data(), other.words.data(), words.size());
+        indexValid = false;
+        return *this;
+    }
+
+    dynamic_bitset operator~() const {
+        dynamic_bitset result = *this;
+        return result.flip();
+    }
+
+    friend dynamic_bitset operator&(dynamic_bitset a, const dynamic_bitset& b) { return a &= b; }
+    friend dynamic_bitset operator|(dynamic_bitset a, const dynamic_bitset& b) { return a |= b; }
+    friend dynamic_bitset operator^(dynamic_bitset a, const dynamic_bitset& b) { return a ^= b; }
+    friend dynamic_bitset operator-(dynamic_bitset a, const dynamic_bitset& b) { return a -= b; }
+
+    bool operator==(const dynamic_bitset& other) const {
+        return numBits == other.numBits && words == other.words;
+    }
+
+    bool operator!=(const dynamic_bitset& other) const {
+        return !(*this == other);
+    }
+
+    // index of the first set bit, or npos
+    size_t find_first() const {
+        return bits::find_next(words.data(), words.size(), 0);
+    }
+
+    // index of the first set bit after pos, or npos
+    size_t find_next(size_t pos) const {
+        return pos + 1 >= numBits ? npos : bits::find_next(words.data(), words.size(), pos + 1);
+    }
+
+    // number of set bits before pos
+    size_t rank(size_t pos) const {
+        if (pos > numBits) throw std::out_of_range("dynamic_bitset index out of range");
+        ensureIndex();
+        size_t word = pos / 64;
+        size_t block = word / wordsPerBlock;
+        size_t ones = blockRanks[block] + bits::popcount_words(words.data() + block * wordsPerBlock, word - block * wordsPerBlock);
+        if (pos % 64) ones += static_cast<size_t>(__builtin_popcountll(words[word] & ((1ULL << (pos % 64)) - 1)));
+        return ones;
+    }
+
+    // index of the k-th set bit, counting from 0
+    size_t select(size_t k) const {
+        ensureIndex();
+        if (k >= blockRanks.back()) throw std::out_of_range("dynamic_bitset select past the last set bit");
+
+        // last block whose rank is <= k, between the two surrounding samples
+        size_t sample = k / selectSampleRate;
+        size_t lo = selectSamples[sample];
+        size_t hi = sample + 1 < selectSamples.size() ? selectSamples[sample + 1] : blockRanks.size() - 2;
+        while (lo < hi) {
+            size_t mid = (lo + hi + 1) / 2;
+            if (blockRanks[mid] <= k) lo = mid;
+            else hi = mid - 1;
+        }
+
+        k -= blockRanks[lo];
+        for (size_t w = lo * wordsPerBlock;; w++) {
+            size_t ones = static_cast<size_t>(__builtin_popcountll(words[w]));
+            if (k < ones) return w * 64 + bits::select_in_word(words[w], static_cast<unsigned>(k));
+            k -= ones;
+        }
+    }
+
+    const uint64_t* data() const {
+        return words.data();
+    }
+
+    size_t num_words() const {
+        return words.size();
+    }
+};
+
+}
@@ -0,0 +1,235 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include "bloom_filter.hpp"
+#include "cuckoo_filter.hpp"
+#include "map.hpp"
+#include "unordered_map.hpp"
+#include "unordered_set.hpp"
+
+namespace mystl {
+
+// Opt-in wrappers that put an approximate membership filter in front of a
+// container, so lookups of absent keys usually stop after one filter probe
+// instead of walking a bucket chain or a tree path. Hits pay for the probe as
+// well, so they only pay off when a good share of lookups miss.
+//
+// Filter is bloom_filter (the default) or cuckoo_filter. A Bloom filter cannot
+// forget erased keys; it is rebuilt from the container once erased keys
+// outnumber live ones. Both are rebuilt at twice the size when they fill up.
+
+template <typename K, typename Filter>
+class FilterFront {
+private:
+    Filter filter;
+    size_t capacity;
+    size_t stale = 0;
+
+    // forEach(callback) calls callback on every live key of the container
+    template <typename ForEach>
+    void rebuild(size_t newCapacity, ForEach&& forEach) {
+        for (;;) {
+            capacity = newCapacity;
+            filter = Filter(capacity);
+            stale = 0;
+            bool fits = true;
+            forEach([&](const K& key) {
+                if (fits && !filter.insert(key)) fits = false;
+            });
+            if (fits) return;
+            newCapacity *= 2;
+        }
+    }
+
+public:
+    explicit FilterFront(size_t capacity = 1024) : filter(capacity), capacity(capacity) {}
+
+    bool mightContain(const K& key) const {
+        return filter.might_contain(key);
+    }
+
+    // key was just added to a container now holding liveCount keys
+    template <typename ForEach>
+    void added(const K& key, size_t liveCount, ForEach&& forEach) {
+        if (liveCount + stale > capacity) {
+            rebuild(2 * liveCount, forEach);
+            return;
+        }
+        if (!filter.insert(key))
+            rebuild(2 * capacity, forEach);
+    }
+
+    // key was just removed from a container now holding liveCount keys
+    template <typename ForEach>
+    void removed(const K& key, size_t liveCount, ForEach&& forEach) {
+        if constexpr (Filter::supports_erase) {
+            filter.erase(key);
+        } else if (++stale > liveCount && stale > 64) {
+            rebuild(capacity, forEach);
+        }
+    }
+};
+
+template <typename K, typename Filter = bloom_filter<K>, typename HashFunc = std::hash<K>>
+class filtered_unordered_set {
+private:
+    using Set = unordered_set<K, HashFunc>;
+
+    Set keys;
+    FilterFront<K, Filter> front;
+
+    auto forEachKey() {
+        return [this](auto&& callback) {
+            for (auto it = keys.begin(); it != keys.end(); ++it) callback(*it);
+        };
+    }
+
+public:
+    using iterator = typename Set::iterator;
+
+    explicit filtered_unordered_set(size_t expectedItems = 1024) : front(expectedItems) {}
+
+    filtered_unordered_set(const filtered_unordered_set&) = delete;
+    filtered_unordered_set& operator=(const filtered_unordered_set&) = delete;
+
+    void insert(const K& key) {
+        if (contains(key)) return;
+        keys.insert(key);
+        front.added(key, keys.size(), forEachKey());
+    }
+
+    void erase(const K& key) {
+        if (!contains(key)) return;
+        keys.erase(key);
+        front.removed(key, keys.size(), forEachKey());
+    }
+
+    iterator find(const K& key) {
+        if (!front.mightContain(key)) return keys.end();
+        return keys.find(key);
+    }
+
+    bool contains(const K& key) {
+        return find(key) != keys.end();
+    }
+
+    iterator begin() { return keys.begin(); }
+    iterator end() { return keys.end(); }
+
+    std::size_t size() const {
+        return keys.size();
+    }
+
+    bool empty() const {
+        return keys.empty();
+    }
+};
+
+template <typename K, typename V, typename Filter = bloom_filter<K>, typename HashFunc = std::hash<K>>
+class filtered_unordered_map {
+private:
+    using Map = unordered_map<K, V, HashFunc>;
+
+    Map entries;
+    FilterFront<K, Filter> front;
+
+    auto forEachKey() {
+        return [this](auto&& callback) {
+            for (auto it = entries.begin(); it != entries.end(); ++it) callback((*it).first);
+        };
+    }
+
+public:
+    explicit filtered_unordered_map(size_t expectedItems = 1024) : front(expectedItems) {}
+
+    filtered_unordered_map(const filtered_unordered_map&) = delete;
+    filtered_unordered_map& operator=(const filtered_unordered_map&) = delete;
+
+    void insert(const K& key, const V& value) {
+        std::size_t before = entries.size();
+        entries.insert(key, value);
+        if (entries.size() != before)
+            front.added(key, entries.size(), forEachKey());
+    }
+
+    V remove(const K& key) {
+        if (!contains(key)) return V();
+        V value = entries.remove(key);
+        front.removed(key, entries.size(), forEachKey());
+        return value;
+    }
+
+    // value for key, or V() if absent
+    V getValue(const K& key) const {
+        if (!front.mightContain(key)) return V();
+        return entries.getValue(key);
+    }
+
+    bool contains(const K& key) const {
+        return front.mightContain(key) && entries.contains(key);
+    }
+
+    std::size_t size() const {
+        return entries.size();
+    }
+};
+
+template <typename K, typename V, typename Filter = bloom_filter<K>, typename Comp = std::less<K>>
+class filtered_map {
+private:
+    using Map = map<K, V, Comp>;
+
+    Map entries;
+    FilterFront<K, Filter> front;
+    std::size_t count = 0;
+
+    auto forEachKey() {
+        return [this](auto&& callback) {
+            for (auto it = entries.begin(); it != entries.end(); ++it) callback((*it).first);
+        };
+    }
+
+public:
+    using iterator = typename Map::iterator;
+
+    explicit filtered_map(size_t expectedItems = 1024) : front(expectedItems) {}
+
+    filtered_map(const filtered_map&) = delete;
+    filtered_map& operator=(const filtered_map&) = delete;
+
+    void insert(const K& key, const V& value) {
+        bool fresh = !contains(key);
+        entries.insert(key, value);
+        if (fresh) front.added(key, ++count, forEachKey());
+    }
+
+    void erase(const K& key) {
+        if (!contains(key)) return;
+        entries.erase(key);
+        front.removed(key, --count, forEachKey());
+    }
+
+    // value for key, or V() if absent
+    V getValue(const K& key) const {
+        if (!front.mightContain(key)) return V();
+        return entries.getValue(key);
+    }
+
+    bool contains(const K& key) const {
+        return front.mightContain(key) && entries.contains(key);
+    }
+
+    iterator begin() const { return entries.begin(); }
+    iterator end() const { return entries.end(); }
+
+    std::size_t size() const {
+        return count;
+    }
+
+    bool empty() const {
+        return count == 0;
+    }
+};
+
+}
@@ -0,0 +1,230 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "priority_queue.hpp"
+
+namespace mystl {
+
+// Addressable d-ary heap: push() returns a handle that stays valid until the
+// element is popped or erased, and update()/erase() locate the element through
+// it in O(1) before re-sifting in O(log n). Same ordering and arity conventions
+// as mystl::priority_queue (max-heap with std::less, min-heap with std::greater),
+// and the same sifting code (dary_heap in priority_queue.hpp), with a hook that
+// keeps each handle's heap index current.
+//
+// A handle is a slot index plus a generation, as in timer_wheel: slots are
+// recycled by later pushes, but the generation changes, so a stale handle is
+// rejected by contains() and throws from the other calls.
+template <typename T, typename Comparator = std::less<T>, std::size_t Arity = 2>
+class indexed_priority_queue {
+    static_assert(Arity >= 2, "indexed_priority_queue arity must be at least 2");
+
+public:
+    using handle = uint64_t;
+
+private:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    struct Entry {
+        T value;
+        uint32_t slot;
+    };
+
+    struct Slot {
+        std::size_t position = npos;  // index in heap, npos while free
+        uint32_t generation = 0;
+    };
+
+    std::vector<Entry> heap;
+    std::vector<Slot> slots;
+    std::vector<uint32_t> freeSlots;
+    Comparator comp;
+
+    static handle makeHandle(uint32_t slot, uint32_t generation) {
+        return (static_cast<uint64_t>(generation) << 32) | slot;
+    }
+
+    void heapifyUp(std::size_t index) {
+        dary_heap::sift_up<Arity>(heap, index, entryBelow(), positionHook());
+    }
+
+    void heapifyDown(std::size_t index) {
+        dary_heap::sift_down<Arity>(heap, index, entryBelow(), positionHook());
+    }
+
+    auto entryBelow() {
+        return [this](const Entry& a, const Entry& b) { return comp(a.value, b.value); };
+    }
+
+    auto positionHook() {
+        return [this](const Entry& entry, std::size_t index) { slots[entry.slot].position = index; };
+    }
+
+    // sift whichever way the element at index needs to go
+    void restore(std::size_t index) {
+        if (index > 0 && comp(heap[(index - 1) / Arity].value, heap[index].value))
+            heapifyUp(index);
+        else
+            heapifyDown(index);
+    }
+
+    uint32_t allocateSlot() {
+        if (!freeSlots.empty()) {
+            uint32_t slot = freeSlots.back();
+            freeSlots.pop_back();
+            return slot;
+        }
+        if (slots.size() > UINT32_MAX)
+            throw std::length_error("indexed_priority_queue: too many handles");
+        slots.emplace_back();
+        return static_cast<uint32_t>(slots.size() - 1);
+    }
+
+    std::size_t indexOf(handle h) const {
+        if (!contains(h))
+            throw std::out_of_range("indexed_priority_queue: invalid handle");
+        return slots[static_cast<uint32_t>(h)].position;
+    }
+
+    void removeAt(std::size_t index) {
+        uint32_t slot = heap[index].slot;
+        slots[slot].position = npos;
+        slots[slot].generation++;
+        freeSlots.push_back(slot);
+
+        if (index + 1 == heap.size()) {
+            heap.pop_back();
+            return;
+        }
+        heap[index] = std::move(heap.back());
+        heap.pop_back();
+        slots[heap[index].slot].position = index;
+        restore(index);
+    }
+
+public:
+    indexed_priority_queue() = default;
+
+    explicit indexed_priority_queue(const Comparator& comp) : comp(comp) {}
+
+    handle push(const T& element) {
+        return emplace(element);
+    }
+
+    handle push(T&& element) {
+        return emplace(std::move(element));
+    }
+
+    template <typename... Args>
+    handle emplace(Args&&... args) {
+        uint32_t slot = allocateSlot();
+        try {
+            heap.push_back(Entry{T(std::forward<Args>(args)...), slot});
+        } catch (...) {
+            freeSlots.push_back(slot);
+            throw;
+        }
+        heapifyUp(heap.size() - 1);
+        return makeHandle(slot, slots[slot].generation);
+    }
+
+    // replace the element behind h and re-sift it, O(log n)
+    void update(handle h, const T& element) {
+        std::size_t index = indexOf(h);
+        heap[index].value = element;
+        restore(index);
+    }
+
+    void update(handle h, T&& element) {
+        std::size_t index = indexOf(h);
+        heap[index].value = std::move(element);
+        restore(index);
+    }
+
+    // Keys in the sense of T's operator<, whatever the heap's comparator: in a
+    // Dijkstra min-heap (std::greater) decrease_key moves an element toward the
+    // top. A key moving the other way throws std::invalid_argument.
+    void decrease_key(handle h, const T& element) {
+        std::size_t index = indexOf(h);
+        if (heap[index].value < element)
+            throw std::invalid_argument("decrease_key: new key is larger");
+        heap[index].value = element;
+        restore(index);
+    }
+
+    void increase_key(handle h, const T& element) {
+        std::size_t index = indexOf(h);
+        if (element < heap[index].value)
+            throw std::invalid_argument("increase_key: new key is smaller");
+        heap[index].value = element;
+        restore(index);
+    }
+
+    void erase(handle h) {
+        removeAt(indexOf(h));
+    }
+
+    void pop() {
+        if (heap.empty())
+            throw std::out_of_range("priority_queue is empty");
+        removeAt(0);
+    }
+
+    const T& top() const {
+        if (heap.empty())
+            throw std::out_of_range("priority_queue is empty");
+        return heap[0].value;
+    }
+
+    handle top_handle() const {
+        if (heap.empty())
+            throw std::out_of_range("priority_queue is empty");
+        uint32_t slot = heap[0].slot;
+        return makeHandle(slot, slots[slot].generation);
+    }
+
+    // current element behind h
+    const T& get(handle h) const {
+        return heap[indexOf(h)].value;
+    }
+
+    // false once the element behind h has been popped or erased, even if its
+    // slot now holds another element
+    bool contains(handle h) const {
+        uint32_t slot = static_cast<uint32_t>(h);
+        return slot < slots.size() && slots[slot].generation == static_cast<uint32_t>(h >> 32) &&
+               slots[slot].position != npos;
+    }
+
+    bool empty() const {
+        return heap.empty();
+    }
+
+    std::size_t size() const {
+        return heap.size();
+    }
+
+    void reserve(std::size_t capacity) {
+        heap.reserve(capacity);
+        slots.reserve(capacity);
+    }
+
+    // drops every element; handles from before stay invalid
+    void clear() {
+        freeSlots.clear();
+        for (std::size_t i = 0; i < slots.size(); i++) {
+            if (slots[i].position != npos) {
+                slots[i].position = npos;
+                slots[i].generation++;
+            }
+            freeSlots.push_back(static_cast<uint32_t>(i));
+        }
+        heap.clear();
+    }
+};
+
+}
@@ -6,6 +6,9 @@
 #include <functional>
 #include <initializer_list>
 #include <stack>
+#include <utility>
+#include "../utilities/capacity.hpp"
+#include "../utilities/serialization.hpp"
 
 namespace mystl {
 
@@ -33,6 +36,8 @@ namespace mystl {
         MapNode<K, V>* root = nullptr;
         Comp comp;
 
+        friend struct serial::codec<map>;
+
         int height(MapNode<K, V>* node) {
             return node ? node->height : 0;
         }
@@ -146,6 +151,15 @@ namespace mystl {
             return root;
         }
 
+        static MapNode<K, V>* clone(const MapNode<K, V>* node) {
+            if (!node) return nullptr;
+            MapNode<K, V>* copy = new MapNode<K, V>(node->key, node->value);
+            copy->left = clone(node->left);
+            copy->right = clone(node->right);
+            copy->height = node->height;
+            return copy;
+        }
+
         MapNode<K, V>* find(MapNode<K, V>* node, const K& key) const {
             if (!node) return nullptr;
             if (comp(key, node->key)) return find(node->left, key);
@@ -210,6 +224,19 @@ namespace mystl {
             }
         }
 
+        // deep copy; see mystl::persistent_map for O(1) snapshots
+        map(const map& other) : root(clone(other.root)), comp(other.comp) {}
+
+        map(map&& other) noexcept : root(other.root), comp(other.comp) {
+            other.root = nullptr;
+        }
+
+        map& operator=(map other) {
+            std::swap(root, other.root);
+            std::swap(comp, other.comp);
+            return *this;
+        }
+
         void insert(K key, V value) {
             root = insert(root, key, value);
         }
@@ -225,6 +252,16 @@ namespace mystl {
             return find(root, key)->value;
         }
 
+        // value for key, or V() if absent
+        V getValue(const K& key) const {
+            MapNode<K, V>* node = find(root, key);
+            return node ? node->value : V();
+        }
+
+        bool contains(const K& key) const {
+            return find(root, key) != nullptr;
+        }
+
         iterator begin() const { return iterator(root); }
         iterator end() const { return iterator(); }
 
@@ -239,4 +276,75 @@ namespace mystl {
         }
     };
 
+    namespace serial {
+
+        template <typename K, typename V, typename Comp>
+        struct codec<map<K, V, Comp>> {
+            static constexpr uint8_t tag = tag_map;
+            using Node = MapNode<K, V>;
+
+            template <typename Sink>
+            static void write(Sink& sink, const map<K, V, Comp>& m) {
+                write_count(sink, count(m.root));
+                writeInOrder(sink, m.root);
+            }
+
+            // entries arrive sorted, so the tree is built bottom-up in O(n):
+            // each subtree takes the middle entry of its range as the root,
+            // which leaves every node within the AVL balance bound
+            template <typename Source>
+            static map<K, V, Comp> read(Source& source) {
+                std::size_t n = read_count(source, max_elements<Node>());
+                map<K, V, Comp> m;
+                const K* last = nullptr;
+                m.root = build(source, n, m.comp, last);
+                return m;
+            }
+
+        private:
+            static std::size_t count(const Node* node) {
+                return node ? 1 + count(node->left) + count(node->right) : 0;
+            }
+
+            template <typename Sink>
+            static void writeInOrder(Sink& sink, const Node* node) {
+                if (!node) return;
+                writeInOrder(sink, node->left);
+                write_value(sink, node->key);
+                write_value(sink, node->value);
+                writeInOrder(sink, node->right);
+            }
+
+            template <typename Source>
+            static Node* build(Source& source, std::size_t n, const Comp& comp, const K*& last) {
+                if (n == 0) return nullptr;
+                Node* left = build(source, n / 2, comp, last);
+                Node* node;
+                try {
+                    K key = read_value<K>(source);
+                    V value = read_value<V>(source);
+                    if (last && !comp(*last, key))
+                        throw std::runtime_error("deserialize: map keys are not strictly increasing");
+                    node = new Node(std::move(key), std::move(value));
+                } catch (...) {
+                    delete left;
+                    throw;
+                }
+                node->left = left;
+                last = &node->key;
+                try {
+                    node->right = build(source, n - n / 2 - 1, comp, last);
+                } catch (...) {
+                    delete node;
+                    throw;
+                }
+                int leftHeight = left ? left->height : 0;
+                int rightHeight = node->right ? node->right->height : 0;
+                node->height = 1 + std::max(leftHeight, rightHeight);
+                return node;
+            }
+        };
+
+    }
+
 }
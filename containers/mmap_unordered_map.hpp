@@ -0,0 +1,375 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include "../utilities/hash_mix.hpp"
+#include "../utilities/mapped_file.hpp"
+#include "../utilities/pair.hpp"
+
+namespace mystl {
+
+// Hash map of trivially copyable keys and values stored in a memory-mapped
+// file, so a restart maps the file and serves lookups at once instead of
+// re-inserting every entry.
+//
+// The file is a 128-byte header followed by an arena. Nodes (pair<K, V>) and
+// the slot array are allocated from the arena, and every link is a file
+// offset rather than a pointer, so the mapping can move when the file grows
+// and the file can be mapped anywhere by the next process. The slot array is
+// open-addressed with linear probing; a slot holds the offset of its node.
+// Freed nodes and slot arrays replaced by a rehash go on free lists and are
+// reused, so a map of steady size under churn keeps a steady file size.
+//
+// Every change commits with one 8-byte store made after the data it
+// publishes is written: an insert writes its node, then its slot; a rehash
+// fills a new slot array, then swaps the header's table word. A crash
+// therefore leaves either the old or the new state, at worst leaking a node
+// or an old slot array. size() is recounted on open if the previous process
+// did not close the map. Overwriting an existing key stores the value bytes
+// in place and is not atomic. Call sync() for durability across a power
+// loss. One process may have the file open at a time; a second open fails.
+//
+// HashFunc must give the same value for a key in every process
+// (std::hash of integers does; anything hashing addresses does not).
+template <typename K, typename V, typename HashFunc = std::hash<K>>
+class mmap_unordered_map {
+    static_assert(std::is_trivially_copyable<K>::value && std::is_trivially_copyable<V>::value,
+                  "mmap_unordered_map stores raw bytes: K and V must be trivially copyable");
+
+    using Node = pair<K, V>;
+    static_assert(alignof(Node) <= 64, "mmap_unordered_map nodes are aligned to at most 64 bytes");
+
+    struct Header {
+        uint64_t magic;
+        uint32_t version;
+        uint32_t keySize;
+        uint32_t valueSize;
+        uint32_t open;         // nonzero while a process has the map open
+        uint64_t top;          // end of the allocated part of the arena
+        uint64_t table;        // slot array offset | log2(slot count)
+        uint64_t count;
+        uint64_t tombstones;
+        uint64_t freeList;     // offset of the first free node, 0 if none
+        uint64_t freeTables;   // first retired slot array (offset | log2), 0 if none
+        uint64_t reserved[7];
+    };
+    static_assert(sizeof(Header) == 128, "mmap_unordered_map header is two cache lines");
+
+    static constexpr uint64_t kMagic = 0x31304d4d4d4c5453ull;  // "STLMMM01"
+    static constexpr uint32_t kVersion = 2;
+    static constexpr uint64_t kEmpty = 0;
+    static constexpr uint64_t kErased = 1;
+    static constexpr uint64_t kLog2Mask = 63;  // slot arrays are 64-byte aligned
+    static constexpr unsigned kMinLog2 = 4;
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    // free nodes keep the next free offset in their first 8 bytes
+    static constexpr std::size_t kNodeAlign = alignof(Node) > 8 ? alignof(Node) : 8;
+    static constexpr std::size_t kNodeSize =
+        ((sizeof(Node) > 8 ? sizeof(Node) : 8) + kNodeAlign - 1) / kNodeAlign * kNodeAlign;
+
+    mapped_file file;
+    HashFunc hashFunc;
+
+    Header* header() { return reinterpret_cast<Header*>(file.data()); }
+    const Header* header() const { return reinterpret_cast<const Header*>(file.data()); }
+
+    uint64_t* slots() {
+        return reinterpret_cast<uint64_t*>(file.data() + (header()->table & ~kLog2Mask));
+    }
+
+    const uint64_t* slots() const {
+        return reinterpret_cast<const uint64_t*>(file.data() + (header()->table & ~kLog2Mask));
+    }
+
+    std::size_t slotCount() const {
+        return std::size_t(1) << (header()->table & kLog2Mask);
+    }
+
+    Node* node(uint64_t offset) { return reinterpret_cast<Node*>(file.data() + offset); }
+    const Node* node(uint64_t offset) const { return reinterpret_cast<const Node*>(file.data() + offset); }
+
+    std::size_t hashOf(const K& key) const {
+        return static_cast<std::size_t>(mix64(hashFunc(key)));
+    }
+
+    // smallest table that keeps n keys at or under half full
+    static unsigned log2For(std::size_t n) {
+        unsigned log2 = kMinLog2;
+        while ((std::size_t(1) << log2) < n * 2) log2++;
+        return log2;
+    }
+
+    // bump-allocate from the arena; top is committed before the bytes are used
+    uint64_t allocate(std::size_t bytes, std::size_t align) {
+        uint64_t offset = (header()->top + align - 1) & ~static_cast<uint64_t>(align - 1);
+        uint64_t end = offset + bytes;
+        file.grow(end);
+        header()->top = end;
+        return offset;
+    }
+
+    uint64_t allocateNode() {
+        uint64_t offset = header()->freeList;
+        if (offset) {
+            uint64_t next;
+            std::memcpy(&next, file.data() + offset, sizeof(next));
+            header()->freeList = next;
+            return offset;
+        }
+        return allocate(kNodeSize, kNodeAlign);
+    }
+
+    void freeNode(uint64_t offset) {
+        uint64_t next = header()->freeList;
+        std::memcpy(file.data() + offset, &next, sizeof(next));
+        header()->freeList = offset;
+    }
+
+    // a zeroed array of 2^log2 slots, reusing a retired one of that size if any
+    uint64_t allocateSlots(unsigned log2) {
+        std::size_t bytes = sizeof(uint64_t) << log2;
+        uint64_t offset = takeRetiredSlots(log2);
+        if (!offset) offset = allocate(bytes, 64);
+        std::memset(file.data() + offset, 0, bytes);
+        return offset;
+    }
+
+    // unlink a retired array of 2^log2 slots from the free list, or return 0;
+    // a retired array keeps the next list entry in its first slot
+    uint64_t takeRetiredSlots(unsigned log2) {
+        uint64_t* link = &header()->freeTables;
+        while (*link) {
+            uint64_t offset = *link & ~kLog2Mask;
+            uint64_t* first = reinterpret_cast<uint64_t*>(file.data() + offset);
+            if ((*link & kLog2Mask) == log2) {
+                *link = *first;
+                return offset;
+            }
+            link = first;
+        }
+        return 0;
+    }
+
+    // table is a slot array word (offset | log2) that is no longer published
+    void retireSlots(uint64_t table) {
+        *reinterpret_cast<uint64_t*>(file.data() + (table & ~kLog2Mask)) = header()->freeTables;
+        header()->freeTables = table;
+    }
+
+    std::size_t findSlot(const K& key) const {
+        const uint64_t* s = slots();
+        std::size_t mask = slotCount() - 1;
+        for (std::size_t i = hashOf(key) & mask;; i = (i + 1) & mask) {
+            if (s[i] == kEmpty) return npos;
+            if (s[i] != kErased && node(s[i])->first == key) return i;
+        }
+    }
+
+    // fill a fresh slot array from the live nodes, then publish it; nodes are
+    // not touched, so the old table stays valid until the switch and is only
+    // retired after it. A rehash that just clears tombstones at the same size
+    // therefore alternates between two arrays.
+    void rehash(unsigned log2) {
+        uint64_t fresh = allocateSlots(log2);
+        uint64_t* dst = reinterpret_cast<uint64_t*>(file.data() + fresh);
+        const uint64_t* src = slots();
+        std::size_t n = slotCount();
+        std::size_t mask = (std::size_t(1) << log2) - 1;
+        for (std::size_t i = 0; i < n; i++) {
+            if (src[i] <= kErased) continue;
+            std::size_t j = hashOf(node(src[i])->first) & mask;
+            while (dst[j] != kEmpty) j = (j + 1) & mask;
+            dst[j] = src[i];
+        }
+        uint64_t old = header()->table;
+        header()->table = fresh | log2;
+        header()->tombstones = 0;
+        retireSlots(old);
+    }
+
+    // keep at least 30% of the slots empty so probes stay short and end
+    void growIfNeeded() {
+        const Header* h = header();
+        if ((h->count + h->tombstones + 1) * 10 > slotCount() * 7)
+            rehash(log2For(h->count + 1));
+    }
+
+    // the previous process died with the map open: its size counters may be
+    // one operation behind the slots, so count them again
+    void recount() {
+        const uint64_t* s = slots();
+        uint64_t live = 0, erased = 0;
+        for (std::size_t i = 0, n = slotCount(); i < n; i++) {
+            live += s[i] > kErased;
+            erased += s[i] == kErased;
+        }
+        header()->count = live;
+        header()->tombstones = erased;
+    }
+
+public:
+    class iterator {
+        const mmap_unordered_map* map;
+        std::size_t index;
+
+        void skipEmpty() {
+            std::size_t n = map->slotCount();
+            const uint64_t* s = map->slots();
+            while (index < n && s[index] <= kErased) index++;
+        }
+
+    public:
+        iterator(const mmap_unordered_map* map, std::size_t index) : map(map), index(index) {
+            skipEmpty();
+        }
+
+        const pair<K, V>& operator*() const { return *map->node(map->slots()[index]); }
+        const pair<K, V>* operator->() const { return &**this; }
+
+        iterator& operator++() {
+            index++;
+            skipEmpty();
+            return *this;
+        }
+
+        bool operator==(const iterator& other) const { return index == other.index; }
+        bool operator!=(const iterator& other) const { return index != other.index; }
+    };
+
+    // open path, creating an empty map there if the file does not exist;
+    // expectedKeys pre-sizes the table and the arena
+    explicit mmap_unordered_map(const std::string& path, std::size_t expectedKeys = 0)
+        : file(path, sizeof(Header) + (sizeof(uint64_t) << log2For(expectedKeys)) + 64 +
+                         expectedKeys * kNodeSize) {
+        if (file.size() < sizeof(Header))
+            throw std::runtime_error("mmap_unordered_map: " + path + " is too short to be a map file");
+        Header* h = header();
+        // an all-zero header is a file whose creation was cut short
+        if (file.created() || file.zeroed(sizeof(Header))) {
+            h->magic = kMagic;
+            h->version = kVersion;
+            h->keySize = sizeof(K);
+            h->valueSize = sizeof(V);
+            h->top = sizeof(Header);
+            h->count = h->tombstones = h->freeList = h->freeTables = 0;
+            unsigned log2 = log2For(expectedKeys);
+            uint64_t table = allocateSlots(log2);
+            header()->table = table | log2;
+        } else {
+            if (h->magic != kMagic || h->version != kVersion)
+                throw std::runtime_error("mmap_unordered_map: " + path + " is not a map file");
+            if (h->keySize != sizeof(K) || h->valueSize != sizeof(V))
+                throw std::runtime_error("mmap_unordered_map: " + path + " holds different key or value types");
+            if (h->top > file.size())
+                throw std::runtime_error("mmap_unordered_map: " + path + " is truncated");
+            if (h->open) recount();
+            reserve(expectedKeys);
+        }
+        header()->open = 1;
+    }
+
+    mmap_unordered_map(mmap_unordered_map&&) noexcept = default;
+    mmap_unordered_map& operator=(mmap_unordered_map&&) = delete;
+    mmap_unordered_map(const mmap_unordered_map&) = delete;
+    mmap_unordered_map& operator=(const mmap_unordered_map&) = delete;
+
+    ~mmap_unordered_map() {
+        if (file.data()) header()->open = 0;
+    }
+
+    void insert(const K& key, const V& value) {
+        Node entry(key, value);  // key and value may point into the mapping,
+        growIfNeeded();          // which growing the file can move
+        const K& k = entry.first;
+        uint64_t* s = slots();
+        std::size_t mask = slotCount() - 1;
+        std::size_t target = npos;
+        std::size_t i = hashOf(k) & mask;
+        for (; s[i] != kEmpty; i = (i + 1) & mask) {
+            if (s[i] == kErased) {
+                if (target == npos) target = i;
+            } else if (node(s[i])->first == k) {
+                node(s[i])->second = entry.second;
+                return;
+            }
+        }
+        if (target == npos) target = i;
+        bool reused = s[target] == kErased;
+        uint64_t offset = allocateNode();
+        new (node(offset)) Node(entry);
+        slots()[target] = offset;
+        if (reused) header()->tombstones--;
+        header()->count++;
+    }
+
+    // erase key and return its value, or V() if it was absent
+    V remove(const K& key) {
+        std::size_t i = findSlot(key);
+        if (i == npos) return V();
+        uint64_t offset = slots()[i];
+        V value = node(offset)->second;
+        slots()[i] = kErased;
+        header()->tombstones++;
+        header()->count--;
+        freeNode(offset);
+        return value;
+    }
+
+    // value for key, or V() if absent
+    V getValue(const K& key) const {
+        std::size_t i = findSlot(key);
+        return i == npos ? V() : node(slots()[i])->second;
+    }
+
+    bool contains(const K& key) const {
+        return findSlot(key) != npos;
+    }
+
+    // value of an existing key; references stay valid until the file grows
+    V& operator[](const K& key) {
+        std::size_t i = findSlot(key);
+        if (i == npos) throw std::runtime_error("key does not exist");
+        return node(slots()[i])->second;
+    }
+
+    // size the table and the arena for n keys up front
+    void reserve(std::size_t n) {
+        if (n * 10 > slotCount() * 7) rehash(log2For(n));
+        if (n > header()->count)
+            file.grow(header()->top + (n - header()->count) * kNodeSize);
+    }
+
+    iterator begin() const { return iterator(this, 0); }
+    iterator end() const { return iterator(this, slotCount()); }
+
+    std::size_t size() const {
+        return static_cast<std::size_t>(header()->count);
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    std::size_t bucket_count() const {
+        return slotCount();
+    }
+
+    // bytes of the arena in use, including free nodes and retired slot arrays
+    std::size_t file_bytes() const {
+        return static_cast<std::size_t>(header()->top);
+    }
+
+    // flush to disk (msync)
+    void sync() {
+        file.sync();
+    }
+};
+
+}
@@ -0,0 +1,227 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include "vector.hpp"
+#include "../utilities/capacity.hpp"
+#include "../utilities/mapped_file.hpp"
+
+namespace mystl {
+
+// Vector of trivially copyable elements stored in a memory-mapped file:
+// opening an existing file maps it and is ready immediately, with no parse
+// and no per-element rebuild. Layout is a 64-byte header followed by the
+// elements, so the file is only portable between builds with the same T
+// layout and endianness (the header records sizeof/alignof T and rejects a
+// mismatch).
+//
+// push_back writes the element before bumping the stored size, and growth
+// extends the file before the mapping, so a crash at any point reopens to
+// the last completed push_back. Call sync() for durability across a power
+// loss.
+template <typename T>
+class mmap_vector {
+    static_assert(std::is_trivially_copyable<T>::value, "mmap_vector stores raw bytes: T must be trivially copyable");
+    static_assert(alignof(T) <= 64, "mmap_vector elements are aligned to at most 64 bytes");
+
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+private:
+    struct Header {
+        uint64_t magic;
+        uint32_t version;
+        uint32_t elementSize;
+        uint32_t elementAlign;
+        uint32_t reserved;
+        uint64_t count;
+        unsigned char padding[32];
+    };
+    static_assert(sizeof(Header) == 64, "mmap_vector header is one cache line");
+
+    static constexpr uint64_t kMagic = 0x3130564d4d4c5453ull;  // "STLMMV01"
+    static constexpr uint32_t kVersion = 1;
+
+    mapped_file file;
+
+    Header* header() {
+        return reinterpret_cast<Header*>(file.data());
+    }
+
+    const Header* header() const {
+        return reinterpret_cast<const Header*>(file.data());
+    }
+
+    T* elements() {
+        return reinterpret_cast<T*>(file.data() + sizeof(Header));
+    }
+
+    const T* elements() const {
+        return reinterpret_cast<const T*>(file.data() + sizeof(Header));
+    }
+
+    std::size_t count() const {
+        return static_cast<std::size_t>(header()->count);
+    }
+
+    void checkIndex(std::size_t index) const {
+#if MYSTL_VECTOR_CHECKS
+        if (index >= count()) {
+            throw std::out_of_range("Index out of bounds");
+        }
+#else
+        (void)index;
+#endif
+    }
+
+    void growFor(std::size_t n) {
+        check_capacity(n, max_size(), "mmap_vector exceeds max_size");
+        file.grow(sizeof(Header) + n * sizeof(T));
+    }
+
+public:
+    // open path, creating an empty vector there if the file does not exist
+    explicit mmap_vector(const std::string& path, std::size_t initialCapacity = 0)
+        : file(path, sizeof(Header) + initialCapacity * sizeof(T)) {
+        if (file.size() < sizeof(Header))
+            throw std::runtime_error("mmap_vector: " + path + " is too short to be a mmap_vector file");
+        Header* h = header();
+        // an all-zero header is a file whose creation was cut short
+        if (file.created() || file.zeroed(sizeof(Header))) {
+            h->magic = kMagic;
+            h->version = kVersion;
+            h->elementSize = sizeof(T);
+            h->elementAlign = alignof(T);
+            h->count = 0;
+        } else {
+            if (h->magic != kMagic || h->version != kVersion)
+                throw std::runtime_error("mmap_vector: " + path + " is not a mmap_vector file");
+            if (h->elementSize != sizeof(T) || h->elementAlign != alignof(T))
+                throw std::runtime_error("mmap_vector: " + path + " holds a different element type");
+            if (h->count > get_capacity())
+                throw std::runtime_error("mmap_vector: " + path + " is truncated");
+        }
+        if (initialCapacity > get_capacity()) growFor(initialCapacity);
+    }
+
+    mmap_vector(mmap_vector&&) noexcept = default;
+    mmap_vector& operator=(mmap_vector&&) noexcept = default;
+
+    void push_back(const T& element) {
+        std::size_t n = count();
+        if (n == get_capacity()) {
+            T copy = element;  // element may live in the mapping that grow() moves
+            growFor(n + 1);
+            std::memcpy(static_cast<void*>(elements() + n), &copy, sizeof(T));
+        } else {
+            std::memcpy(static_cast<void*>(elements() + n), &element, sizeof(T));
+        }
+        header()->count = n + 1;
+    }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        push_back(T(std::forward<Args>(args)...));
+        return back();
+    }
+
+    void pop_back() {
+        if (count() == 0) {
+            throw std::out_of_range("pop_back on empty mmap_vector");
+        }
+        header()->count = count() - 1;
+    }
+
+    T& operator[](std::size_t index) {
+        checkIndex(index);
+        return elements()[index];
+    }
+
+    const T& operator[](std::size_t index) const {
+        checkIndex(index);
+        return elements()[index];
+    }
+
+    T& at(std::size_t index) {
+        if (index >= count()) {
+            throw std::out_of_range("Index out of bounds for at");
+        }
+        return elements()[index];
+    }
+
+    const T& at(std::size_t index) const {
+        if (index >= count()) {
+            throw std::out_of_range("Index out of bounds for at");
+        }
+        return elements()[index];
+    }
+
+    T& front() {
+        checkIndex(0);
+        return elements()[0];
+    }
+
+    const T& front() const {
+        checkIndex(0);
+        return elements()[0];
+    }
+
+    T& back() {
+        checkIndex(0);
+        return elements()[count() - 1];
+    }
+
+    const T& back() const {
+        checkIndex(0);
+        return elements()[count() - 1];
+    }
+
+    // pointers stay valid until the next call that grows the file
+    T* data() { return elements(); }
+    const T* data() const { return elements(); }
+
+    iterator begin() { return elements(); }
+    iterator end() { return elements() + count(); }
+    const_iterator begin() const { return elements(); }
+    const_iterator end() const { return elements() + count(); }
+
+    // grow the file so newCapacity elements fit without remapping
+    void reserve(std::size_t newCapacity) {
+        if (newCapacity > get_capacity()) growFor(newCapacity);
+    }
+
+    // size becomes 0; the file keeps its length
+    void clear() {
+        header()->count = 0;
+    }
+
+    std::size_t size() const {
+        return count();
+    }
+
+    std::size_t get_capacity() const {
+        return (file.size() - sizeof(Header)) / sizeof(T);
+    }
+
+    static constexpr std::size_t max_size() {
+        return (max_elements<unsigned char>() - sizeof(Header)) / sizeof(T);
+    }
+
+    bool empty() const {
+        return count() == 0;
+    }
+
+    // flush to disk (msync)
+    void sync() {
+        file.sync();
+    }
+};
+
+}
@@ -0,0 +1,169 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include "../utilities/cache_line.hpp"
+
+namespace mystl {
+
+// Bounded lock-free queue for any number of producers and consumers.
+// Every slot carries a sequence number telling whose turn it is: a producer at
+// position p may fill the slot when its sequence is p, a consumer may drain it
+// when the sequence is p + 1, and draining hands it to the next lap by setting
+// it to p + capacity. Positions are claimed with a CAS on the shared counters.
+template <typename T>
+class mpmc_queue {
+private:
+    struct Slot {
+        std::atomic<size_t> sequence;
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T* value() {
+            return reinterpret_cast<T*>(storage);
+        }
+    };
+
+    Slot* slots;
+    size_t mask;
+
+    alignas(cache_line_size) std::atomic<size_t> enqueuePos;
+    alignas(cache_line_size) std::atomic<size_t> dequeuePos;
+    char padding[cache_line_size - sizeof(std::atomic<size_t>)];
+
+    static size_t roundUpPow2(size_t n) {
+        size_t cap = 1;
+        while (cap < n) cap <<= 1;
+        return cap;
+    }
+
+    // Claim up to wanted consecutive positions from counter whose slots all have
+    // sequence == pos + i + lag. Returns the first claimed position and sets claimed.
+    size_t claim(std::atomic<size_t>& counter, size_t lag, size_t wanted, size_t& claimed) {
+        size_t pos = counter.load(std::memory_order_relaxed);
+        for (;;) {
+            size_t ready = 0;
+            bool stale = false;
+            while (ready < wanted) {
+                size_t seq = slots[(pos + ready) & mask].sequence.load(std::memory_order_acquire);
+                intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + ready + lag);
+                if (diff != 0) {
+                    // ahead of us on the first slot: another thread already took pos
+                    stale = diff > 0 && ready == 0;
+                    break;
+                }
+                ready++;
+            }
+
+            if (stale) {
+                pos = counter.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (ready == 0) {
+                claimed = 0;
+                return pos;
+            }
+            if (counter.compare_exchange_weak(pos, pos + ready, std::memory_order_relaxed)) {
+                claimed = ready;
+                return pos;
+            }
+        }
+    }
+
+public:
+    // capacity is rounded up to a power of two
+    explicit mpmc_queue(size_t capacity)
+        : mask(roundUpPow2(capacity < 2 ? 2 : capacity) - 1), enqueuePos(0), dequeuePos(0) {
+        slots = static_cast<Slot*>(::operator new(sizeof(Slot) * (mask + 1)));
+        for (size_t i = 0; i <= mask; i++)
+            new (&slots[i].sequence) std::atomic<size_t>(i);
+    }
+
+    mpmc_queue(const mpmc_queue&) = delete;
+    mpmc_queue& operator=(const mpmc_queue&) = delete;
+
+    ~mpmc_queue() {
+        size_t h = dequeuePos.load(std::memory_order_relaxed);
+        size_t t = enqueuePos.load(std::memory_order_relaxed);
+        for (; h != t; h++)
+            slots[h & mask].value()->~T();
+        ::operator delete(slots);
+    }
+
+    template <typename... Args>
+    bool try_emplace(Args&&... args) {
+        size_t claimed;
+        size_t pos = claim(enqueuePos, 0, 1, claimed);
+        if (!claimed) return false;
+        Slot& slot = slots[pos & mask];
+        new (slot.storage) T(std::forward<Args>(args)...);
+        slot.sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_push(const T& element) {
+        return try_emplace(element);
+    }
+
+    bool try_push(T&& element) {
+        return try_emplace(std::move(element));
+    }
+
+    // claims a run of free slots with one CAS and copies up to count items into it;
+    // returns how many were pushed
+    size_t try_push_batch(const T* items, size_t count) {
+        if (count == 0) return 0;
+        size_t claimed;
+        size_t pos = claim(enqueuePos, 0, count, claimed);
+        for (size_t i = 0; i < claimed; i++) {
+            Slot& slot = slots[(pos + i) & mask];
+            new (slot.storage) T(items[i]);
+            slot.sequence.store(pos + i + 1, std::memory_order_release);
+        }
+        return claimed;
+    }
+
+    bool try_pop(T& out) {
+        size_t claimed;
+        size_t pos = claim(dequeuePos, 1, 1, claimed);
+        if (!claimed) return false;
+        Slot& slot = slots[pos & mask];
+        out = std::move(*slot.value());
+        slot.value()->~T();
+        slot.sequence.store(pos + mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    // claims a run of filled slots with one CAS and moves up to maxCount items out;
+    // returns how many were popped
+    size_t try_pop_batch(T* out, size_t maxCount) {
+        if (maxCount == 0) return 0;
+        size_t claimed;
+        size_t pos = claim(dequeuePos, 1, maxCount, claimed);
+        for (size_t i = 0; i < claimed; i++) {
+            Slot& slot = slots[(pos + i) & mask];
+            out[i] = std::move(*slot.value());
+            slot.value()->~T();
+            slot.sequence.store(pos + i + mask + 1, std::memory_order_release);
+        }
+        return claimed;
+    }
+
+    // approximate when other threads are active
+    size_t size() const {
+        size_t t = enqueuePos.load(std::memory_order_acquire);
+        size_t h = dequeuePos.load(std::memory_order_acquire);
+        return t > h ? t - h : 0;
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    size_t capacity() const {
+        return mask + 1;
+    }
+};
+
+}
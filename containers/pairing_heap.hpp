@@ -0,0 +1,150 @@
+#pragma once
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace mystl {
+
+template <typename T>
+class PairingNode {
+public:
+    T data;
+    PairingNode* child;
+    PairingNode* sibling;
+
+    template <typename... Args>
+    PairingNode(Args&&... args) : data(std::forward<Args>(args)...), child(nullptr), sibling(nullptr) {}
+};
+
+// Pairing heap: a heap-ordered multiway tree. push and meld are O(1) (one
+// comparison links two roots), pop is amortized O(log n) via two-pass pairing of
+// the root's children. Same ordering convention as mystl::priority_queue:
+// std::less gives a max-heap, std::greater a min-heap.
+template <typename T, typename Comparator = std::less<T>>
+class pairing_heap {
+private:
+    PairingNode<T>* root = nullptr;
+    std::size_t _size = 0;
+    Comparator comp;
+    std::vector<PairingNode<T>*> scratch;
+
+    // make the lower-priority root the first child of the other
+    PairingNode<T>* link(PairingNode<T>* a, PairingNode<T>* b) {
+        if (!a) return b;
+        if (!b) return a;
+        if (comp(a->data, b->data)) std::swap(a, b);
+        b->sibling = a->child;
+        a->child = b;
+        return a;
+    }
+
+    // two-pass pairing: link children in pairs left to right, then fold the
+    // pairs into one tree right to left
+    PairingNode<T>* mergePairs(PairingNode<T>* first) {
+        scratch.clear();
+        while (first) {
+            PairingNode<T>* a = first;
+            PairingNode<T>* b = a->sibling;
+            first = b ? b->sibling : nullptr;
+            a->sibling = nullptr;
+            if (b) b->sibling = nullptr;
+            scratch.push_back(link(a, b));
+        }
+
+        PairingNode<T>* result = nullptr;
+        while (!scratch.empty()) {
+            result = link(scratch.back(), result);
+            scratch.pop_back();
+        }
+        return result;
+    }
+
+    void destroy(PairingNode<T>* node) {
+        // iterative so deep trees cannot overflow the stack
+        while (node) {
+            if (node->child) {
+                PairingNode<T>* child = node->child;
+                node->child = child->sibling;
+                child->sibling = node->sibling;
+                node->sibling = child;
+            } else {
+                PairingNode<T>* next = node->sibling;
+                delete node;
+                node = next;
+            }
+        }
+    }
+
+public:
+    pairing_heap() = default;
+
+    explicit pairing_heap(const Comparator& comp) : comp(comp) {}
+
+    pairing_heap(const pairing_heap&) = delete;
+    pairing_heap& operator=(const pairing_heap&) = delete;
+
+    pairing_heap(pairing_heap&& other) noexcept
+        : root(other.root), _size(other._size), comp(std::move(other.comp)) {
+        other.root = nullptr;
+        other._size = 0;
+    }
+
+    ~pairing_heap() {
+        clear();
+    }
+
+    void push(const T& element) {
+        emplace(element);
+    }
+
+    void push(T&& element) {
+        emplace(std::move(element));
+    }
+
+    template <typename... Args>
+    void emplace(Args&&... args) {
+        root = link(root, new PairingNode<T>(std::forward<Args>(args)...));
+        _size++;
+    }
+
+    // take every element of other in O(1); other is left empty
+    void meld(pairing_heap& other) {
+        if (this == &other) return;
+        root = link(root, other.root);
+        _size += other._size;
+        other.root = nullptr;
+        other._size = 0;
+    }
+
+    void pop() {
+        if (!root)
+            throw std::out_of_range("pairing_heap is empty");
+        PairingNode<T>* old = root;
+        root = mergePairs(root->child);
+        delete old;
+        _size--;
+    }
+
+    const T& top() const {
+        if (!root)
+            throw std::out_of_range("pairing_heap is empty");
+        return root->data;
+    }
+
+    bool empty() const {
+        return _size == 0;
+    }
+
+    std::size_t size() const {
+        return _size;
+    }
+
+    void clear() {
+        destroy(root);
+        root = nullptr;
+        _size = 0;
+    }
+};
+
+}
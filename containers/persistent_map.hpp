@@ -0,0 +1,263 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <stack>
+#include <stdexcept>
+#include <utility>
+
+namespace mystl {
+
+    template <typename K, typename V>
+    class PersistentMapNode {
+    public:
+        using Ptr = std::shared_ptr<const PersistentMapNode>;
+
+        K key;
+        V value;
+        Ptr left;
+        Ptr right;
+        int height;
+
+        PersistentMapNode(K k, V v, Ptr l, Ptr r)
+            : key(std::move(k)), value(std::move(v)), left(std::move(l)), right(std::move(r)) {
+            height = 1 + std::max(left ? left->height : 0, right ? right->height : 0);
+        }
+    };
+
+    // Immutable AVL map with structural sharing.
+    //
+    // insert and erase never modify a node: they copy the O(log n) nodes on the
+    // path to the key and return a new map that shares every other subtree with
+    // the old one, so earlier versions stay valid and unchanged. Copying a
+    // persistent_map is O(1), which makes snapshots free: a reader keeps the
+    // version it copied while writers publish new ones. Rebalancing follows the
+    // same rotation cases as mystl::map, building fresh nodes instead of
+    // relinking existing ones.
+    template <typename K, typename V, typename Comp = std::less<K>>
+    class persistent_map {
+    private:
+        using Node = PersistentMapNode<K, V>;
+        using Ptr = typename Node::Ptr;
+
+        Ptr root;
+        std::size_t count = 0;
+        Comp comp;
+
+        persistent_map(Ptr root, std::size_t count, const Comp& comp) : root(std::move(root)), count(count), comp(comp) {}
+
+        static int height(const Ptr& node) {
+            return node ? node->height : 0;
+        }
+
+        static int getBalance(const Ptr& node) {
+            return node ? height(node->left) - height(node->right) : 0;
+        }
+
+        static Ptr make(const Ptr& from, Ptr left, Ptr right) {
+            return std::make_shared<const Node>(from->key, from->value, std::move(left), std::move(right));
+        }
+
+        static Ptr rightRotate(const Ptr& y) {
+            const Ptr& x = y->left;
+            return make(x, x->left, make(y, x->right, y->right));
+        }
+
+        static Ptr leftRotate(const Ptr& x) {
+            const Ptr& y = x->right;
+            return make(y, make(x, x->left, y->left), y->right);
+        }
+
+        static Ptr rebalance(const Ptr& node) {
+            int balance = getBalance(node);
+
+            if (balance > 1 && getBalance(node->left) >= 0)
+                return rightRotate(node);
+            if (balance > 1 && getBalance(node->left) < 0)
+                return rightRotate(make(node, leftRotate(node->left), node->right));
+            if (balance < -1 && getBalance(node->right) <= 0)
+                return leftRotate(node);
+            if (balance < -1 && getBalance(node->right) > 0)
+                return leftRotate(make(node, node->left, rightRotate(node->right)));
+
+            return node;
+        }
+
+        Ptr insert(const Ptr& node, const K& key, const V& value, bool& added) const {
+            if (!node) {
+                added = true;
+                return std::make_shared<const Node>(key, value, nullptr, nullptr);
+            }
+
+            if (comp(key, node->key))
+                return rebalance(make(node, insert(node->left, key, value, added), node->right));
+            if (comp(node->key, key))
+                return rebalance(make(node, node->left, insert(node->right, key, value, added)));
+
+            return std::make_shared<const Node>(node->key, value, node->left, node->right);
+        }
+
+        // path copy of node's subtree without its minimum; min receives that node
+        static Ptr eraseMin(const Ptr& node, Ptr& min) {
+            if (!node->left) {
+                min = node;
+                return node->right;
+            }
+            return rebalance(make(node, eraseMin(node->left, min), node->right));
+        }
+
+        Ptr erase(const Ptr& node, const K& key, bool& removed) const {
+            if (!node) return node;
+
+            if (comp(key, node->key)) {
+                Ptr left = erase(node->left, key, removed);
+                return removed ? rebalance(make(node, left, node->right)) : node;
+            }
+            if (comp(node->key, key)) {
+                Ptr right = erase(node->right, key, removed);
+                return removed ? rebalance(make(node, node->left, right)) : node;
+            }
+
+            removed = true;
+            if (!node->left) return node->right;
+            if (!node->right) return node->left;
+
+            Ptr successor;
+            Ptr right = eraseMin(node->right, successor);
+            return rebalance(make(successor, node->left, right));
+        }
+
+        const Node* find(const K& key) const {
+            const Node* node = root.get();
+            while (node) {
+                if (comp(key, node->key)) node = node->left.get();
+                else if (comp(node->key, key)) node = node->right.get();
+                else return node;
+            }
+            return nullptr;
+        }
+
+    public:
+        class iterator {
+        public:
+            using value_type = std::pair<const K, V>;
+
+        private:
+            std::stack<const Node*> stk;
+            std::optional<value_type> current;  // what operator-> points at
+
+            void pushLeft(const Node* node) {
+                while (node) {
+                    stk.push(node);
+                    node = node->left.get();
+                }
+            }
+
+        public:
+            iterator(const Node* root) { pushLeft(root); }
+            iterator() = default;
+
+            // current holds a const key, so it is rebuilt rather than assigned
+            iterator(const iterator& other) : stk(other.stk) {}
+
+            iterator& operator=(const iterator& other) {
+                stk = other.stk;
+                current.reset();
+                return *this;
+            }
+
+            bool operator!=(const iterator& other) const {
+                return stk != other.stk;
+            }
+
+            value_type operator*() const {
+                auto* node = stk.top();
+                return { node->key, node->value };
+            }
+
+            value_type* operator->() {
+                auto* node = stk.top();
+                current.emplace(node->key, node->value);
+                return &*current;
+            }
+
+            iterator& operator++() {
+                auto* node = stk.top();
+                stk.pop();
+                if (node->right) pushLeft(node->right.get());
+                return *this;
+            }
+
+            iterator operator++(int) {
+                iterator temp = *this;
+                ++(*this);
+                return temp;
+            }
+        };
+
+        persistent_map() = default;
+
+        persistent_map(std::initializer_list<std::pair<K, V>> initList) {
+            for (const auto& item : initList) {
+                *this = insert(item.first, item.second);
+            }
+        }
+
+        // new version with key set to value; this version is unchanged
+        persistent_map insert(const K& key, const V& value) const {
+            bool added = false;
+            Ptr newRoot = insert(root, key, value, added);
+            return persistent_map(std::move(newRoot), count + (added ? 1 : 0), comp);
+        }
+
+        // new version without key; shares the whole tree if key is absent
+        persistent_map erase(const K& key) const {
+            bool removed = false;
+            Ptr newRoot = erase(root, key, removed);
+            if (!removed) return *this;
+            return persistent_map(std::move(newRoot), count - 1, comp);
+        }
+
+        const V& at(const K& key) const {
+            const Node* node = find(key);
+            if (!node) throw std::out_of_range("key does not exist");
+            return node->value;
+        }
+
+        const V& operator[](const K& key) const {
+            return at(key);
+        }
+
+        // value for key, or V() if absent
+        V getValue(const K& key) const {
+            const Node* node = find(key);
+            return node ? node->value : V();
+        }
+
+        bool contains(const K& key) const {
+            return find(key) != nullptr;
+        }
+
+        std::size_t size() const {
+            return count;
+        }
+
+        bool empty() const {
+            return count == 0;
+        }
+
+        iterator begin() const { return iterator(root.get()); }
+        iterator end() const { return iterator(); }
+
+        void print() const {
+            for (auto [k, v] : *this) {
+                std::cout << k << " : " << v << std::endl;
+            }
+        }
+    };
+
+}
@@ -0,0 +1,244 @@
+#pragma once
+
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace mystl {
+
+    // Immutable vector with structural sharing: a 32-way trie of leaves plus a
+    // separately held tail leaf (the layout Clojure's PersistentVector uses).
+    //
+    // push_back usually copies only the tail; once the tail fills it is pushed
+    // into the trie by copying one root-to-leaf path. set and pop_back copy one
+    // path too, so every update is O(log32 n) and leaves the previous version
+    // intact. Copying a persistent_vector is O(1).
+    template <typename T>
+    class persistent_vector {
+    private:
+        static constexpr int bits = 5;
+        static constexpr int width = 1 << bits;
+        static constexpr int mask = width - 1;
+
+        struct Node;
+        using Ptr = std::shared_ptr<const Node>;
+
+        // interior nodes use children, leaves use values
+        struct Node {
+            std::vector<Ptr> children;
+            std::vector<T> values;
+        };
+
+        Ptr root;
+        Ptr tail;
+        int shift = bits;
+        std::size_t count = 0;
+
+        persistent_vector(Ptr root, Ptr tail, int shift, std::size_t count)
+            : root(std::move(root)), tail(std::move(tail)), shift(shift), count(count) {}
+
+        // index of the first element held in the tail
+        std::size_t tailOffset() const {
+            return count < width ? 0 : ((count - 1) >> bits) << bits;
+        }
+
+        const Ptr& leafPtr(std::size_t index) const {
+            if (index >= tailOffset()) return tail;
+            const Ptr* node = &root;
+            for (int level = shift; level > 0; level -= bits)
+                node = &(*node)->children[(index >> level) & mask];
+            return *node;
+        }
+
+        const Node* leafFor(std::size_t index) const {
+            return leafPtr(index).get();
+        }
+
+        // private copy of the tail with room to append without reallocating
+        std::shared_ptr<Node> copyTail() const {
+            auto copy = std::make_shared<Node>();
+            copy->values.reserve(width);
+            copy->values = tail->values;
+            return copy;
+        }
+
+        static Ptr newPath(int level, const Ptr& leaf) {
+            if (level == 0) return leaf;
+            auto node = std::make_shared<Node>();
+            node->children.push_back(newPath(level - bits, leaf));
+            return node;
+        }
+
+        Ptr pushTail(int level, const Ptr& parent, const Ptr& leaf) const {
+            auto copy = std::make_shared<Node>(*parent);
+            size_t index = ((count - 1) >> level) & mask;
+            Ptr insert;
+            if (level == bits)
+                insert = leaf;
+            else if (index < parent->children.size())
+                insert = pushTail(level - bits, parent->children[index], leaf);
+            else
+                insert = newPath(level - bits, leaf);
+
+            if (index < copy->children.size()) copy->children[index] = std::move(insert);
+            else copy->children.push_back(std::move(insert));
+            return copy;
+        }
+
+        // path copy with the rightmost leaf removed; null when the subtree empties
+        Ptr popTail(int level, const Ptr& node) const {
+            size_t index = ((count - 2) >> level) & mask;
+            if (level > bits) {
+                Ptr child = popTail(level - bits, node->children[index]);
+                if (!child && index == 0) return nullptr;
+                auto copy = std::make_shared<Node>(*node);
+                if (child) copy->children[index] = std::move(child);
+                else copy->children.pop_back();
+                return copy;
+            }
+            if (index == 0) return nullptr;
+            auto copy = std::make_shared<Node>(*node);
+            copy->children.pop_back();
+            return copy;
+        }
+
+        static Ptr assoc(int level, const Ptr& node, std::size_t index, const T& val) {
+            auto copy = std::make_shared<Node>(*node);
+            if (level == 0)
+                copy->values[index & mask] = val;
+            else {
+                size_t child = (index >> level) & mask;
+                copy->children[child] = assoc(level - bits, node->children[child], index, val);
+            }
+            return copy;
+        }
+
+        void checkIndex(std::size_t index) const {
+            if (index >= count) throw std::out_of_range("Index out of bounds");
+        }
+
+    public:
+        class iterator {
+        private:
+            const persistent_vector* vec;
+            std::size_t index;
+            std::size_t leafStart;
+            const Node* leaf;
+
+        public:
+            iterator(const persistent_vector* vec, std::size_t index)
+                : vec(vec), index(index), leafStart(index - (index & mask)),
+                  leaf(index < vec->count ? vec->leafFor(index) : nullptr) {}
+
+            const T& operator*() const { return leaf->values[index - leafStart]; }
+            const T* operator->() const { return &**this; }
+
+            // only walks the trie when crossing into the next leaf
+            iterator& operator++() {
+                if (++index - leafStart == width && index < vec->count) {
+                    leafStart = index;
+                    leaf = vec->leafFor(index);
+                }
+                return *this;
+            }
+
+            bool operator==(const iterator& other) const { return index == other.index; }
+            bool operator!=(const iterator& other) const { return index != other.index; }
+        };
+
+        persistent_vector() : root(std::make_shared<Node>()), tail(std::make_shared<Node>()) {}
+
+        persistent_vector(std::initializer_list<T> initList) : persistent_vector() {
+            for (const T& val : initList)
+                *this = push_back(val);
+        }
+
+        // new version with val appended
+        persistent_vector push_back(const T& val) const {
+            if (count - tailOffset() < width) {
+                auto newTail = copyTail();
+                newTail->values.push_back(val);
+                return persistent_vector(root, std::move(newTail), shift, count + 1);
+            }
+
+            Ptr newRoot;
+            int newShift = shift;
+            if ((count >> bits) > (std::size_t(1) << shift)) {
+                auto grown = std::make_shared<Node>();
+                grown->children.push_back(root);
+                grown->children.push_back(newPath(shift, tail));
+                newRoot = std::move(grown);
+                newShift += bits;
+            } else {
+                newRoot = pushTail(shift, root, tail);
+            }
+
+            auto newTail = std::make_shared<Node>();
+            newTail->values.reserve(width);
+            newTail->values.push_back(val);
+            return persistent_vector(std::move(newRoot), std::move(newTail), newShift, count + 1);
+        }
+
+        // new version without the last element
+        persistent_vector pop_back() const {
+            if (count == 0) throw std::runtime_error("persistent_vector Underflow");
+            if (count == 1) return persistent_vector();
+
+            if (count - tailOffset() > 1) {
+                auto newTail = std::make_shared<Node>(*tail);
+                newTail->values.pop_back();
+                return persistent_vector(root, std::move(newTail), shift, count - 1);
+            }
+
+            Ptr newTail = leafPtr(count - 2);
+            Ptr newRoot = popTail(shift, root);
+            int newShift = shift;
+            if (!newRoot) newRoot = std::make_shared<Node>();
+            if (shift > bits && newRoot->children.size() == 1) {
+                newRoot = newRoot->children[0];
+                newShift -= bits;
+            }
+            return persistent_vector(std::move(newRoot), std::move(newTail), newShift, count - 1);
+        }
+
+        // new version with element index replaced by val
+        persistent_vector set(std::size_t index, const T& val) const {
+            checkIndex(index);
+            if (index >= tailOffset()) {
+                auto newTail = std::make_shared<Node>(*tail);
+                newTail->values[index & mask] = val;
+                return persistent_vector(root, std::move(newTail), shift, count);
+            }
+            return persistent_vector(assoc(shift, root, index, val), tail, shift, count);
+        }
+
+        const T& operator[](std::size_t index) const {
+            checkIndex(index);
+            return leafFor(index)->values[index & mask];
+        }
+
+        const T& front() const {
+            if (empty()) throw std::runtime_error("persistent_vector is empty");
+            return (*this)[0];
+        }
+
+        const T& back() const {
+            if (empty()) throw std::runtime_error("persistent_vector is empty");
+            return tail->values.back();
+        }
+
+        std::size_t size() const {
+            return count;
+        }
+
+        bool empty() const {
+            return count == 0;
+        }
+
+        iterator begin() const { return iterator(this, 0); }
+        iterator end() const { return iterator(this, count); }
+    };
+
+}
@@ -1,70 +1,168 @@
-#include <vector>
+#pragma once
+#include <cstddef>
 #include <functional>
+#include <iterator>
 #include <stdexcept>
+#include <utility>
+#include <vector>
 
 namespace mystl {
 
-template <typename T, typename Comparator = std::less<T>>
-class priority_queue {
-private:
-    std::vector<T> pq;
-    Comparator comp;
+// Sifting for a d-ary heap stored in a random-access container, shared by
+// priority_queue and indexed_priority_queue. below(a, b) is true when a
+// belongs below b; settled(element, index) is called each time an element
+// comes to rest at an index, so an addressable heap can track positions.
+//
+// Sifting moves a hole instead of swapping: each level costs one move rather
+// than the three of a std::swap, and the element lands once at the end.
+namespace dary_heap {
+
+struct no_position_hook {
+    template <typename Element>
+    void operator()(const Element&, std::size_t) const {}
+};
 
-    void heapifyUp(int index) {
-        int child = index;
-        int parent = (child - 1) / 2;
-        while (child > 0 && comp(pq[parent], pq[child])) {
-            std::swap(pq[parent], pq[child]);
-            child = parent;
-            parent = (child - 1) / 2;
+template <std::size_t Arity, typename Heap, typename Below, typename Settled>
+void sift_up(Heap& heap, std::size_t index, Below&& below, Settled&& settled) {
+    auto value = std::move(heap[index]);
+    while (index > 0) {
+        std::size_t parent = (index - 1) / Arity;
+        if (!below(heap[parent], value))
+            break;
+        heap[index] = std::move(heap[parent]);
+        settled(heap[index], index);
+        index = parent;
+    }
+    heap[index] = std::move(value);
+    settled(heap[index], index);
+}
+
+template <std::size_t Arity, typename Heap, typename Below, typename Settled>
+void sift_down(Heap& heap, std::size_t index, Below&& below, Settled&& settled) {
+    std::size_t size = heap.size();
+    auto value = std::move(heap[index]);
+
+    while (true) {
+        std::size_t first = Arity * index + 1;
+        if (first >= size)
+            break;
+
+        std::size_t last = first + Arity < size ? first + Arity : size;
+        std::size_t largest = first;
+        for (std::size_t child = first + 1; child < last; child++) {
+            if (below(heap[largest], heap[child]))
+                largest = child;
         }
+
+        if (!below(value, heap[largest]))
+            break;
+
+        heap[index] = std::move(heap[largest]);
+        settled(heap[index], index);
+        index = largest;
     }
+    heap[index] = std::move(value);
+    settled(heap[index], index);
+}
 
-    void heapifyDown(int index) {
-        int parent = index;
-        int size = static_cast<int>(pq.size());
+}
 
-        while (true) {
-            int left = 2 * parent + 1;
-            int right = 2 * parent + 2;
-            int largest = parent;
+// d-ary heap; Arity = 2 is the classic binary heap, 4 or 8 trade a few extra
+// comparisons per level for a shallower tree whose children share a cache line.
+template <typename T, typename Comparator = std::less<T>, std::size_t Arity = 2>
+class priority_queue {
+    static_assert(Arity >= 2, "priority_queue arity must be at least 2");
 
-            if (left < size && comp(pq[largest], pq[left]))
-                largest = left;
+private:
+    std::vector<T> pq;
+    Comparator comp;
 
-            if (right < size && comp(pq[largest], pq[right]))
-                largest = right;
+    void heapifyUp(std::size_t index) {
+        dary_heap::sift_up<Arity>(pq, index, comp, dary_heap::no_position_hook());
+    }
 
-            if (largest == parent)
-                break;
+    void heapifyDown(std::size_t index) {
+        dary_heap::sift_down<Arity>(pq, index, comp, dary_heap::no_position_hook());
+    }
 
-            std::swap(pq[parent], pq[largest]);
-            parent = largest;
-        }
+    // Floyd's bottom-up construction, O(n)
+    void makeHeap() {
+        if (pq.size() < 2)
+            return;
+        for (std::size_t i = (pq.size() - 2) / Arity + 1; i-- > 0;)
+            heapifyDown(i);
     }
 
 public:
     priority_queue() = default;
 
+    explicit priority_queue(const Comparator& comp) : comp(comp) {}
+
+    template <typename InputIterator>
+    priority_queue(InputIterator first, InputIterator last, const Comparator& comp = Comparator())
+        : pq(first, last), comp(comp) {
+        makeHeap();
+    }
+
     void push(const T& element) {
         pq.push_back(element);
-        heapifyUp(static_cast<int>(pq.size()) - 1);
+        heapifyUp(pq.size() - 1);
     }
 
     void push(T&& element) {
         pq.push_back(std::move(element));
-        heapifyUp(static_cast<int>(pq.size()) - 1);
+        heapifyUp(pq.size() - 1);
+    }
+
+    template <typename... Args>
+    void emplace(Args&&... args) {
+        pq.emplace_back(std::forward<Args>(args)...);
+        heapifyUp(pq.size() - 1);
+    }
+
+    // Appends a range. Small batches are sifted in one by one; once the batch is
+    // large relative to the heap it is cheaper to rebuild the whole heap in O(n).
+    template <typename InputIterator>
+    void push_range(InputIterator first, InputIterator last) {
+        std::size_t oldSize = pq.size();
+        pq.insert(pq.end(), first, last);
+        std::size_t added = pq.size() - oldSize;
+
+        if (added > oldSize / 8) {
+            makeHeap();
+        } else {
+            for (std::size_t i = oldSize; i < pq.size(); i++)
+                heapifyUp(i);
+        }
     }
 
     void pop() {
         if (pq.empty())
             throw std::out_of_range("priority_queue is empty");
 
-        pq[0] = pq.back();
-        pq.pop_back();
+        if (pq.size() > 1) {
+            pq[0] = std::move(pq.back());
+            pq.pop_back();
+            heapifyDown(0);
+        } else {
+            pq.pop_back();
+        }
+    }
+
+    // move the top element into out and pop it; false if the queue is empty
+    bool try_pop(T& out) {
+        if (pq.empty())
+            return false;
 
-        if (!pq.empty())
+        out = std::move(pq[0]);
+        if (pq.size() > 1) {
+            pq[0] = std::move(pq.back());
+            pq.pop_back();
             heapifyDown(0);
+        } else {
+            pq.pop_back();
+        }
+        return true;
     }
 
     const T& top() const {
@@ -78,8 +176,20 @@ public:
         return pq.empty();
     }
 
-    int size() const {
-        return static_cast<int>(pq.size());
+    std::size_t size() const {
+        return pq.size();
+    }
+
+    std::size_t max_size() const {
+        return pq.max_size();
+    }
+
+    void reserve(std::size_t capacity) {
+        pq.reserve(capacity);
+    }
+
+    void clear() {
+        pq.clear();
     }
 };
 
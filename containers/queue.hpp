@@ -1,81 +1,97 @@
+#pragma once
 #include <iostream>
+#include <utility>
+#include "circular_buffer.hpp"
 using namespace std;
 
 namespace mystl {
 
-template <typename T>
+// FIFO adaptor over any container offering push_back/emplace_back/pop_front/front/back.
+// Defaults to mystl::circular_buffer so a steady push/pop cycle reuses the same
+// slots instead of allocating a node per element; mystl::deque gives the old
+// linked-node layout.
+template <typename T, typename Container = mystl::circular_buffer<T>>
 class queue {
 private:
-    Node<T>* head;
-    Node<T>* tail;
-    int _size;
+    Container c;
 
 public:
-    queue() : head(nullptr), tail(nullptr), _size(0) {}
+    queue() = default;
 
-    ~queue() {
-        clear();
+    void push(const T& element) {
+        c.push_back(element);
     }
 
-    void push(const T& element) {
-        Node<T>* newNode = new Node<T>(element);
-        if (!head) {
-            head = tail = newNode;
-        } else {
-            tail->next = newNode;
-            tail = newNode;
-        }
-        _size++;
+    void push(T&& element) {
+        c.push_back(std::move(element));
+    }
+
+    template <typename... Args>
+    T& emplace(Args&&... args) {
+        return c.emplace_back(std::forward<Args>(args)...);
     }
 
     void pop() {
         if (empty()) {
             throw runtime_error("Queue Underflow");
         }
-        Node<T>* temp = head;
-        head = head->next;
-        delete temp;
-        _size--;
-        if (!head) tail = nullptr;
+        c.pop_front();
+    }
+
+    // move the front element into out and pop it; false if the queue is empty
+    bool try_pop(T& out) {
+        if (empty()) return false;
+        out = std::move(c.front());
+        c.pop_front();
+        return true;
     }
 
     T& front() {
         if (empty()) {
             throw runtime_error("Queue is empty");
         }
-        return head->data;
+        return c.front();
     }
 
     T& back() {
         if (empty()) {
             throw runtime_error("Queue is empty");
         }
-        return tail->data;
+        return c.back();
     }
 
     const T& front() const {
         if (empty()) {
             throw runtime_error("Queue is empty");
         }
-        return head->data;
+        return c.front();
+    }
+
+    const T& back() const {
+        if (empty()) {
+            throw runtime_error("Queue is empty");
+        }
+        return c.back();
     }
 
     bool empty() const {
-        return _size == 0;
+        return c.empty();
+    }
+
+    size_t size() const {
+        return c.size();
+    }
+
+    size_t max_size() const {
+        return c.max_size();
     }
 
-    int size() const {
-        return _size;
+    void reserve(size_t capacity) {
+        c.reserve(capacity);
     }
 
     void clear() {
-        while (head != nullptr) {
-            Node<T>* temp = head;
-            head = head->next;
-            delete temp;
-        }
-        tail = nullptr;
-        _size = 0;
+        c.clear();
     }
 };
 
@@ -0,0 +1,119 @@
+#pragma once
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mystl {
+
+// Monotone min-heap for unsigned integer keys (timers, Dijkstra with integer
+// weights). Elements live in one bucket per bit of the key: bucket i holds the
+// keys whose highest bit differing from the last extracted minimum is bit i-1.
+// Each element moves to a lower bucket at most once per bit, so push is O(1)
+// and pop is amortized O(log U) without a single key comparison between buckets.
+//
+// Keys must be monotone: a pushed key may not be smaller than the key most
+// recently returned by top() or pop(); violating that throws invalid_argument.
+template <typename Key, typename Value>
+class radix_heap {
+    static_assert(std::is_integral<Key>::value && std::is_unsigned<Key>::value,
+                  "radix_heap keys must be unsigned integers");
+    static_assert(sizeof(Key) <= sizeof(unsigned long long), "radix_heap keys are at most 64 bits");
+
+public:
+    using value_type = std::pair<Key, Value>;
+
+private:
+    static constexpr int kBits = std::numeric_limits<Key>::digits;
+
+    mutable std::vector<value_type> buckets[kBits + 1];
+    mutable Key last = 0;
+    std::size_t count = 0;
+
+    // 1 + index of the highest bit where key differs from last, 0 if equal
+    int bucketIndex(Key key) const {
+        if (key == last) return 0;
+        unsigned long long diff = static_cast<unsigned long long>(key ^ last);
+        return std::numeric_limits<unsigned long long>::digits - __builtin_clzll(diff);
+    }
+
+    // make bucket 0 hold the minimum: find the first non-empty bucket, raise
+    // last to its minimum and spread its elements over the lower buckets
+    void pull() const {
+        if (!buckets[0].empty()) return;
+
+        int i = 1;
+        while (buckets[i].empty())
+            i++;
+
+        Key minKey = buckets[i][0].first;
+        for (const value_type& element : buckets[i]) {
+            if (element.first < minKey) minKey = element.first;
+        }
+        last = minKey;
+
+        for (value_type& element : buckets[i])
+            buckets[bucketIndex(element.first)].push_back(std::move(element));
+        buckets[i].clear();
+    }
+
+public:
+    radix_heap() = default;
+
+    void push(Key key, const Value& value) {
+        emplace(key, value);
+    }
+
+    void push(const value_type& element) {
+        emplace(element.first, element.second);
+    }
+
+    template <typename... Args>
+    void emplace(Key key, Args&&... args) {
+        if (key < last)
+            throw std::invalid_argument("radix_heap key below current minimum");
+        buckets[bucketIndex(key)].emplace_back(std::piecewise_construct, std::forward_as_tuple(key),
+                                               std::forward_as_tuple(std::forward<Args>(args)...));
+        count++;
+    }
+
+    void pop() {
+        if (count == 0)
+            throw std::out_of_range("radix_heap is empty");
+        pull();
+        buckets[0].pop_back();
+        count--;
+    }
+
+    const value_type& top() const {
+        if (count == 0)
+            throw std::out_of_range("radix_heap is empty");
+        pull();
+        return buckets[0].back();
+    }
+
+    Key top_key() const {
+        return top().first;
+    }
+
+    bool empty() const {
+        return count == 0;
+    }
+
+    std::size_t size() const {
+        return count;
+    }
+
+    // also resets the monotone lower bound
+    void clear() {
+        for (auto& bucket : buckets)
+            bucket.clear();
+        last = 0;
+        count = 0;
+    }
+};
+
+}
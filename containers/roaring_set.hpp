@@ -0,0 +1,626 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <istream>
+#include <iterator>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+#include "../utilities/bit_words.hpp"
+
+namespace mystl {
+
+// Compressed set of 32-bit integers in the style of Roaring bitmaps.
+//
+// Values are split by their high 16 bits into chunks covering 65536 values
+// each, and every chunk picks the cheapest of three layouts:
+//   - array:  sorted uint16_t lows, for up to 4096 values (2 bytes per value);
+//   - bitmap: 65536 bits in 1024 words, for denser chunks (8 KB flat);
+//   - run:    sorted [start, start + length] intervals, chosen by
+//             run_optimize() when the chunk is mostly consecutive values.
+// Union, intersection and difference merge chunk by chunk with a kernel per
+// layout pair; bitmap pairs go through the word-parallel kernels of
+// utilities/bit_words.hpp. Run chunks are expanded before being modified.
+class roaring_set {
+private:
+    static constexpr uint32_t arrayMax = 4096;
+    static constexpr size_t bitmapWords = 1024;
+
+    enum class Kind : uint8_t { Array, Bitmap, Run };
+
+    // values start ... start + length, inclusive
+    struct Run {
+        uint16_t start;
+        uint16_t length;
+    };
+
+    struct Chunk {
+        uint16_t key = 0;
+        Kind kind = Kind::Array;
+        uint32_t cardinality = 0;
+        std::vector<uint16_t> array;
+        std::vector<uint64_t> bitmap;
+        std::vector<Run> runs;
+
+        bool contains(uint16_t low) const {
+            switch (kind) {
+            case Kind::Array:
+                return std::binary_search(array.begin(), array.end(), low);
+            case Kind::Bitmap:
+                return (bitmap[low / 64] >> (low % 64)) & 1;
+            case Kind::Run: {
+                auto it = std::upper_bound(runs.begin(), runs.end(), low,
+                                           [](uint16_t v, const Run& r) { return v < r.start; });
+                if (it == runs.begin()) return false;
+                --it;
+                return low - it->start <= it->length;
+            }
+            }
+            return false;
+        }
+
+        bool insert(uint16_t low) {
+            if (kind == Kind::Run) expandRuns();
+            if (kind == Kind::Bitmap) {
+                uint64_t& word = bitmap[low / 64];
+                uint64_t mask = 1ULL << (low % 64);
+                if (word & mask) return false;
+                word |= mask;
+                cardinality++;
+                return true;
+            }
+            auto it = std::lower_bound(array.begin(), array.end(), low);
+            if (it != array.end() && *it == low) return false;
+            array.insert(it, low);
+            cardinality++;
+            if (cardinality > arrayMax) toBitmap();
+            return true;
+        }
+
+        bool erase(uint16_t low) {
+            if (kind == Kind::Run) expandRuns();
+            if (kind == Kind::Bitmap) {
+                uint64_t& word = bitmap[low / 64];
+                uint64_t mask = 1ULL << (low % 64);
+                if (!(word & mask)) return false;
+                word &= ~mask;
+                cardinality--;
+                if (cardinality <= arrayMax) toArray();
+                return true;
+            }
+            auto it = std::lower_bound(array.begin(), array.end(), low);
+            if (it == array.end() || *it != low) return false;
+            array.erase(it);
+            cardinality--;
+            return true;
+        }
+
+        template <typename Fn>
+        void forEach(Fn&& fn) const {
+            switch (kind) {
+            case Kind::Array:
+                for (uint16_t low : array) fn(low);
+                break;
+            case Kind::Bitmap:
+                for (size_t w = 0; w < bitmapWords; w++)
+                    for (uint64_t word = bitmap[w]; word; word &= word - 1)
+                        fn(static_cast<uint16_t>(w * 64 + __builtin_ctzll(word)));
+                break;
+            case Kind::Run:
+                for (const Run& run : runs)
+                    for (uint32_t v = run.start; v <= uint32_t(run.start) + run.length; v++)
+                        fn(static_cast<uint16_t>(v));
+                break;
+            }
+        }
+
+        void toBitmap() {
+            std::vector<uint64_t> words(bitmapWords, 0);
+            forEach([&](uint16_t low) { words[low / 64] |= 1ULL << (low % 64); });
+            bitmap.swap(words);
+            array = std::vector<uint16_t>();
+            runs = std::vector<Run>();
+            kind = Kind::Bitmap;
+        }
+
+        void toArray() {
+            std::vector<uint16_t> values;
+            values.reserve(cardinality);
+            forEach([&](uint16_t low) { values.push_back(low); });
+            array.swap(values);
+            bitmap = std::vector<uint64_t>();
+            runs = std::vector<Run>();
+            kind = Kind::Array;
+        }
+
+        // array or bitmap, whichever the cardinality calls for
+        void expandRuns() {
+            if (cardinality > arrayMax) toBitmap();
+            else toArray();
+        }
+
+        size_t countRuns() const {
+            if (kind == Kind::Run) return runs.size();
+            size_t n = 0;
+            int64_t previous = -2;
+            forEach([&](uint16_t low) {
+                if (low != previous + 1) n++;
+                previous = low;
+            });
+            return n;
+        }
+
+        void toRuns() {
+            std::vector<Run> intervals;
+            forEach([&](uint16_t low) {
+                if (!intervals.empty() && uint32_t(intervals.back().start) + intervals.back().length + 1 == low)
+                    intervals.back().length++;
+                else
+                    intervals.push_back({low, 0});
+            });
+            runs.swap(intervals);
+            array = std::vector<uint16_t>();
+            bitmap = std::vector<uint64_t>();
+            kind = Kind::Run;
+        }
+
+        // payload sorted, non-overlapping and matching the cardinality; used on
+        // deserialized chunks
+        bool valid() const {
+            uint64_t values = 0;
+            switch (kind) {
+            case Kind::Array:
+                for (size_t i = 1; i < array.size(); i++)
+                    if (array[i - 1] >= array[i]) return false;
+                values = array.size();
+                break;
+            case Kind::Bitmap:
+                values = bits::popcount_words(bitmap.data(), bitmapWords);
+                break;
+            case Kind::Run:
+                for (size_t i = 0; i < runs.size(); i++) {
+                    if (uint32_t(runs[i].start) + runs[i].length > 0xFFFF) return false;
+                    if (i > 0 && uint32_t(runs[i - 1].start) + runs[i - 1].length + 1 >= runs[i].start) return false;
+                    values += uint32_t(runs[i].length) + 1;
+                }
+                break;
+            }
+            return values > 0 && values == cardinality;
+        }
+
+        size_t sizeInBytes() const {
+            return array.size() * sizeof(uint16_t) + bitmap.size() * sizeof(uint64_t) + runs.size() * sizeof(Run);
+        }
+
+        // switch to runs when they are smaller than the array or bitmap form
+        void optimize() {
+            if (kind == Kind::Run) return;
+            size_t runBytes = countRuns() * sizeof(Run);
+            size_t flatBytes = cardinality > arrayMax ? bitmapWords * sizeof(uint64_t) : cardinality * sizeof(uint16_t);
+            if (runBytes < flatBytes) toRuns();
+        }
+
+        // bitmap chunks that fell to array size go back to arrays
+        void normalize() {
+            if (kind == Kind::Bitmap) {
+                cardinality = static_cast<uint32_t>(bits::popcount_words(bitmap.data(), bitmapWords));
+                if (cardinality <= arrayMax) toArray();
+            } else if (kind == Kind::Array) {
+                cardinality = static_cast<uint32_t>(array.size());
+            }
+        }
+    };
+
+    // chunk keys are kept apart from the payloads so lookups binary search a
+    // dense uint16_t array and inserting a chunk only shifts keys and pointers
+    std::vector<uint16_t> keys;
+    std::vector<std::unique_ptr<Chunk>> chunks;
+    size_t count = 0;
+
+    static uint16_t high(uint32_t value) { return static_cast<uint16_t>(value >> 16); }
+    static uint16_t low(uint32_t value) { return static_cast<uint16_t>(value & 0xFFFF); }
+
+    size_t chunkIndex(uint16_t key) const {
+        return static_cast<size_t>(std::lower_bound(keys.begin(), keys.end(), key) - keys.begin());
+    }
+
+    void appendChunk(Chunk chunk) {
+        count += chunk.cardinality;
+        keys.push_back(chunk.key);
+        chunks.push_back(std::make_unique<Chunk>(std::move(chunk)));
+    }
+
+    static const Chunk& flat(const Chunk& chunk, Chunk& scratch) {
+        if (chunk.kind != Kind::Run) return chunk;
+        scratch = chunk;
+        scratch.expandRuns();
+        return scratch;
+    }
+
+    static Chunk unionOf(const Chunk& x, const Chunk& y) {
+        Chunk sx, sy;
+        const Chunk& a = flat(x, sx);
+        const Chunk& b = flat(y, sy);
+        Chunk out;
+        out.key = a.key;
+        if (a.kind == Kind::Array && b.kind == Kind::Array) {
+            out.array.resize(a.array.size() + b.array.size());
+            auto end = std::set_union(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(), out.array.begin());
+            out.array.resize(static_cast<size_t>(end - out.array.begin()));
+            out.cardinality = static_cast<uint32_t>(out.array.size());
+            if (out.cardinality > arrayMax) out.toBitmap();
+            return out;
+        }
+        const Chunk& bitmapSide = a.kind == Kind::Bitmap ? a : b;
+        const Chunk& other = a.kind == Kind::Bitmap ? b : a;
+        out.kind = Kind::Bitmap;
+        out.bitmap = bitmapSide.bitmap;
+        if (other.kind == Kind::Bitmap)
+            bits::or_words(out.bitmap.data(), other.bitmap.data(), bitmapWords);
+        else
+            for (uint16_t low : other.array) out.bitmap[low / 64] |= 1ULL << (low % 64);
+        out.normalize();
+        return out;
+    }
+
+    static Chunk intersectionOf(const Chunk& x, const Chunk& y) {
+        Chunk sx, sy;
+        const Chunk& a = flat(x, sx);
+        const Chunk& b = flat(y, sy);
+        Chunk out;
+        out.key = a.key;
+        if (a.kind == Kind::Bitmap && b.kind == Kind::Bitmap) {
+            out.kind = Kind::Bitmap;
+            out.bitmap = a.bitmap;
+            bits::and_words(out.bitmap.data(), b.bitmap.data(), bitmapWords);
+        } else if (a.kind == Kind::Array && b.kind == Kind::Array) {
+            out.array.resize(std::min(a.array.size(), b.array.size()));
+            auto end = std::set_intersection(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(), out.array.begin());
+            out.array.resize(static_cast<size_t>(end - out.array.begin()));
+        } else {
+            const Chunk& arraySide = a.kind == Kind::Array ? a : b;
+            const Chunk& bitmapSide = a.kind == Kind::Array ? b : a;
+            for (uint16_t low : arraySide.array)
+                if ((bitmapSide.bitmap[low / 64] >> (low % 64)) & 1) out.array.push_back(low);
+        }
+        out.normalize();
+        return out;
+    }
+
+    static Chunk differenceOf(const Chunk& x, const Chunk& y) {
+        Chunk sx, sy;
+        const Chunk& a = flat(x, sx);
+        const Chunk& b = flat(y, sy);
+        Chunk out;
+        out.key = a.key;
+        if (a.kind == Kind::Array) {
+            if (b.kind == Kind::Array) {
+                out.array.resize(a.array.size());
+                auto end = std::set_difference(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(), out.array.begin());
+                out.array.resize(static_cast<size_t>(end - out.array.begin()));
+            } else {
+                for (uint16_t low : a.array)
+                    if (!((b.bitmap[low / 64] >> (low % 64)) & 1)) out.array.push_back(low);
+            }
+        } else {
+            out.kind = Kind::Bitmap;
+            out.bitmap = a.bitmap;
+            if (b.kind == Kind::Bitmap)
+                bits::andnot_words(out.bitmap.data(), b.bitmap.data(), bitmapWords);
+            else
+                for (uint16_t low : b.array) out.bitmap[low / 64] &= ~(1ULL << (low % 64));
+        }
+        out.normalize();
+        return out;
+    }
+
+    // merge the chunk lists; op(a, b) combines chunks present in both, and
+    // keepLeft / keepRight say whether chunks found on one side only survive
+    template <typename Op>
+    static roaring_set merge(const roaring_set& left, const roaring_set& right, Op op, bool keepLeft, bool keepRight) {
+        roaring_set result;
+        size_t i = 0, j = 0;
+        auto keep = [&](Chunk chunk) {
+            if (chunk.cardinality > 0) result.appendChunk(std::move(chunk));
+        };
+        while (i < left.keys.size() || j < right.keys.size()) {
+            if (j == right.keys.size() || (i < left.keys.size() && left.keys[i] < right.keys[j])) {
+                if (keepLeft) keep(*left.chunks[i]);
+                i++;
+            } else if (i == left.keys.size() || right.keys[j] < left.keys[i]) {
+                if (keepRight) keep(*right.chunks[j]);
+                j++;
+            } else {
+                keep(op(*left.chunks[i], *right.chunks[j]));
+                i++;
+                j++;
+            }
+        }
+        return result;
+    }
+
+    template <typename T>
+    static void writeRaw(std::ostream& out, const T* data, size_t n) {
+        out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(n * sizeof(T)));
+    }
+
+    template <typename T>
+    static void readRaw(std::istream& in, T* data, size_t n) {
+        in.read(reinterpret_cast<char*>(data), static_cast<std::streamsize>(n * sizeof(T)));
+        if (!in) throw std::runtime_error("roaring_set: truncated input");
+    }
+
+    static constexpr uint32_t serialMagic = 0x314d5352;  // "RSM1"
+
+    struct ChunkHeader {
+        uint16_t key;
+        uint8_t kind;
+        uint8_t reserved;
+        uint32_t cardinality;
+        uint32_t elements;  // array values, bitmap words or runs that follow
+    };
+
+public:
+    class iterator {
+    private:
+        const roaring_set* set;
+        size_t chunk;
+        size_t pos;      // array index, bitmap bit index or run index
+        uint32_t offset; // position inside the current run
+        uint32_t value;
+
+        // settle on the first value at or after (chunk, pos, offset)
+        void settle() {
+            while (chunk < set->chunks.size()) {
+                const Chunk& c = *set->chunks[chunk];
+                uint32_t base = uint32_t(c.key) << 16;
+                if (c.kind == Kind::Array && pos < c.array.size()) {
+                    value = base | c.array[pos];
+                    return;
+                }
+                if (c.kind == Kind::Bitmap) {
+                    size_t next = bits::find_next(c.bitmap.data(), bitmapWords, pos);
+                    if (next != bits::npos) {
+                        pos = next;
+                        value = base | static_cast<uint32_t>(next);
+                        return;
+                    }
+                }
+                if (c.kind == Kind::Run && pos < c.runs.size()) {
+                    value = base | (uint32_t(c.runs[pos].start) + offset);
+                    return;
+                }
+                chunk++;
+                pos = 0;
+                offset = 0;
+            }
+        }
+
+    public:
+        iterator(const roaring_set* set, size_t chunk) : set(set), chunk(chunk), pos(0), offset(0), value(0) {
+            settle();
+        }
+
+        uint32_t operator*() const {
+            return value;
+        }
+
+        iterator& operator++() {
+            const Chunk& c = *set->chunks[chunk];
+            if (c.kind == Kind::Run && offset < c.runs[pos].length) {
+                offset++;
+            } else {
+                pos++;
+                offset = 0;
+            }
+            settle();
+            return *this;
+        }
+
+        iterator operator++(int) {
+            iterator temp = *this;
+            ++(*this);
+            return temp;
+        }
+
+        bool operator==(const iterator& other) const {
+            return chunk == other.chunk && pos == other.pos && offset == other.offset;
+        }
+
+        bool operator!=(const iterator& other) const {
+            return !(*this == other);
+        }
+    };
+
+    roaring_set() = default;
+
+    roaring_set(std::initializer_list<uint32_t> initList) : roaring_set(initList.begin(), initList.end()) {}
+
+    // sorts a copy of the input first, so every chunk is appended at the end
+    template <typename InputIterator>
+    roaring_set(InputIterator first, InputIterator last) {
+        std::vector<uint32_t> values(first, last);
+        std::sort(values.begin(), values.end());
+        for (uint32_t value : values) insert(value);
+    }
+
+    roaring_set(const roaring_set& other) : keys(other.keys), count(other.count) {
+        chunks.reserve(other.chunks.size());
+        for (const auto& chunk : other.chunks) chunks.push_back(std::make_unique<Chunk>(*chunk));
+    }
+
+    roaring_set(roaring_set&& other) noexcept = default;
+
+    roaring_set& operator=(roaring_set other) {
+        keys.swap(other.keys);
+        chunks.swap(other.chunks);
+        std::swap(count, other.count);
+        return *this;
+    }
+
+    bool insert(uint32_t value) {
+        uint16_t key = high(value);
+        size_t i = chunkIndex(key);
+        if (i == keys.size() || keys[i] != key) {
+            keys.insert(keys.begin() + static_cast<std::ptrdiff_t>(i), key);
+            chunks.insert(chunks.begin() + static_cast<std::ptrdiff_t>(i), std::make_unique<Chunk>());
+            chunks[i]->key = key;
+        }
+        bool added = chunks[i]->insert(low(value));
+        if (added) count++;
+        return added;
+    }
+
+    bool erase(uint32_t value) {
+        size_t i = chunkIndex(high(value));
+        if (i == keys.size() || keys[i] != high(value)) return false;
+        if (!chunks[i]->erase(low(value))) return false;
+        count--;
+        if (chunks[i]->cardinality == 0) {
+            keys.erase(keys.begin() + static_cast<std::ptrdiff_t>(i));
+            chunks.erase(chunks.begin() + static_cast<std::ptrdiff_t>(i));
+        }
+        return true;
+    }
+
+    bool contains(uint32_t value) const {
+        size_t i = chunkIndex(high(value));
+        return i < keys.size() && keys[i] == high(value) && chunks[i]->contains(low(value));
+    }
+
+    size_t size() const {
+        return count;
+    }
+
+    bool empty() const {
+        return count == 0;
+    }
+
+    void clear() {
+        keys.clear();
+        chunks.clear();
+        count = 0;
+    }
+
+    // smallest value; the set must not be empty
+    uint32_t min() const {
+        if (empty()) throw std::runtime_error("roaring_set is empty");
+        return *begin();
+    }
+
+    // convert chunks to run layout wherever that is smaller
+    void run_optimize() {
+        for (auto& chunk : chunks) chunk->optimize();
+    }
+
+    // heap bytes held by the chunk payloads and the chunk directory
+    size_t size_in_bytes() const {
+        size_t bytes = keys.capacity() * sizeof(uint16_t) + chunks.capacity() * sizeof(Chunk*);
+        for (const auto& chunk : chunks) bytes += sizeof(Chunk) + chunk->sizeInBytes();
+        return bytes;
+    }
+
+    iterator begin() const { return iterator(this, 0); }
+    iterator end() const { return iterator(this, chunks.size()); }
+
+    friend roaring_set operator|(const roaring_set& a, const roaring_set& b) {
+        return merge(a, b, unionOf, true, true);
+    }
+
+    friend roaring_set operator&(const roaring_set& a, const roaring_set& b) {
+        return merge(a, b, intersectionOf, false, false);
+    }
+
+    friend roaring_set operator-(const roaring_set& a, const roaring_set& b) {
+        return merge(a, b, differenceOf, true, false);
+    }
+
+    roaring_set& operator|=(const roaring_set& other) { return *this = *this | other; }
+    roaring_set& operator&=(const roaring_set& other) { return *this = *this & other; }
+    roaring_set& operator-=(const roaring_set& other) { return *this = *this - other; }
+
+    bool operator==(const roaring_set& other) const {
+        if (count != other.count) return false;
+        for (auto a = begin(), b = other.begin(); a != end(); ++a, ++b)
+            if (*a != *b) return false;
+        return true;
+    }
+
+    bool operator!=(const roaring_set& other) const {
+        return !(*this == other);
+    }
+
+    // Binary layout, host byte order: magic and chunk count, then per chunk a
+    // ChunkHeader followed by its raw payload.
+    void serialize(std::ostream& out) const {
+        uint32_t header[2] = {serialMagic, static_cast<uint32_t>(chunks.size())};
+        writeRaw(out, header, 2);
+        for (const auto& chunkPtr : chunks) {
+            const Chunk& chunk = *chunkPtr;
+            ChunkHeader h{chunk.key, static_cast<uint8_t>(chunk.kind), 0, chunk.cardinality, 0};
+            switch (chunk.kind) {
+            case Kind::Array:
+                h.elements = static_cast<uint32_t>(chunk.array.size());
+                writeRaw(out, &h, 1);
+                writeRaw(out, chunk.array.data(), chunk.array.size());
+                break;
+            case Kind::Bitmap:
+                h.elements = static_cast<uint32_t>(bitmapWords);
+                writeRaw(out, &h, 1);
+                writeRaw(out, chunk.bitmap.data(), bitmapWords);
+                break;
+            case Kind::Run:
+                h.elements = static_cast<uint32_t>(chunk.runs.size());
+                writeRaw(out, &h, 1);
+                writeRaw(out, chunk.runs.data(), chunk.runs.size());
+                break;
+            }
+        }
+    }
+
+    static roaring_set deserialize(std::istream& in) {
+        uint32_t header[2];
+        readRaw(in, header, 2);
+        if (header[0] != serialMagic) throw std::runtime_error("roaring_set: bad magic");
+
+        roaring_set result;
+        for (uint32_t c = 0; c < header[1]; c++) {
+            ChunkHeader h;
+            readRaw(in, &h, 1);
+            Chunk chunk;
+            chunk.key = h.key;
+            chunk.cardinality = h.cardinality;
+            switch (static_cast<Kind>(h.kind)) {
+            case Kind::Array:
+                if (h.elements > arrayMax) throw std::runtime_error("roaring_set: corrupt chunk");
+                chunk.kind = Kind::Array;
+                chunk.array.resize(h.elements);
+                readRaw(in, chunk.array.data(), h.elements);
+                break;
+            case Kind::Bitmap:
+                if (h.elements != bitmapWords) throw std::runtime_error("roaring_set: corrupt chunk");
+                chunk.kind = Kind::Bitmap;
+                chunk.bitmap.resize(bitmapWords);
+                readRaw(in, chunk.bitmap.data(), bitmapWords);
+                break;
+            case Kind::Run:
+                if (h.elements > 32768) throw std::runtime_error("roaring_set: corrupt chunk");
+                chunk.kind = Kind::Run;
+                chunk.runs.resize(h.elements);
+                readRaw(in, chunk.runs.data(), h.elements);
+                break;
+            default:
+                throw std::runtime_error("roaring_set: corrupt chunk");
+            }
+            if (!chunk.valid() || (!result.keys.empty() && result.keys.back() >= chunk.key))
+                throw std::runtime_error("roaring_set: corrupt chunk");
+            result.appendChunk(std::move(chunk));
+        }
+        return result;
+    }
+};
+
+}
@@ -5,6 +5,9 @@
 #include <functional>
 #include <initializer_list>
 #include <stack>
+#include <utility>
+#include "../utilities/capacity.hpp"
+#include "../utilities/serialization.hpp"
 
 namespace mystl {
 
@@ -30,6 +33,8 @@ namespace mystl {
         SetNode<T>* root = nullptr;
         Comp comp;
 
+        friend struct serial::codec<set>;
+
         int height(SetNode<T>* node) {
             return node ? node->height : 0;
         }
@@ -87,6 +92,21 @@ namespace mystl {
             return node;
         }
 
+        // deep copy of a subtree; on a throwing copy the part already built is freed
+        static SetNode<T>* clone(const SetNode<T>* node) {
+            if (!node) return nullptr;
+            SetNode<T>* copy = new SetNode<T>(node->value);
+            try {
+                copy->left = clone(node->left);
+                copy->right = clone(node->right);
+            } catch (...) {
+                delete copy;
+                throw;
+            }
+            copy->height = node->height;
+            return copy;
+        }
+
         SetNode<T>* minValueNode(SetNode<T>* node) {
             SetNode<T>* current = node;
             while (current && current->left)
@@ -184,6 +204,18 @@ namespace mystl {
                 insert(val);
         }
 
+        set(const set& other) : root(clone(other.root)), comp(other.comp) {}
+
+        set(set&& other) noexcept : root(other.root), comp(other.comp) {
+            other.root = nullptr;
+        }
+
+        set& operator=(set other) {
+            std::swap(root, other.root);
+            std::swap(comp, other.comp);
+            return *this;
+        }
+
         ~set() {
             delete root;
         }
@@ -225,4 +257,71 @@ namespace mystl {
         }
     };
 
+    namespace serial {
+
+        template <typename T, typename Comp>
+        struct codec<set<T, Comp>> {
+            static constexpr uint8_t tag = tag_set;
+            using Node = SetNode<T>;
+
+            template <typename Sink>
+            static void write(Sink& sink, const set<T, Comp>& s) {
+                write_count(sink, count(s.root));
+                writeInOrder(sink, s.root);
+            }
+
+            // sorted input, so the tree is built bottom-up in O(n) (see map)
+            template <typename Source>
+            static set<T, Comp> read(Source& source) {
+                std::size_t n = read_count(source, max_elements<Node>());
+                set<T, Comp> s;
+                const T* last = nullptr;
+                s.root = build(source, n, s.comp, last);
+                return s;
+            }
+
+        private:
+            static std::size_t count(const Node* node) {
+                return node ? 1 + count(node->left) + count(node->right) : 0;
+            }
+
+            template <typename Sink>
+            static void writeInOrder(Sink& sink, const Node* node) {
+                if (!node) return;
+                writeInOrder(sink, node->left);
+                write_value(sink, node->value);
+                writeInOrder(sink, node->right);
+            }
+
+            template <typename Source>
+            static Node* build(Source& source, std::size_t n, const Comp& comp, const T*& last) {
+                if (n == 0) return nullptr;
+                Node* left = build(source, n / 2, comp, last);
+                Node* node;
+                try {
+                    T value = read_value<T>(source);
+                    if (last && !comp(*last, value))
+                        throw std::runtime_error("deserialize: set values are not strictly increasing");
+                    node = new Node(std::move(value));
+                } catch (...) {
+                    delete left;
+                    throw;
+                }
+                node->left = left;
+                last = &node->value;
+                try {
+                    node->right = build(source, n - n / 2 - 1, comp, last);
+                } catch (...) {
+                    delete node;
+                    throw;
+                }
+                int leftHeight = left ? left->height : 0;
+                int rightHeight = node->right ? node->right->height : 0;
+                node->height = 1 + std::max(leftHeight, rightHeight);
+                return node;
+            }
+        };
+
+    }
+
 }
@@ -0,0 +1,435 @@
+#pragma once
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iostream>
+#include <new>
+#include <optional>
+#include <thread>
+#include <utility>
+#include "../utilities/epoch.hpp"
+
+namespace mystl {
+
+template <typename K, typename V>
+class SkipNode {
+public:
+    K key;
+    std::atomic<V*> value;
+    std::atomic<bool> marked;
+    std::atomic<bool> fullyLinked;
+    std::atomic<bool> locked;
+    int topLevel;
+
+    // the node is allocated with topLevel forward pointers right behind it
+    std::atomic<SkipNode*>* next() {
+        return reinterpret_cast<std::atomic<SkipNode*>*>(this + 1);
+    }
+
+    static SkipNode* create(const K& key, V* value, int topLevel) {
+        void* memory = ::operator new(sizeof(SkipNode) + topLevel * sizeof(std::atomic<SkipNode*>));
+        SkipNode* node = new (memory) SkipNode(key, value, topLevel);
+        for (int i = 0; i < topLevel; i++)
+            new (&node->next()[i]) std::atomic<SkipNode*>(nullptr);
+        return node;
+    }
+
+    static void destroy(void* p) {
+        SkipNode* node = static_cast<SkipNode*>(p);
+        delete node->value.load(std::memory_order_relaxed);
+        node->~SkipNode();
+        ::operator delete(node);
+    }
+
+    void lock() {
+        while (locked.exchange(true, std::memory_order_acquire))
+            std::this_thread::yield();
+    }
+
+    void unlock() {
+        locked.store(false, std::memory_order_release);
+    }
+
+private:
+    SkipNode(const K& key, V* value, int topLevel)
+        : key(key), value(value), marked(false), fullyLinked(false), locked(false), topLevel(topLevel) {}
+};
+
+// Ordered map on a lazy concurrent skiplist, usable from many threads at once
+// without external locking.
+//
+// Lookups, iteration and range scans never lock or write shared memory: they
+// run inside an epoch_guard and skip nodes that are marked deleted or not yet
+// fully linked. insert and erase lock only the handful of predecessor nodes they
+// splice, so writers on different parts of the key space do not contend.
+// Overwriting an existing key swaps in a freshly allocated value, so a reader
+// never sees a half-written V. Erased nodes and replaced values are freed
+// through epoch-based reclamation.
+template <typename K, typename V, typename Comp = std::less<K>>
+class skiplist_map {
+private:
+    using Node = SkipNode<K, V>;
+    static constexpr int kMaxLevel = 20;
+
+    Node* head;
+    std::atomic<std::size_t> count{0};
+    Comp comp;
+
+    // geometric level distribution with p = 1/4: ~1.33 forward pointers per node
+    static int randomLevel() {
+        thread_local uint64_t seed = std::hash<std::thread::id>()(std::this_thread::get_id()) | 1;
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        int level = 1;
+        uint64_t bits = seed;
+        while (level < kMaxLevel && (bits & 3) == 0) {
+            level++;
+            bits >>= 2;
+        }
+        return level;
+    }
+
+    bool equal(const K& a, const K& b) const {
+        return !comp(a, b) && !comp(b, a);
+    }
+
+    // fill preds/succs around key on every level; returns the highest level at
+    // which key was found, or -1
+    int find(const K& key, Node** preds, Node** succs) const {
+        int found = -1;
+        Node* pred = head;
+        for (int level = kMaxLevel - 1; level >= 0; level--) {
+            Node* curr = pred->next()[level].load(std::memory_order_acquire);
+            while (curr && comp(curr->key, key)) {
+                pred = curr;
+                curr = pred->next()[level].load(std::memory_order_acquire);
+            }
+            if (found == -1 && curr && equal(curr->key, key))
+                found = level;
+            preds[level] = pred;
+            succs[level] = curr;
+        }
+        return found;
+    }
+
+    // first live node not ordered before key
+    Node* lowerBound(const K& key) const {
+        Node* pred = head;
+        Node* curr = nullptr;
+        for (int level = kMaxLevel - 1; level >= 0; level--) {
+            curr = pred->next()[level].load(std::memory_order_acquire);
+            while (curr && comp(curr->key, key)) {
+                pred = curr;
+                curr = pred->next()[level].load(std::memory_order_acquire);
+            }
+        }
+        return skipDead(curr);
+    }
+
+    static Node* skipDead(Node* node) {
+        while (node && (node->marked.load(std::memory_order_acquire) ||
+                        !node->fullyLinked.load(std::memory_order_acquire)))
+            node = node->next()[0].load(std::memory_order_acquire);
+        return node;
+    }
+
+    Node* findLive(const K& key) const {
+        Node* preds[kMaxLevel];
+        Node* succs[kMaxLevel];
+        int found = find(key, preds, succs);
+        if (found == -1) return nullptr;
+        Node* node = succs[found];
+        if (!node->fullyLinked.load(std::memory_order_acquire) || node->marked.load(std::memory_order_acquire))
+            return nullptr;
+        return node;
+    }
+
+    static void unlockPreds(Node** preds, int highestLocked) {
+        Node* prev = nullptr;
+        for (int level = 0; level <= highestLocked; level++) {
+            if (preds[level] != prev) preds[level]->unlock();
+            prev = preds[level];
+        }
+    }
+
+    void replaceValue(Node* node, V* fresh) {
+        V* old = node->value.exchange(fresh, std::memory_order_acq_rel);
+        epoch_retire(old);
+    }
+
+    // insert key if absent; returns the live node holding key. If the key was
+    // present and overwrite is set, its value is replaced with a copy of value.
+    Node* insertNode(const K& key, const V& value, bool overwrite) {
+        epoch_guard guard;
+        int topLevel = randomLevel();
+        Node* preds[kMaxLevel];
+        Node* succs[kMaxLevel];
+
+        while (true) {
+            int found = find(key, preds, succs);
+            if (found != -1) {
+                Node* existing = succs[found];
+                if (!existing->marked.load(std::memory_order_acquire)) {
+                    while (!existing->fullyLinked.load(std::memory_order_acquire))
+                        std::this_thread::yield();
+                    if (overwrite) replaceValue(existing, new V(value));
+                    return existing;
+                }
+                // being erased: retry once it is gone
+                continue;
+            }
+
+            int highestLocked = -1;
+            bool valid = true;
+            Node* prev = nullptr;
+            for (int level = 0; valid && level < topLevel; level++) {
+                Node* pred = preds[level];
+                Node* succ = succs[level];
+                if (pred != prev) {
+                    pred->lock();
+                    prev = pred;
+                }
+                highestLocked = level;
+                valid = !pred->marked.load(std::memory_order_acquire) &&
+                        (!succ || !succ->marked.load(std::memory_order_acquire)) &&
+                        pred->next()[level].load(std::memory_order_acquire) == succ;
+            }
+            if (!valid) {
+                unlockPreds(preds, highestLocked);
+                continue;
+            }
+
+            Node* node = Node::create(key, new V(value), topLevel);
+            for (int level = 0; level < topLevel; level++)
+                node->next()[level].store(succs[level], std::memory_order_relaxed);
+            for (int level = 0; level < topLevel; level++)
+                preds[level]->next()[level].store(node, std::memory_order_release);
+            node->fullyLinked.store(true, std::memory_order_release);
+            unlockPreds(preds, highestLocked);
+            count.fetch_add(1, std::memory_order_relaxed);
+            return node;
+        }
+    }
+
+public:
+    // An iterator on a node keeps its thread pinned to the epoch (as an
+    // epoch_guard does) so the node cannot be freed under it; end() and
+    // default iterators pin nothing, and stepping off the end releases the pin.
+    // The pin belongs to the creating thread: an iterator must be used, copied
+    // and destroyed on that thread, which debug builds assert.
+    class iterator {
+    public:
+        using value_type = std::pair<const K, V>;
+
+    private:
+        Node* node = nullptr;
+        epoch::ThreadState* pinned = nullptr;  // the pinned thread, null if none
+        std::optional<value_type> current;     // what operator-> points at
+
+        static epoch::ThreadState* pin(Node* node) {
+            if (!node) return nullptr;
+            epoch::ThreadState* state = &epoch::threadState();
+            state->pin();
+            return state;
+        }
+
+        static void unpin(epoch::ThreadState* state) {
+            if (!state) return;
+            assert(state == &epoch::threadState() && "skiplist_map iterator used on another thread");
+            state->unpin();
+        }
+
+    public:
+        iterator() = default;
+        explicit iterator(Node* node) : node(node), pinned(pin(node)) {}
+
+        // current holds a const key, so it is rebuilt rather than copied
+        iterator(const iterator& other) : node(other.node), pinned(pin(other.node)) {}
+
+        // pin for the new node before releasing the old pin
+        iterator& operator=(const iterator& other) {
+            if (this != &other) {
+                epoch::ThreadState* old = pinned;
+                node = other.node;
+                pinned = pin(node);
+                current.reset();
+                unpin(old);
+            }
+            return *this;
+        }
+
+        ~iterator() {
+            unpin(pinned);
+        }
+
+        bool operator==(const iterator& other) const { return node == other.node; }
+        bool operator!=(const iterator& other) const { return node != other.node; }
+
+        value_type operator*() const {
+            return { node->key, *node->value.load(std::memory_order_acquire) };
+        }
+
+        // points at a copy: it->second = v would be lost, so it does not compile
+        const value_type* operator->() {
+            current.emplace(node->key, *node->value.load(std::memory_order_acquire));
+            return &*current;
+        }
+
+        iterator& operator++() {
+            node = skipDead(node->next()[0].load(std::memory_order_acquire));
+            if (!node) {
+                unpin(pinned);
+                pinned = nullptr;
+            }
+            return *this;
+        }
+
+        iterator operator++(int) {
+            iterator temp = *this;
+            ++(*this);
+            return temp;
+        }
+    };
+
+    skiplist_map() {
+        head = Node::create(K(), nullptr, kMaxLevel);
+    }
+
+    skiplist_map(std::initializer_list<std::pair<K, V>> initList) : skiplist_map() {
+        for (const auto& item : initList)
+            insert(item.first, item.second);
+    }
+
+    skiplist_map(const skiplist_map&) = delete;
+    skiplist_map& operator=(const skiplist_map&) = delete;
+
+    // must not race with other operations
+    ~skiplist_map() {
+        Node* node = head;
+        while (node) {
+            Node* next = node->next()[0].load(std::memory_order_relaxed);
+            Node::destroy(node);
+            node = next;
+        }
+    }
+
+    // insert or overwrite, like map::insert
+    void insert(K key, V value) {
+        insertNode(key, value, true);
+    }
+
+    // false if the key was not present
+    bool erase(K key) {
+        epoch_guard guard;
+        Node* preds[kMaxLevel];
+        Node* succs[kMaxLevel];
+        Node* victim = nullptr;
+        bool isMarked = false;
+        int topLevel = -1;
+
+        while (true) {
+            int found = find(key, preds, succs);
+            if (found != -1) victim = succs[found];
+
+            if (!isMarked) {
+                if (found == -1 || !victim->fullyLinked.load(std::memory_order_acquire) ||
+                    victim->topLevel - 1 != found || victim->marked.load(std::memory_order_acquire))
+                    return false;
+                topLevel = victim->topLevel;
+                victim->lock();
+                if (victim->marked.load(std::memory_order_acquire)) {
+                    victim->unlock();
+                    return false;
+                }
+                victim->marked.store(true, std::memory_order_release);
+                isMarked = true;
+            }
+
+            int highestLocked = -1;
+            bool valid = true;
+            Node* prev = nullptr;
+            for (int level = 0; valid && level < topLevel; level++) {
+                Node* pred = preds[level];
+                if (pred != prev) {
+                    pred->lock();
+                    prev = pred;
+                }
+                highestLocked = level;
+                valid = !pred->marked.load(std::memory_order_acquire) &&
+                        pred->next()[level].load(std::memory_order_acquire) == victim;
+            }
+            if (!valid) {
+                unlockPreds(preds, highestLocked);
+                continue;
+            }
+
+            for (int level = topLevel - 1; level >= 0; level--)
+                preds[level]->next()[level].store(victim->next()[level].load(std::memory_order_relaxed),
+                                                  std::memory_order_release);
+            victim->unlock();
+            unlockPreds(preds, highestLocked);
+            count.fetch_sub(1, std::memory_order_relaxed);
+            epoch_retire(static_cast<void*>(victim), &Node::destroy);
+            return true;
+        }
+    }
+
+    // Like map::operator[], inserts V() when the key is missing, but returns a
+    // copy: an insert() on another thread swaps the value object out and
+    // retires it, so a reference could dangle. Assign with insert().
+    V operator[](const K& key) {
+        epoch_guard guard;
+        Node* node = insertNode(key, V(), false);
+        return *node->value.load(std::memory_order_acquire);
+    }
+
+    bool contains(const K& key) const {
+        epoch_guard guard;
+        return findLive(key) != nullptr;
+    }
+
+    // copy of the value for key, or V() if absent
+    V getValue(const K& key) const {
+        epoch_guard guard;
+        Node* node = findLive(key);
+        return node ? *node->value.load(std::memory_order_acquire) : V();
+    }
+
+    iterator find(const K& key) const {
+        epoch_guard guard;
+        Node* node = findLive(key);
+        return node ? iterator(node) : end();
+    }
+
+    // first entry whose key is not ordered before key; start of a range scan
+    iterator lower_bound(const K& key) const {
+        epoch_guard guard;
+        return iterator(lowerBound(key));
+    }
+
+    iterator begin() const {
+        epoch_guard guard;
+        return iterator(skipDead(head->next()[0].load(std::memory_order_acquire)));
+    }
+
+    iterator end() const { return iterator(); }
+
+    std::size_t size() const {
+        return count.load(std::memory_order_relaxed);
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    void print() const {
+        for (auto [k, v] : *this) {
+            std::cout << k << " : " << v << std::endl;
+        }
+    }
+};
+
+}
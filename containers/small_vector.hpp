@@ -0,0 +1,384 @@
+#pragma once
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "vector.hpp"
+#include "../utilities/capacity.hpp"
+
+namespace mystl {
+namespace inline_storage {
+
+// Shared body of small_vector and static_vector: a vector whose first N
+// elements live inside the object. With Spill, growing past N moves every
+// element to one heap buffer (and never back); without it, growing past N
+// throws length_error, so the container never allocates.
+//
+// The interface mirrors mystl::vector, including its bounds-check toggle
+// (MYSTL_VECTOR_CHECKS), so either can be swapped in for short vectors.
+template <typename T, std::size_t N, bool Spill>
+class basic_vector {
+public:
+    using value_type = T;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = T*;
+    using const_iterator = const T*;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using difference_type = std::ptrdiff_t;
+
+    static constexpr std::size_t inline_capacity = N;
+
+private:
+    alignas(T) unsigned char local[(N > 0 ? N : 1) * sizeof(T)];
+    T* buffer;
+    std::size_t count;
+    std::size_t capacity;
+
+    T* localData() {
+        return reinterpret_cast<T*>(local);
+    }
+
+    static T* allocate(std::size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+    }
+
+    static void deallocate(T* p) {
+        ::operator delete(p, std::align_val_t(alignof(T)));
+    }
+
+    bool onHeap() const {
+        return Spill && buffer != reinterpret_cast<const T*>(local);
+    }
+
+    // move n live elements from src into uninitialized dst and end their lifetime in src
+    static void relocate(T* dst, T* src, std::size_t n) {
+        if constexpr (std::is_trivially_copyable<T>::value) {
+            if (n) std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), n * sizeof(T));
+        } else {
+            for (std::size_t i = 0; i < n; i++) {
+                new (dst + i) T(std::move_if_noexcept(src[i]));
+                src[i].~T();
+            }
+        }
+    }
+
+    void destroyAll() {
+        if constexpr (!std::is_trivially_destructible<T>::value) {
+            for (std::size_t i = 0; i < count; i++)
+                buffer[i].~T();
+        }
+        count = 0;
+    }
+
+    void releaseHeap() {
+        if (onHeap()) deallocate(buffer);
+        buffer = localData();
+        capacity = N;
+    }
+
+    std::size_t nextCapacity(std::size_t minimum) const {
+        std::size_t next = grown_capacity(capacity, N > 0 ? N : 4, max_size(), "small_vector exceeds max_size");
+        return next < minimum ? minimum : next;
+    }
+
+    void growTo(std::size_t newCapacity) {
+        if (!Spill) throw std::length_error("static_vector capacity exceeded");
+        T* fresh = allocate(newCapacity);
+        relocate(fresh, buffer, count);
+        if (onHeap()) deallocate(buffer);
+        buffer = fresh;
+        capacity = newCapacity;
+    }
+
+    // append when full; the new element is built before the old ones move,
+    // so arguments that refer into this vector stay valid
+    template <typename... Args>
+    T& emplaceGrow(Args&&... args) {
+        if (!Spill) throw std::length_error("static_vector capacity exceeded");
+        std::size_t newCapacity = nextCapacity(count + 1);
+        T* fresh = allocate(newCapacity);
+        try {
+            new (fresh + count) T(std::forward<Args>(args)...);
+        } catch (...) {
+            deallocate(fresh);
+            throw;
+        }
+        relocate(fresh, buffer, count);
+        if (onHeap()) deallocate(buffer);
+        buffer = fresh;
+        capacity = newCapacity;
+        return buffer[count++];
+    }
+
+    void checkIndex(std::size_t index) const {
+#if MYSTL_VECTOR_CHECKS
+        if (index >= count) {
+            throw std::out_of_range("Index out of bounds");
+        }
+#else
+        (void)index;
+#endif
+    }
+
+    void checkNotEmpty(const char* message) const {
+#if MYSTL_VECTOR_CHECKS
+        if (count == 0) {
+            throw std::out_of_range(message);
+        }
+#else
+        (void)message;
+#endif
+    }
+
+    template <typename InputIterator>
+    void appendRange(InputIterator first, InputIterator last) {
+        for (; first != last; ++first)
+            emplace_back(*first);
+    }
+
+public:
+    basic_vector() : buffer(localData()), count(0), capacity(N) {}
+
+    // like mystl::vector(size): room for size elements, none constructed
+    basic_vector(std::size_t size) : basic_vector() {
+        reserve(size);
+    }
+
+    basic_vector(std::size_t size, const T& value) : basic_vector() {
+        reserve(size);
+        for (std::size_t i = 0; i < size; i++)
+            new (buffer + i) T(value);
+        count = size;
+    }
+
+    basic_vector(std::initializer_list<T> init) : basic_vector() {
+        reserve(init.size());
+        appendRange(init.begin(), init.end());
+    }
+
+    template <typename InputIterator,
+              typename = std::enable_if_t<!std::is_integral<InputIterator>::value>>
+    basic_vector(InputIterator first, InputIterator last) : basic_vector() {
+        if constexpr (std::is_base_of<std::forward_iterator_tag,
+                                      typename std::iterator_traits<InputIterator>::iterator_category>::value)
+            reserve(static_cast<std::size_t>(std::distance(first, last)));
+        appendRange(first, last);
+    }
+
+    basic_vector(const basic_vector& other) : basic_vector() {
+        reserve(other.count);
+        if constexpr (std::is_trivially_copyable<T>::value) {
+            if (other.count) std::memcpy(static_cast<void*>(buffer), static_cast<const void*>(other.buffer), other.count * sizeof(T));
+            count = other.count;
+        } else {
+            appendRange(other.begin(), other.end());
+        }
+    }
+
+    // steals a heap buffer; inline elements are moved one by one
+    basic_vector(basic_vector&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+        : basic_vector() {
+        takeFrom(other);
+    }
+
+    basic_vector& operator=(const basic_vector& other) {
+        if (this != &other) {
+            destroyAll();
+            reserve(other.count);
+            appendRange(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    basic_vector& operator=(basic_vector&& other) noexcept(std::is_nothrow_move_constructible<T>::value) {
+        if (this != &other) {
+            destroyAll();
+            releaseHeap();
+            takeFrom(other);
+        }
+        return *this;
+    }
+
+    ~basic_vector() {
+        destroyAll();
+        if (onHeap()) deallocate(buffer);
+    }
+
+    void push_back(const T& element) {
+        emplace_back(element);
+    }
+
+    void push_back(T&& element) {
+        emplace_back(std::move(element));
+    }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (count == capacity)
+            return emplaceGrow(std::forward<Args>(args)...);
+        new (buffer + count) T(std::forward<Args>(args)...);
+        return buffer[count++];
+    }
+
+    // remove last element
+    void pop_back() {
+        if (count == 0) {
+            throw std::out_of_range("pop_back on empty vector");
+        }
+        buffer[--count].~T();
+    }
+
+    T& front() {
+        checkNotEmpty("front on empty vector");
+        return buffer[0];
+    }
+
+    const T& front() const {
+        checkNotEmpty("front on empty vector");
+        return buffer[0];
+    }
+
+    T& back() {
+        checkNotEmpty("back on empty vector");
+        return buffer[count - 1];
+    }
+
+    const T& back() const {
+        checkNotEmpty("back on empty vector");
+        return buffer[count - 1];
+    }
+
+    // make room for at least newCapacity elements without changing size
+    void reserve(std::size_t newCapacity) {
+        if (newCapacity <= capacity) return;
+        check_capacity(newCapacity, max_size(), Spill ? "small_vector reserve exceeds max_size"
+                                                      : "static_vector capacity exceeded");
+        growTo(newCapacity);
+    }
+
+    // destroy all elements; heap capacity is kept
+    void clear() {
+        destroyAll();
+    }
+
+    // replace element at index, or append when index == size()
+    void replace(std::size_t index, T element) {
+        if (index < count) {
+            buffer[index] = std::move(element);
+        } else if (index == count) {
+            push_back(std::move(element));
+        } else {
+            throw std::out_of_range("Index out of bounds for replace");
+        }
+    }
+
+    T get(std::size_t index) const {
+        if (index < count) {
+            return buffer[index];
+        }
+        throw std::out_of_range("Index out of bounds for get");
+    }
+
+    // element access, checked only when MYSTL_VECTOR_CHECKS is on
+    T& operator[](std::size_t index) {
+        checkIndex(index);
+        return buffer[index];
+    }
+
+    const T& operator[](std::size_t index) const {
+        checkIndex(index);
+        return buffer[index];
+    }
+
+    // element access, always checked
+    T& at(std::size_t index) {
+        if (index >= count) {
+            throw std::out_of_range("Index out of bounds for at");
+        }
+        return buffer[index];
+    }
+
+    const T& at(std::size_t index) const {
+        if (index >= count) {
+            throw std::out_of_range("Index out of bounds for at");
+        }
+        return buffer[index];
+    }
+
+    T* data() { return buffer; }
+    const T* data() const { return buffer; }
+
+    iterator begin() { return buffer; }
+    iterator end() { return buffer + count; }
+    const_iterator begin() const { return buffer; }
+    const_iterator end() const { return buffer + count; }
+    const_iterator cbegin() const { return buffer; }
+    const_iterator cend() const { return buffer + count; }
+
+    reverse_iterator rbegin() { return reverse_iterator(end()); }
+    reverse_iterator rend() { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+    std::size_t size() const {
+        return count;
+    }
+
+    std::size_t get_capacity() const {
+        return capacity;
+    }
+
+    static constexpr std::size_t max_size() {
+        return Spill ? max_elements<T>() : N;
+    }
+
+    bool empty() const {
+        return count == 0;
+    }
+
+    // true while the elements still live in the inline buffer
+    bool is_inline() const {
+        return !onHeap();
+    }
+
+private:
+    void takeFrom(basic_vector& other) {
+        if (other.onHeap()) {
+            buffer = other.buffer;
+            capacity = other.capacity;
+            count = other.count;
+            other.buffer = other.localData();
+            other.capacity = N;
+            other.count = 0;
+        } else {
+            relocate(buffer, other.buffer, other.count);
+            count = other.count;
+            other.count = 0;
+        }
+    }
+};
+
+}
+
+// Vector with room for N elements inside the object; only grows onto the heap
+// once it holds more than N. Sized for the common case of a handful of
+// elements per request, where mystl::vector would always allocate.
+template <typename T, std::size_t N>
+class small_vector : public inline_storage::basic_vector<T, N, true> {
+    using base = inline_storage::basic_vector<T, N, true>;
+
+public:
+    using base::base;
+    small_vector() = default;
+    small_vector(std::initializer_list<T> init) : base(init) {}
+};
+
+}
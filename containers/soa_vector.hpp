@@ -0,0 +1,483 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "../utilities/cache_line.hpp"
+#include "../utilities/capacity.hpp"
+#include "../utilities/span.hpp"
+#include "../utilities/tuple.hpp"
+
+namespace mystl {
+
+// One row of a soa_vector: a tuple of references to its fields. Unlike a
+// plain tuple<Ts&...>, assigning to a row writes through to the fields, so
+// sv[i] = sv[j] and *it = value copy values into the row in place.
+template <typename... Ts>
+class soa_row : public tuple<Ts&...> {
+    using base = tuple<Ts&...>;
+
+public:
+    using base::base;
+
+    soa_row(const soa_row&) = default;
+
+    soa_row& operator=(const soa_row& other) {
+        assign(other, std::index_sequence_for<Ts...>{});
+        return *this;
+    }
+
+    // any tuple with one convertible element per field: value_type, const_row,
+    // or a row of another soa_vector
+    template <typename... Us>
+    soa_row& operator=(const tuple<Us...>& other) {
+        static_assert(sizeof...(Us) == sizeof...(Ts), "row assignment needs one value per field");
+        assign(other, std::index_sequence_for<Ts...>{});
+        return *this;
+    }
+
+    template <typename... Us>
+    soa_row& operator=(tuple<Us...>&& other) {
+        static_assert(sizeof...(Us) == sizeof...(Ts), "row assignment needs one value per field");
+        assign(std::move(other), std::index_sequence_for<Ts...>{});
+        return *this;
+    }
+
+    // swaps the fields, not the references
+    friend void swap(soa_row a, soa_row b) {
+        a.swap(b);
+    }
+
+private:
+    template <typename Tuple, std::size_t... I>
+    void assign(Tuple&& other, std::index_sequence<I...>) {
+        ((get<I>(static_cast<base&>(*this)) = get<I>(std::forward<Tuple>(other))), ...);
+    }
+};
+
+// Structure-of-arrays vector: soa_vector<int, double, char> keeps one
+// cache-line-aligned array per field instead of one array of structs, so a
+// loop over a single field streams only that field's bytes.
+//
+// Rows are read and written as soa_row<Ts...>, a mystl::tuple<Ts&...> whose
+// assignment writes through; whole columns are handed out as mystl::span for
+// tight (vectorizable) loops.
+template <typename... Ts>
+class soa_vector {
+    static_assert(sizeof...(Ts) > 0, "soa_vector needs at least one column");
+
+    using indices = std::index_sequence_for<Ts...>;
+
+public:
+    using value_type = tuple<Ts...>;
+    using row = soa_row<Ts...>;
+    using const_row = tuple<const Ts&...>;
+
+    template <std::size_t I>
+    using column_type = typename tuple_type_at<I, Ts...>::type;
+
+    static constexpr std::size_t column_count = sizeof...(Ts);
+    static constexpr std::size_t column_alignment = cache_line_size;
+
+private:
+    tuple<Ts*...> columns;
+    std::size_t _size;
+    std::size_t _capacity;
+
+    template <typename T>
+    static T* allocateColumn(std::size_t count) {
+        return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(column_alignment)));
+    }
+
+    template <typename T>
+    static void freeColumn(T* column) {
+        ::operator delete(column, std::align_val_t(column_alignment));
+    }
+
+    // fresh columns of newCapacity rows; if one allocation fails the ones
+    // already made are released
+    template <std::size_t... I>
+    static tuple<Ts*...> allocateColumns(std::size_t newCapacity, std::index_sequence<I...>) {
+        tuple<Ts*...> fresh(static_cast<Ts*>(nullptr)...);
+        try {
+            ((get<I>(fresh) = allocateColumn<Ts>(newCapacity)), ...);
+        } catch (...) {
+            freeColumns(fresh, indices{});
+            throw;
+        }
+        return fresh;
+    }
+
+    // columns whose elements are copied, not moved, into new storage because
+    // their move constructor may throw
+    template <typename T>
+    static constexpr bool copiedOnRelocate = !std::is_trivially_copyable<T>::value &&
+                                             !std::is_nothrow_move_constructible<T>::value &&
+                                             std::is_copy_constructible<T>::value;
+
+    template <typename T>
+    static void copyForRelocate(T* fresh, const T* column, std::size_t count) {
+        if constexpr (copiedOnRelocate<T>) copyColumn(fresh, column, count);
+    }
+
+    // finish one column: move (or memcpy) what was not copied, then drop the
+    // old elements and array
+    template <typename T>
+    void relocateColumn(T* fresh, T* column) {
+        if constexpr (copiedOnRelocate<T>) {
+            destroyColumn(column, 0, _size);
+        } else if constexpr (std::is_trivially_copyable<T>::value) {
+            if (_size) std::memcpy(fresh, column, _size * sizeof(T));
+        } else {
+            for (std::size_t i = 0; i < _size; i++) {
+                new (fresh + i) T(std::move(column[i]));
+                column[i].~T();
+            }
+        }
+        freeColumn(column);
+    }
+
+    // Move every live row into fresh, all or nothing. The copied columns go
+    // first and leave the old elements alone, so if a copy throws only fresh
+    // is unwound and the vector is unchanged; the rest cannot throw (short of
+    // a move-only type with a throwing move, which gets the basic guarantee,
+    // as in std::vector). The caller still owns fresh on a throw.
+    template <std::size_t... I>
+    void adoptColumns(const tuple<Ts*...>& fresh, std::size_t newCapacity, std::index_sequence<I...>) {
+        std::size_t copied = 0;
+        try {
+            ((copyForRelocate(get<I>(fresh), get<I>(columns), _size), copied++), ...);
+        } catch (...) {
+            ((I < copied && copiedOnRelocate<Ts> ? destroyColumn(get<I>(fresh), 0, _size) : void()), ...);
+            throw;
+        }
+        (relocateColumn(get<I>(fresh), get<I>(columns)), ...);
+        columns = fresh;
+        _capacity = newCapacity;
+    }
+
+    void grow(std::size_t newCapacity) {
+        tuple<Ts*...> fresh = allocateColumns(newCapacity, indices{});
+        try {
+            adoptColumns(fresh, newCapacity, indices{});
+        } catch (...) {
+            freeColumns(fresh, indices{});
+            throw;
+        }
+    }
+
+    // doubling growth that stops at max_size() instead of overflowing
+    std::size_t nextCapacity() const {
+        return grown_capacity(_capacity, 16, max_size(), "soa_vector exceeds max_size");
+    }
+
+    // full: build the new row in the next columns before the old ones move,
+    // since args may refer to fields of a row (sv.emplace_back(get<0>(sv[0]), ...))
+    template <typename... Args>
+    void emplaceGrow(Args&&... args) {
+        std::size_t newCapacity = nextCapacity();
+        tuple<Ts*...> fresh = allocateColumns(newCapacity, indices{});
+        try {
+            constructRow(fresh, _size, indices{}, std::forward<Args>(args)...);
+        } catch (...) {
+            freeColumns(fresh, indices{});
+            throw;
+        }
+        try {
+            adoptColumns(fresh, newCapacity, indices{});
+        } catch (...) {
+            destroyRows(fresh, _size, _size + 1, indices{});
+            freeColumns(fresh, indices{});
+            throw;
+        }
+    }
+
+    template <typename... Args>
+    void emplaceRow(Args&&... args) {
+        if (_size == _capacity)
+            emplaceGrow(std::forward<Args>(args)...);
+        else
+            constructRow(columns, _size, indices{}, std::forward<Args>(args)...);
+        _size++;
+    }
+
+    template <typename T>
+    static void destroyColumn(T* column, std::size_t from, std::size_t to) {
+        if constexpr (!std::is_trivially_destructible<T>::value) {
+            for (std::size_t i = from; i < to; i++)
+                column[i].~T();
+        }
+    }
+
+    template <std::size_t... I>
+    static void destroyRows(const tuple<Ts*...>& target, std::size_t from, std::size_t to,
+                            std::index_sequence<I...>) {
+        (destroyColumn(get<I>(target), from, to), ...);
+    }
+
+    template <std::size_t... I>
+    static void freeColumns(const tuple<Ts*...>& target, std::index_sequence<I...>) {
+        (freeColumn(get<I>(target)), ...);
+    }
+
+    // construct row index of target, one argument per column; if a field's
+    // constructor throws, the fields already built are destroyed
+    template <std::size_t... I, typename... Args>
+    void constructRow(const tuple<Ts*...>& target, std::size_t index, std::index_sequence<I...>, Args&&... args) {
+        std::size_t built = 0;
+        try {
+            ((new (get<I>(target) + index) Ts(std::forward<Args>(args)), built++), ...);
+        } catch (...) {
+            ((I < built ? destroyColumn(get<I>(target), index, index + 1) : void()), ...);
+            throw;
+        }
+    }
+
+    // if a copy throws, the columns already copied are destroyed again
+    template <std::size_t... I>
+    void copyColumns(const soa_vector& other, std::index_sequence<I...>) {
+        std::size_t copied = 0;
+        try {
+            ((copyColumn(get<I>(columns), get<I>(other.columns), other._size), copied++), ...);
+        } catch (...) {
+            ((I < copied ? destroyColumn(get<I>(columns), 0, other._size) : void()), ...);
+            throw;
+        }
+    }
+
+    // copy-construct count elements into dst, unwinding them on a throw
+    template <typename T>
+    static void copyColumn(T* dst, const T* src, std::size_t count) {
+        if constexpr (std::is_trivially_copyable<T>::value) {
+            if (count) std::memcpy(dst, src, count * sizeof(T));
+        } else {
+            std::size_t i = 0;
+            try {
+                for (; i < count; i++)
+                    new (dst + i) T(src[i]);
+            } catch (...) {
+                destroyColumn(dst, 0, i);
+                throw;
+            }
+        }
+    }
+
+    template <std::size_t... I>
+    row rowAt(std::size_t index, std::index_sequence<I...>) {
+        return row(get<I>(columns)[index]...);
+    }
+
+    template <std::size_t... I>
+    const_row rowAt(std::size_t index, std::index_sequence<I...>) const {
+        return const_row(get<I>(columns)[index]...);
+    }
+
+    void checkIndex(std::size_t index) const {
+        if (index >= _size) throw std::out_of_range("Index out of bounds");
+    }
+
+    // Iterator over rows; dereferencing yields a tuple of references
+    template <bool Const>
+    class row_iterator {
+        using owner_type = std::conditional_t<Const, const soa_vector, soa_vector>;
+
+        owner_type* owner;
+        std::size_t index;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = soa_vector::value_type;
+        using reference = std::conditional_t<Const, const_row, row>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+
+        row_iterator(owner_type* owner, std::size_t index) : owner(owner), index(index) {}
+
+        reference operator*() const {
+            return owner->rowAt(index, indices{});
+        }
+
+        row_iterator& operator++() {
+            index++;
+            return *this;
+        }
+
+        row_iterator operator++(int) {
+            row_iterator old = *this;
+            index++;
+            return old;
+        }
+
+        bool operator==(const row_iterator& other) const {
+            return index == other.index && owner == other.owner;
+        }
+
+        bool operator!=(const row_iterator& other) const {
+            return !(*this == other);
+        }
+    };
+
+public:
+    using iterator = row_iterator<false>;
+    using const_iterator = row_iterator<true>;
+
+    soa_vector() : columns(static_cast<Ts*>(nullptr)...), _size(0), _capacity(0) {}
+
+    soa_vector(const soa_vector& other) : soa_vector() {
+        reserve(other._size);
+        copyColumns(other, indices{});
+        _size = other._size;
+    }
+
+    soa_vector(soa_vector&& other) noexcept
+        : columns(other.columns), _size(other._size), _capacity(other._capacity) {
+        other.columns = tuple<Ts*...>(static_cast<Ts*>(nullptr)...);
+        other._size = other._capacity = 0;
+    }
+
+    soa_vector& operator=(soa_vector other) {
+        swap(other);
+        return *this;
+    }
+
+    ~soa_vector() {
+        clear();
+        freeColumns(columns, indices{});
+    }
+
+    void swap(soa_vector& other) noexcept {
+        std::swap(columns, other.columns);
+        std::swap(_size, other._size);
+        std::swap(_capacity, other._capacity);
+    }
+
+    void push_back(const value_type& value) {
+        pushTuple(value, indices{});
+    }
+
+    void push_back(value_type&& value) {
+        pushTuple(std::move(value), indices{});
+    }
+
+    // construct a row in place from one argument per column
+    template <typename... Args>
+    row emplace_back(Args&&... args) {
+        static_assert(sizeof...(Args) == sizeof...(Ts), "emplace_back takes one argument per column");
+        emplaceRow(std::forward<Args>(args)...);
+        return rowAt(_size - 1, indices{});
+    }
+
+    void pop_back() {
+        if (_size == 0) throw std::out_of_range("pop_back on empty soa_vector");
+        destroyRows(columns, _size - 1, _size, indices{});
+        _size--;
+    }
+
+    row operator[](std::size_t index) {
+        checkIndex(index);
+        return rowAt(index, indices{});
+    }
+
+    const_row operator[](std::size_t index) const {
+        checkIndex(index);
+        return rowAt(index, indices{});
+    }
+
+    row back() {
+        if (_size == 0) throw std::out_of_range("back on empty soa_vector");
+        return rowAt(_size - 1, indices{});
+    }
+
+    const_row back() const {
+        if (_size == 0) throw std::out_of_range("back on empty soa_vector");
+        return rowAt(_size - 1, indices{});
+    }
+
+    // the I-th field of every row as one contiguous, column_alignment-aligned array
+    template <std::size_t I>
+    span<column_type<I>> column() {
+        return span<column_type<I>>(get<I>(columns), _size);
+    }
+
+    template <std::size_t I>
+    span<const column_type<I>> column() const {
+        return span<const column_type<I>>(get<I>(columns), _size);
+    }
+
+    // make room for at least newCapacity rows without changing size
+    void reserve(std::size_t newCapacity) {
+        check_capacity(newCapacity, max_size(), "soa_vector reserve exceeds max_size");
+        if (newCapacity > _capacity)
+            grow(newCapacity);
+    }
+
+    // destroy all rows, keeping the allocated columns
+    void clear() {
+        destroyRows(columns, 0, _size, indices{});
+        _size = 0;
+    }
+
+    std::size_t size() const {
+        return _size;
+    }
+
+    std::size_t capacity() const {
+        return _capacity;
+    }
+
+    // bounded by the widest column
+    static constexpr std::size_t max_size() {
+        return std::min({max_elements<Ts>()...});
+    }
+
+    bool empty() const {
+        return _size == 0;
+    }
+
+    iterator begin() {
+        return iterator(this, 0);
+    }
+
+    iterator end() {
+        return iterator(this, _size);
+    }
+
+    const_iterator begin() const {
+        return const_iterator(this, 0);
+    }
+
+    const_iterator end() const {
+        return const_iterator(this, _size);
+    }
+
+private:
+    template <typename Tuple, std::size_t... I>
+    void pushTuple(Tuple&& value, std::index_sequence<I...>) {
+        emplaceRow(get<I>(std::forward<Tuple>(value))...);
+    }
+};
+
+template <typename... Ts>
+void swap(soa_vector<Ts...>& a, soa_vector<Ts...>& b) noexcept {
+    a.swap(b);
+}
+
+}
+
+// rows decompose like the tuple they extend: auto [id, price] = sv[i];
+namespace std {
+
+template <typename... Ts>
+struct tuple_size<mystl::soa_row<Ts...>>
+    : std::integral_constant<std::size_t, sizeof...(Ts)> {};
+
+template <std::size_t N, typename... Ts>
+struct tuple_element<N, mystl::soa_row<Ts...>> {
+    using type = typename mystl::tuple_type_at<N, Ts&...>::type;
+};
+
+}
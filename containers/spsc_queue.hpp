@@ -0,0 +1,157 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include "../utilities/cache_line.hpp"
+
+namespace mystl {
+
+// Bounded wait-free ring for exactly one producer thread and one consumer thread.
+// Each side owns its index on its own cache line and keeps a cached copy of the
+// other side's index, so the shared line is only re-read when the ring looks
+// full (producer) or empty (consumer).
+template <typename T>
+class spsc_queue {
+private:
+    T* slots;
+    size_t mask;
+
+    // consumer-owned
+    alignas(cache_line_size) std::atomic<size_t> head;
+    size_t tailCache;
+
+    // producer-owned
+    alignas(cache_line_size) std::atomic<size_t> tail;
+    size_t headCache;
+
+    char padding[cache_line_size - sizeof(std::atomic<size_t>) - sizeof(size_t)];
+
+    static size_t roundUpPow2(size_t n) {
+        size_t cap = 1;
+        while (cap < n) cap <<= 1;
+        return cap;
+    }
+
+    // producer side: free slots, refreshing the cached head only when needed
+    size_t freeSlots(size_t t, size_t wanted) {
+        size_t available = capacity() - (t - headCache);
+        if (available < wanted) {
+            headCache = head.load(std::memory_order_acquire);
+            available = capacity() - (t - headCache);
+        }
+        return available;
+    }
+
+    // consumer side: filled slots, refreshing the cached tail only when needed
+    size_t filledSlots(size_t h, size_t wanted) {
+        size_t available = tailCache - h;
+        if (available < wanted) {
+            tailCache = tail.load(std::memory_order_acquire);
+            available = tailCache - h;
+        }
+        return available;
+    }
+
+public:
+    // capacity is rounded up to a power of two
+    explicit spsc_queue(size_t capacity)
+        : mask(roundUpPow2(capacity < 2 ? 2 : capacity) - 1), head(0), tailCache(0), tail(0), headCache(0) {
+        slots = static_cast<T*>(::operator new(sizeof(T) * (mask + 1)));
+    }
+
+    spsc_queue(const spsc_queue&) = delete;
+    spsc_queue& operator=(const spsc_queue&) = delete;
+
+    ~spsc_queue() {
+        size_t h = head.load(std::memory_order_relaxed);
+        size_t t = tail.load(std::memory_order_relaxed);
+        for (; h != t; h++)
+            slots[h & mask].~T();
+        ::operator delete(slots);
+    }
+
+    // producer only
+    template <typename... Args>
+    bool try_emplace(Args&&... args) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (freeSlots(t, 1) == 0) return false;
+        new (slots + (t & mask)) T(std::forward<Args>(args)...);
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_push(const T& element) {
+        return try_emplace(element);
+    }
+
+    bool try_push(T&& element) {
+        return try_emplace(std::move(element));
+    }
+
+    // producer only: copies up to count items, publishing them with a single store;
+    // returns how many were pushed
+    size_t try_push_batch(const T* items, size_t count) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        size_t available = freeSlots(t, count);
+        size_t n = count < available ? count : available;
+        for (size_t i = 0; i < n; i++)
+            new (slots + ((t + i) & mask)) T(items[i]);
+        if (n) tail.store(t + n, std::memory_order_release);
+        return n;
+    }
+
+    // consumer only
+    bool try_pop(T& out) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (filledSlots(h, 1) == 0) return false;
+        T& slot = slots[h & mask];
+        out = std::move(slot);
+        slot.~T();
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // consumer only: moves up to maxCount items into out, releasing the slots with a
+    // single store; returns how many were popped
+    size_t try_pop_batch(T* out, size_t maxCount) {
+        size_t h = head.load(std::memory_order_relaxed);
+        size_t available = filledSlots(h, maxCount);
+        size_t n = maxCount < available ? maxCount : available;
+        for (size_t i = 0; i < n; i++) {
+            T& slot = slots[(h + i) & mask];
+            out[i] = std::move(slot);
+            slot.~T();
+        }
+        if (n) head.store(h + n, std::memory_order_release);
+        return n;
+    }
+
+    // consumer only: pointer to the next element or nullptr if empty
+    T* front() {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (filledSlots(h, 1) == 0) return nullptr;
+        return slots + (h & mask);
+    }
+
+    // approximate when called while the other side is active. head is read
+    // first: head never passes tail and tail only grows, so t - h cannot
+    // wrap; the producer may push between the two loads, hence the clamp
+    size_t size() const {
+        size_t h = head.load(std::memory_order_acquire);
+        size_t t = tail.load(std::memory_order_acquire);
+        size_t n = t - h;
+        return n > mask + 1 ? mask + 1 : n;
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    size_t capacity() const {
+        return mask + 1;
+    }
+};
+
+}
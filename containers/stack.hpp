@@ -1,76 +1,82 @@
+#pragma once
 #include <iostream>
+#include <utility>
+#include "vector.hpp"
 using namespace std;
 
 namespace mystl {
 
-template <typename T>
-class Node {
-public:
-    T data;
-    Node<T>* next;
-
-    Node(T data) : data(data), next(nullptr) {}
-};
-
-template <typename T>
+// LIFO adaptor over any container offering push_back/emplace_back/pop_back/back.
+// Defaults to the contiguous mystl::vector so push/pop never touch the allocator
+// once capacity has been reached; mystl::deque gives the old linked-node layout.
+template <typename T, typename Container = mystl::vector<T>>
 class stack {
 private:
-    Node<T>* head;
-    int _size;
+    Container c;
 
 public:
-    stack() : head(nullptr), _size(0) {}
+    stack() = default;
 
-    ~stack() {
-        clear();
+    void push(const T& element) {
+        c.push_back(element);
     }
 
-    void push(const T& element) {
-        Node<T>* newNode = new Node<T>(element);
-        newNode->next = head;
-        head = newNode;
-        _size++;
+    void push(T&& element) {
+        c.push_back(std::move(element));
+    }
+
+    template <typename... Args>
+    T& emplace(Args&&... args) {
+        return c.emplace_back(std::forward<Args>(args)...);
     }
 
     void pop() {
         if (empty()) {
             throw runtime_error("Stack Underflow");
         }
-        Node<T>* temp = head;
-        head = head->next;
-        delete temp;
-        _size--;
+        c.pop_back();
+    }
+
+    // move the top element into out and pop it; false if the stack is empty
+    bool try_pop(T& out) {
+        if (empty()) return false;
+        out = std::move(c.back());
+        c.pop_back();
+        return true;
     }
 
     T& top() {
         if (empty()) {
             throw runtime_error("Stack is empty");
         }
-        return head->data;
+        return c.back();
     }
 
     const T& top() const {
         if (empty()) {
             throw runtime_error("Stack is empty");
         }
-        return head->data;
+        return c.back();
     }
 
     bool empty() const {
-        return _size == 0;
+        return c.empty();
+    }
+
+    size_t size() const {
+        return c.size();
     }
 
-    int size() const {
-        return _size;
+    size_t max_size() const {
+        return c.max_size();
+    }
+
+    void reserve(size_t capacity) {
+        c.reserve(capacity);
     }
 
     void clear() {
-        while (head != nullptr) {
-            Node<T>* temp = head;
-            head = head->next;
-            delete temp;
-        }
-        _size = 0;
+        c.clear();
     }
 };
 
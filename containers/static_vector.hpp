@@ -0,0 +1,20 @@
+#pragma once
+#include "small_vector.hpp"
+
+namespace mystl {
+
+// Fixed-capacity vector that never allocates: all N slots live inside the
+// object, and pushing past N throws length_error. Same interface as
+// mystl::vector and small_vector.
+template <typename T, std::size_t N>
+class static_vector : public inline_storage::basic_vector<T, N, false> {
+    static_assert(N > 0, "static_vector needs a capacity of at least one");
+    using base = inline_storage::basic_vector<T, N, false>;
+
+public:
+    using base::base;
+    static_vector() = default;
+    static_vector(std::initializer_list<T> init) : base(init) {}
+};
+
+}
@@ -1,6 +1,8 @@
 #pragma once
 #include <cstring>
 #include <iostream>
+#include "../utilities/capacity.hpp"
+#include "../utilities/serialization.hpp"
 
 namespace mystl {
 
@@ -9,6 +11,8 @@ private:
     char* data;
     size_t len;
 
+    friend struct serial::codec<string>;
+
 public:
     string() : data(new char[1]{'\0'}), len(0) {}
 
@@ -134,4 +138,32 @@ public:
     }
 };
 
+namespace serial {
+
+template <>
+struct codec<string> {
+    static constexpr uint8_t tag = tag_string;
+
+    template <typename Sink>
+    static void write(Sink& sink, const string& s) {
+        write_count(sink, s.len);
+        if (s.len) sink.write(s.data, s.len);
+    }
+
+    template <typename Source>
+    static string read(Source& source) {
+        size_t n = read_count(source, max_elements<char>() - 1);
+        string s;
+        char* chars = new char[n + 1];
+        delete[] s.data;
+        s.data = chars;
+        source.read(chars, n);
+        chars[n] = '\0';
+        s.len = n;
+        return s;
+    }
+};
+
+}
+
 }
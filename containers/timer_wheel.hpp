@@ -0,0 +1,242 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+#include "priority_queue.hpp"
+
+namespace mystl {
+
+// Hierarchical timing wheel for large numbers of short-lived timeouts.
+//
+// Four wheels of 256 slots cover deadlines up to 2^32 ticks ahead; a timer sits
+// on the wheel of the highest byte in which its deadline differs from the
+// current time and cascades one wheel down each time the clock reaches its
+// slot. schedule() and cancel() are O(1): timers live in a slab and are linked
+// into their slot through indices. Deadlines further out than the wheels reach
+// wait in an overflow mystl::priority_queue until they come into range.
+//
+// advance(now) moves the clock forward and collects every timer due by then.
+// Stretches where the lower wheels are empty are skipped rather than ticked.
+template <typename T>
+class timer_wheel {
+public:
+    using timer_id = uint64_t;
+
+private:
+    static constexpr int kLevels = 4;
+    static constexpr int kSlotBits = 8;
+    static constexpr uint32_t kSlots = 1u << kSlotBits;
+    static constexpr uint32_t kNil = UINT32_MAX;
+    static constexpr uint8_t kFree = 0xFF;
+    static constexpr uint8_t kOverflow = kLevels;
+
+    struct Timer {
+        uint64_t deadline = 0;
+        T payload{};
+        uint32_t prev = kNil;
+        uint32_t next = kNil;
+        uint32_t generation = 0;
+        uint16_t slot = 0;
+        uint8_t level = kFree;
+    };
+
+    using OverflowEntry = std::pair<uint64_t, timer_id>;
+
+    std::vector<Timer> timers;
+    std::vector<uint32_t> freeList;
+    uint32_t heads[kLevels][kSlots];
+    std::size_t levelCount[kLevels] = {};
+    mystl::priority_queue<OverflowEntry, std::greater<OverflowEntry>> overflow;
+    uint64_t current;
+    std::size_t active = 0;
+
+    static timer_id makeId(uint32_t index, uint32_t generation) {
+        return (static_cast<uint64_t>(generation) << 32) | index;
+    }
+
+    static uint32_t slotOf(uint64_t deadline, int level) {
+        return static_cast<uint32_t>(deadline >> (kSlotBits * level)) & (kSlots - 1);
+    }
+
+    // wheel for a deadline: the highest byte in which it differs from the clock
+    static int levelFor(uint64_t deadline, uint64_t now) {
+        uint64_t diff = deadline ^ now;
+        int level = 0;
+        while (level < kLevels && (diff >> (kSlotBits * (level + 1))) != 0)
+            level++;
+        return level;
+    }
+
+    void link(uint32_t index) {
+        Timer& t = timers[index];
+        uint64_t deadline = t.deadline < current ? current : t.deadline;
+        int level = levelFor(deadline, current);
+        if (level == kLevels) {
+            t.level = kOverflow;
+            overflow.push({t.deadline, makeId(index, t.generation)});
+            return;
+        }
+        uint32_t slot = slotOf(deadline, level);
+        t.level = static_cast<uint8_t>(level);
+        t.slot = static_cast<uint16_t>(slot);
+        t.prev = kNil;
+        t.next = heads[level][slot];
+        if (t.next != kNil) timers[t.next].prev = index;
+        heads[level][slot] = index;
+        levelCount[level]++;
+    }
+
+    void unlink(uint32_t index) {
+        Timer& t = timers[index];
+        if (t.level < kLevels) {
+            if (t.prev != kNil)
+                timers[t.prev].next = t.next;
+            else
+                heads[t.level][t.slot] = t.next;
+            if (t.next != kNil) timers[t.next].prev = t.prev;
+            levelCount[t.level]--;
+        }
+        // overflow entries are dropped lazily: the generation no longer matches
+    }
+
+    void release(uint32_t index) {
+        Timer& t = timers[index];
+        t.level = kFree;
+        t.generation++;
+        t.payload = T();
+        freeList.push_back(index);
+        active--;
+    }
+
+    // detach a whole slot and re-link its timers against the current clock
+    void cascade(int level, uint32_t slot) {
+        uint32_t index = heads[level][slot];
+        heads[level][slot] = kNil;
+        while (index != kNil) {
+            uint32_t next = timers[index].next;
+            levelCount[level]--;
+            link(index);
+            index = next;
+        }
+    }
+
+    // move overflow timers that are now within reach of the wheels
+    void drainOverflow() {
+        while (!overflow.empty()) {
+            const OverflowEntry& top = overflow.top();
+            uint32_t index = static_cast<uint32_t>(top.second);
+            uint32_t generation = static_cast<uint32_t>(top.second >> 32);
+            if (timers[index].generation != generation || timers[index].level != kOverflow) {
+                overflow.pop();
+                continue;
+            }
+            if (levelFor(top.first, current) == kLevels) break;
+            overflow.pop();
+            link(index);
+        }
+    }
+
+    void expireSlot(uint32_t slot, std::vector<T>& out) {
+        uint32_t index = heads[0][slot];
+        heads[0][slot] = kNil;
+        while (index != kNil) {
+            uint32_t next = timers[index].next;
+            levelCount[0]--;
+            out.push_back(std::move(timers[index].payload));
+            release(index);
+            index = next;
+        }
+    }
+
+public:
+    explicit timer_wheel(uint64_t start = 0) : current(start) {
+        for (auto& level : heads)
+            for (auto& head : level)
+                head = kNil;
+    }
+
+    // fire payload once the clock reaches deadline; deadlines in the past fire on
+    // the next advance()
+    timer_id schedule(uint64_t deadline, T payload) {
+        uint32_t index;
+        if (!freeList.empty()) {
+            index = freeList.back();
+            freeList.pop_back();
+        } else {
+            index = static_cast<uint32_t>(timers.size());
+            timers.emplace_back();
+        }
+        Timer& t = timers[index];
+        t.deadline = deadline;
+        t.payload = std::move(payload);
+        active++;
+        link(index);
+        return makeId(index, t.generation);
+    }
+
+    // false if the timer already fired or was cancelled
+    bool cancel(timer_id id) {
+        uint32_t index = static_cast<uint32_t>(id);
+        uint32_t generation = static_cast<uint32_t>(id >> 32);
+        if (index >= timers.size() || timers[index].generation != generation || timers[index].level == kFree)
+            return false;
+        unlink(index);
+        release(index);
+        return true;
+    }
+
+    // move the clock to now and append the payload of every due timer to out
+    void advance(uint64_t now, std::vector<T>& out) {
+        if (now < current) return;
+
+        // timers already due at the current tick (scheduled in the past)
+        expireSlot(slotOf(current, 0), out);
+
+        while (current < now) {
+            // every wheel below the first non-empty one is idle: jump to the end
+            // of its rotation instead of ticking through empty slots
+            int lowest = 0;
+            while (lowest < kLevels && levelCount[lowest] == 0)
+                lowest++;
+            if (lowest > 0) {
+                uint64_t rotationEnd = current | ((uint64_t(1) << (kSlotBits * lowest)) - 1);
+                if (rotationEnd >= now) {
+                    current = now;
+                    break;
+                }
+                current = rotationEnd;
+            }
+
+            current++;
+            if (levelFor(current, current - 1) == kLevels)
+                drainOverflow();
+            for (int level = 1; level < kLevels; level++) {
+                if (slotOf(current, level - 1) != 0) break;
+                cascade(level, slotOf(current, level));
+            }
+            expireSlot(slotOf(current, 0), out);
+        }
+    }
+
+    std::vector<T> advance(uint64_t now) {
+        std::vector<T> expired;
+        advance(now, expired);
+        return expired;
+    }
+
+    uint64_t now() const {
+        return current;
+    }
+
+    bool empty() const {
+        return active == 0;
+    }
+
+    std::size_t size() const {
+        return active;
+    }
+};
+
+}
@@ -1,7 +1,12 @@
+#pragma once
 #include <functional>
 #include <initializer_list>
 #include <stdexcept>
 #include <memory>
+#include <utility>
+#include "../utilities/capacity.hpp"
+#include "../utilities/page_allocation.hpp"
+#include "../utilities/serialization.hpp"
 
 using namespace std;
 
@@ -25,21 +30,27 @@ public:
     }
 };
 
-template <typename K, typename V, typename HashFunc = std::hash<K>>
+// Allocation places the bucket array (see utilities/page_allocation.hpp);
+// nodes always come from the heap.
+template <typename K, typename V, typename HashFunc = std::hash<K>, typename Allocation = heap_allocation>
 class unordered_map {
-    UMapNode<K, V>** buckets;
-    int count;
-    int numBuckets;
+    using Bucket = UMapNode<K, V>*;
+
+    Bucket* buckets;
+    size_t count;
+    size_t numBuckets;
     float maxLoadFactor;
     HashFunc hashFunc;
 
+    friend struct serial::codec<unordered_map>;
+
 public:
     unordered_map() {
         count = 0;
         numBuckets = 5;
         maxLoadFactor = 0.7f;
-        buckets = new UMapNode<K, V>*[numBuckets];
-        for (int i = 0; i < numBuckets; i++) {
+        buckets = allocateBuckets(numBuckets);
+        for (size_t i = 0; i < numBuckets; i++) {
             buckets[i] = nullptr;
         }
     }
@@ -50,18 +61,49 @@ public:
         }
     }
 
+    unordered_map(const unordered_map& other)
+        : count(0), numBuckets(other.numBuckets), maxLoadFactor(other.maxLoadFactor), hashFunc(other.hashFunc) {
+        buckets = allocateBuckets(numBuckets);
+        for (size_t i = 0; i < numBuckets; i++) {
+            buckets[i] = nullptr;
+        }
+        for (size_t i = 0; i < other.numBuckets; i++) {
+            for (UMapNode<K, V>* node = other.buckets[i]; node != nullptr; node = node->next) {
+                insert(node->key, node->value);
+            }
+        }
+    }
+
+    // other is left with a fresh empty bucket array, so it can still be used
+    unordered_map(unordered_map&& other) : unordered_map() {
+        swap(other);
+    }
+
+    unordered_map& operator=(unordered_map other) {
+        swap(other);
+        return *this;
+    }
+
+    void swap(unordered_map& other) noexcept {
+        std::swap(buckets, other.buckets);
+        std::swap(count, other.count);
+        std::swap(numBuckets, other.numBuckets);
+        std::swap(maxLoadFactor, other.maxLoadFactor);
+        std::swap(hashFunc, other.hashFunc);
+    }
+
     ~unordered_map() {
-        for (int i = 0; i < numBuckets; i++) {
+        for (size_t i = 0; i < numBuckets; i++) {
             delete buckets[i];
         }
-        delete[] buckets;
+        freeBuckets(buckets, numBuckets);
     }
 
     class iterator {
         UMapNode<K, V>* current;
         UMapNode<K, V>** buckets;
-        int index;
-        int numBuckets;
+        size_t index;
+        size_t numBuckets;
         mutable std::unique_ptr<std::pair<const K, V>> currentPairPtr;
 
         void advanceToNextValid() {
@@ -71,7 +113,7 @@ public:
         }
 
     public:
-        iterator(UMapNode<K, V>** buckets, int numBuckets, int startIndex = 0)
+        iterator(UMapNode<K, V>** buckets, size_t numBuckets, size_t startIndex = 0)
             : buckets(buckets), numBuckets(numBuckets), index(startIndex), current(nullptr) {
             if (index < numBuckets) {
                 current = buckets[index++];
@@ -119,10 +161,27 @@ public:
         }
     };
 
-    int size() {
+    size_t size() const {
         return count;
     }
 
+    size_t bucket_count() const {
+        return numBuckets;
+    }
+
+    static constexpr size_t max_size() {
+        return max_elements<UMapNode<K, V>>();
+    }
+
+    // size the bucket array so n keys fit without a rehash
+    void reserve(size_t n) {
+        check_capacity(n, max_size(), "unordered_map exceeds max_size");
+        size_t needed = static_cast<size_t>(n / static_cast<double>(maxLoadFactor)) + 1;
+        size_t maxBuckets = max_elements<UMapNode<K, V>*>();
+        if (needed > maxBuckets) needed = maxBuckets;
+        if (needed > numBuckets) rebucket(needed);
+    }
+
     iterator begin() {
         return iterator(buckets, numBuckets, 0);
     }
@@ -132,7 +191,7 @@ public:
     }
 
     void insert(K key, V value) {
-        int bucketIndex = getBucketIndex(key);
+        size_t bucketIndex = getBucketIndex(key);
         UMapNode<K, V>* head = buckets[bucketIndex];
 
         while (head != nullptr) {
@@ -143,6 +202,7 @@ public:
             head = head->next;
         }
 
+        check_capacity(count + 1, max_size(), "unordered_map exceeds max_size");
         head = buckets[bucketIndex];
         UMapNode<K, V>* node = new UMapNode<K, V>(key, value);
         node->next = head;
@@ -156,7 +216,7 @@ public:
     }
 
     V remove(K key) {
-        int bucketIndex = getBucketIndex(key);
+        size_t bucketIndex = getBucketIndex(key);
         UMapNode<K, V>* head = buckets[bucketIndex];
         UMapNode<K, V>* prev = nullptr;
 
@@ -179,8 +239,8 @@ public:
         return V();
     }
 
-    V getValue(K key) {
-        int bucketIndex = getBucketIndex(key);
+    V getValue(K key) const {
+        size_t bucketIndex = getBucketIndex(key);
         UMapNode<K, V>* head = buckets[bucketIndex];
         while (head != nullptr) {
             if (head->key == key) {
@@ -191,8 +251,15 @@ public:
         return V();
     }
 
+    bool contains(K key) const {
+        for (UMapNode<K, V>* head = buckets[getBucketIndex(key)]; head != nullptr; head = head->next) {
+            if (head->key == key) return true;
+        }
+        return false;
+    }
+
     V& operator[](const K& key) {
-        int bucketIndex = getBucketIndex(key);
+        size_t bucketIndex = getBucketIndex(key);
         UMapNode<K, V>* head = buckets[bucketIndex];
         while (head != nullptr) {
             if (head->key == key) {
@@ -204,39 +271,86 @@ public:
     }
 
 private:
-    int getBucketIndex(K key) {
-        size_t hashCode = hashFunc(key);
-        return static_cast<int>(hashCode % numBuckets);
+    static Bucket* allocateBuckets(size_t n) {
+        return static_cast<Bucket*>(Allocation::allocate(n * sizeof(Bucket), alignof(Bucket)));
+    }
+
+    static void freeBuckets(Bucket* array, size_t n) {
+        if (array) Allocation::deallocate(array, n * sizeof(Bucket), alignof(Bucket));
+    }
+
+    size_t getBucketIndex(K key) const {
+        return hashFunc(key) % numBuckets;
     }
 
     float getLoadFactor() const {
         return (1.0f * count) / numBuckets;
     }
 
+    // double the bucket array; once it cannot grow further the chains just lengthen
     void rehash() {
-        int oldNumBuckets = numBuckets;
-        numBuckets *= 2;
-        UMapNode<K, V>** oldBuckets = buckets;
+        size_t maxBuckets = max_elements<UMapNode<K, V>*>();
+        if (numBuckets >= maxBuckets) return;
+        rebucket(grown_capacity(numBuckets, 5, maxBuckets, "unordered_map bucket overflow"));
+    }
 
-        buckets = new UMapNode<K, V>*[numBuckets];
-        for (int i = 0; i < numBuckets; i++) {
-            buckets[i] = nullptr;
+    // move every node into a fresh array of newNumBuckets chains
+    void rebucket(size_t newNumBuckets) {
+        Bucket* newBuckets = allocateBuckets(newNumBuckets);
+        for (size_t i = 0; i < newNumBuckets; i++) {
+            newBuckets[i] = nullptr;
         }
 
-        count = 0;
-
-        for (int i = 0; i < oldNumBuckets; i++) {
-            UMapNode<K, V>* head = oldBuckets[i];
+        for (size_t i = 0; i < numBuckets; i++) {
+            UMapNode<K, V>* head = buckets[i];
             while (head != nullptr) {
-                insert(head->key, head->value);
-                UMapNode<K, V>* temp = head;
-                head = head->next;
-                temp->next = nullptr;
-                delete temp;
+                UMapNode<K, V>* next = head->next;
+                size_t index = hashFunc(head->key) % newNumBuckets;
+                head->next = newBuckets[index];
+                newBuckets[index] = head;
+                head = next;
+            }
+        }
+        freeBuckets(buckets, numBuckets);
+        buckets = newBuckets;
+        numBuckets = newNumBuckets;
+    }
+};
+
+namespace serial {
+
+template <typename K, typename V, typename HashFunc, typename Allocation>
+struct codec<unordered_map<K, V, HashFunc, Allocation>> {
+    static constexpr uint8_t tag = tag_unordered_map;
+    using Map = unordered_map<K, V, HashFunc, Allocation>;
+
+    template <typename Sink>
+    static void write(Sink& sink, const Map& m) {
+        write_count(sink, m.count);
+        for (size_t i = 0; i < m.numBuckets; i++) {
+            for (const UMapNode<K, V>* node = m.buckets[i]; node != nullptr; node = node->next) {
+                write_value(sink, node->key);
+                write_value(sink, node->value);
             }
         }
-        delete[] oldBuckets;
+    }
+
+    // buckets are sized for the stored count up front, so loading never rehashes
+    template <typename Source>
+    static Map read(Source& source) {
+        size_t n = read_count(source, Map::max_size());
+        Map m;
+        m.reserve(n);
+        for (size_t i = 0; i < n; i++) {
+            K key = read_value<K>(source);
+            V value = read_value<V>(source);
+            m.insert(key, value);
+        }
+        if (m.count != n) throw std::runtime_error("deserialize: duplicate unordered_map keys");
+        return m;
     }
 };
 
 }
+
+}
@@ -2,6 +2,10 @@
 #include <initializer_list>
 #include <functional>
 #include <stdexcept>
+#include <utility>
+#include "../utilities/capacity.hpp"
+#include "../utilities/page_allocation.hpp"
+#include "../utilities/serialization.hpp"
 
 namespace mystl {
 
@@ -18,21 +22,27 @@ public:
     }
 };
 
-template <typename K, typename HashFunc = std::hash<K>>
+// Allocation places the bucket array (see utilities/page_allocation.hpp);
+// nodes always come from the heap.
+template <typename K, typename HashFunc = std::hash<K>, typename Allocation = heap_allocation>
 class unordered_set {
-    USetNode<K>** buckets;
-    int count;
-    int numBuckets;
+    using Bucket = USetNode<K>*;
+
+    Bucket* buckets;
+    std::size_t count;
+    std::size_t numBuckets;
     float maxLoadFactor;
     HashFunc hashFunc;
 
+    friend struct serial::codec<unordered_set>;
+
 public:
     unordered_set() {
         count = 0;
         numBuckets = 5;
         maxLoadFactor = 0.7f;
-        buckets = new USetNode<K>*[numBuckets];
-        for (int i = 0; i < numBuckets; i++) {
+        buckets = allocateBuckets(numBuckets);
+        for (std::size_t i = 0; i < numBuckets; i++) {
             buckets[i] = nullptr;
         }
     }
@@ -43,17 +53,63 @@ public:
         }
     }
 
+    unordered_set(const unordered_set& other) : unordered_set() {
+        maxLoadFactor = other.maxLoadFactor;
+        hashFunc = other.hashFunc;
+        reserve(other.count);
+        for (std::size_t i = 0; i < other.numBuckets; i++) {
+            for (const USetNode<K>* node = other.buckets[i]; node; node = node->next) {
+                insert(node->key);
+            }
+        }
+    }
+
+    // other is left with a fresh empty bucket array, so it can still be used
+    unordered_set(unordered_set&& other) : unordered_set() {
+        swap(other);
+    }
+
+    unordered_set& operator=(unordered_set other) {
+        swap(other);
+        return *this;
+    }
+
+    void swap(unordered_set& other) noexcept {
+        std::swap(buckets, other.buckets);
+        std::swap(count, other.count);
+        std::swap(numBuckets, other.numBuckets);
+        std::swap(maxLoadFactor, other.maxLoadFactor);
+        std::swap(hashFunc, other.hashFunc);
+    }
+
     ~unordered_set() {
-        for (int i = 0; i < numBuckets; i++) {
+        for (std::size_t i = 0; i < numBuckets; i++) {
             delete buckets[i];
         }
-        delete[] buckets;
+        freeBuckets(buckets, numBuckets);
     }
 
-    int size() const {
+    std::size_t size() const {
         return count;
     }
 
+    std::size_t bucket_count() const {
+        return numBuckets;
+    }
+
+    static constexpr std::size_t max_size() {
+        return max_elements<USetNode<K>>();
+    }
+
+    // size the bucket array so n keys fit without a rehash
+    void reserve(std::size_t n) {
+        check_capacity(n, max_size(), "unordered_set exceeds max_size");
+        std::size_t needed = static_cast<std::size_t>(n / static_cast<double>(maxLoadFactor)) + 1;
+        std::size_t maxBuckets = max_elements<USetNode<K>*>();
+        if (needed > maxBuckets) needed = maxBuckets;
+        if (needed > numBuckets) rebucket(needed);
+    }
+
     bool empty() const {
         return count == 0;
     }
@@ -61,8 +117,8 @@ public:
     class iterator {
         USetNode<K>* current;
         USetNode<K>** buckets;
-        int index;
-        int numBuckets;
+        std::size_t index;
+        std::size_t numBuckets;
 
         void advance() {
             while (!current && index < numBuckets) {
@@ -71,7 +127,7 @@ public:
         }
 
     public:
-        iterator(USetNode<K>** buckets, int numBuckets, int index = 0, USetNode<K>* current = nullptr)
+        iterator(USetNode<K>** buckets, std::size_t numBuckets, std::size_t index = 0, USetNode<K>* current = nullptr)
             : buckets(buckets), numBuckets(numBuckets), index(index), current(current) {
             if (!current && index < numBuckets) {
                 current = buckets[index++];
@@ -115,7 +171,7 @@ public:
     }
 
     iterator find(const K& key) {
-        int index = getBucketIndex(key);
+        std::size_t index = getBucketIndex(key);
         USetNode<K>* head = buckets[index];
         while (head) {
             if (head->key == key)
@@ -128,7 +184,8 @@ public:
     void insert(const K& key) {
         if (find(key) != end()) return;
 
-        int index = getBucketIndex(key);
+        check_capacity(count + 1, max_size(), "unordered_set exceeds max_size");
+        std::size_t index = getBucketIndex(key);
         USetNode<K>* node = new USetNode<K>(key);
         node->next = buckets[index];
         buckets[index] = node;
@@ -140,7 +197,7 @@ public:
     }
 
     void erase(const K& key) {
-        int index = getBucketIndex(key);
+        std::size_t index = getBucketIndex(key);
         USetNode<K>* head = buckets[index];
         USetNode<K>* prev = nullptr;
 
@@ -159,7 +216,7 @@ public:
     }
 
     void clear() {
-        for (int i = 0; i < numBuckets; i++) {
+        for (std::size_t i = 0; i < numBuckets; i++) {
             delete buckets[i];
             buckets[i] = nullptr;
         }
@@ -167,39 +224,83 @@ public:
     }
 
 private:
-    int getBucketIndex(const K& key) const {
-        return static_cast<int>(hashFunc(key) % numBuckets);
+    static Bucket* allocateBuckets(std::size_t n) {
+        return static_cast<Bucket*>(Allocation::allocate(n * sizeof(Bucket), alignof(Bucket)));
+    }
+
+    static void freeBuckets(Bucket* array, std::size_t n) {
+        if (array) Allocation::deallocate(array, n * sizeof(Bucket), alignof(Bucket));
+    }
+
+    std::size_t getBucketIndex(const K& key) const {
+        return hashFunc(key) % numBuckets;
     }
 
     float getLoadFactor() const {
         return static_cast<float>(count) / numBuckets;
     }
 
+    // double the bucket array; once it cannot grow further the chains just lengthen
     void rehash() {
-        int oldNumBuckets = numBuckets;
-        numBuckets *= 2;
-        USetNode<K>** oldBuckets = buckets;
+        std::size_t maxBuckets = max_elements<USetNode<K>*>();
+        if (numBuckets >= maxBuckets) return;
+        rebucket(grown_capacity(numBuckets, 5, maxBuckets, "unordered_set bucket overflow"));
+    }
 
-        buckets = new USetNode<K>*[numBuckets];
-        for (int i = 0; i < numBuckets; i++) {
-            buckets[i] = nullptr;
+    // move every node into a fresh array of newNumBuckets chains
+    void rebucket(std::size_t newNumBuckets) {
+        Bucket* newBuckets = allocateBuckets(newNumBuckets);
+        for (std::size_t i = 0; i < newNumBuckets; i++) {
+            newBuckets[i] = nullptr;
         }
 
-        count = 0;
-
-        for (int i = 0; i < oldNumBuckets; i++) {
-            USetNode<K>* head = oldBuckets[i];
+        for (std::size_t i = 0; i < numBuckets; i++) {
+            USetNode<K>* head = buckets[i];
             while (head) {
-                insert(head->key);
-                USetNode<K>* temp = head;
-                head = head->next;
-                temp->next = nullptr;
-                delete temp;
+                USetNode<K>* next = head->next;
+                std::size_t index = hashFunc(head->key) % newNumBuckets;
+                head->next = newBuckets[index];
+                newBuckets[index] = head;
+                head = next;
+            }
+        }
+        freeBuckets(buckets, numBuckets);
+        buckets = newBuckets;
+        numBuckets = newNumBuckets;
+    }
+};
+
+namespace serial {
+
+template <typename K, typename HashFunc, typename Allocation>
+struct codec<unordered_set<K, HashFunc, Allocation>> {
+    static constexpr uint8_t tag = tag_unordered_set;
+    using Set = unordered_set<K, HashFunc, Allocation>;
+
+    template <typename Sink>
+    static void write(Sink& sink, const Set& s) {
+        write_count(sink, s.count);
+        for (std::size_t i = 0; i < s.numBuckets; i++) {
+            for (const USetNode<K>* node = s.buckets[i]; node; node = node->next) {
+                write_value(sink, node->key);
             }
         }
+    }
 
-        delete[] oldBuckets;
+    // buckets are sized for the stored count up front, so loading never rehashes
+    template <typename Source>
+    static Set read(Source& source) {
+        std::size_t n = read_count(source, Set::max_size());
+        Set s;
+        s.reserve(n);
+        for (std::size_t i = 0; i < n; i++) {
+            s.insert(read_value<K>(source));
+        }
+        if (s.count != n) throw std::runtime_error("deserialize: duplicate unordered_set keys");
+        return s;
     }
 };
 
-}
\ No newline at end of file
+}
+
+}
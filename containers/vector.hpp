@@ -2,72 +2,111 @@
 #include <memory>
 #include <stdexcept>
 #include <initializer_list>
+#include <utility>
+#include <iterator>
+#include <cstddef>
+#include <type_traits>
+#include "../utilities/capacity.hpp"
+#include "../utilities/page_allocation.hpp"
+#include "../utilities/serialization.hpp"
 using namespace std;
 
+// Bounds checks in operator[], front() and back() are kept in debug builds and
+// compiled out under NDEBUG; at() always checks. Define MYSTL_VECTOR_CHECKS to
+// 0 or 1 to override either way.
+#ifndef MYSTL_VECTOR_CHECKS
+#ifdef NDEBUG
+#define MYSTL_VECTOR_CHECKS 0
+#else
+#define MYSTL_VECTOR_CHECKS 1
+#endif
+#endif
+
 namespace mystl {
 
-template<typename T>
+// Allocation picks where the element buffer comes from (see
+// utilities/page_allocation.hpp); huge_page_allocation<> suits vectors of
+// hundreds of megabytes that are read at random.
+template<typename T, typename Allocation = heap_allocation>
 class vector {
+public:
+    using value_type = T;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = T*;
+    using const_iterator = const T*;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using difference_type = std::ptrdiff_t;
+
 private:
-    T* data;
-    int nextIndex;
-    int capacity;
+    T* buffer;
+    size_t nextIndex;
+    size_t capacity;
+
+    friend struct serial::codec<vector>;
 
 public:
     // default constructor
     vector() {
-        data = new T[5];
+        buffer = allocateSlots(5);
         nextIndex = 0;
         capacity = 5;
     }
 
     // constructor with size
-    vector(int size) {
-        data = new T[size];
+    vector(size_t size) {
+        check_capacity(size, max_size(), "vector size exceeds max_size");
+        buffer = allocateSlots(size);
         nextIndex = 0;
         capacity = size;
     }
 
     // constructor with size and initial value
-    vector(int size, T value) {
-        data = new T[size];
+    vector(size_t size, T value) {
+        check_capacity(size, max_size(), "vector size exceeds max_size");
+        buffer = allocateSlots(size);
         nextIndex = size;
         capacity = size;
-        for (int i = 0; i < size; i++)
-            data[i] = value;
+        for (size_t i = 0; i < size; i++)
+            buffer[i] = value;
     }
 
     // constructor with intialisation list
     vector(std::initializer_list<T> init) {
         capacity = init.size();
         nextIndex = capacity;
-        data = new T[capacity];
+        buffer = allocateSlots(capacity);
     
-        int i = 0;
+        size_t i = 0;
         for (const T& val : init) {
-            data[i++] = val;
+            buffer[i++] = val;
         }
     }
     
-    // constructor from iterator
-    template<typename InputIterator>
+    // constructor from iterator; integral arguments go to (size, value) instead
+    template<typename InputIterator,
+             typename = std::enable_if_t<!std::is_integral<InputIterator>::value>>
     vector(InputIterator first, InputIterator last) {
-        int size = last - first;
-        data = new T[size];
+        size_t size = static_cast<size_t>(std::distance(first, last));
+        check_capacity(size, max_size(), "vector size exceeds max_size");
+        buffer = allocateSlots(size);
         nextIndex = size;
         capacity = size;
 
-        int index = 0;
+        size_t index = 0;
         for (InputIterator it = first; it != last; ++it) {
-             data[index++] = *it;
+             buffer[index++] = *it;
         }
 }
 
     // copy constructor
     vector(const vector& v) {
-        data = new T[v.capacity];
-        for (int i = 0; i < v.nextIndex; i++)
-            data[i] = v.data[i];
+        buffer = allocateSlots(v.capacity);
+        for (size_t i = 0; i < v.nextIndex; i++)
+            buffer[i] = v.buffer[i];
         nextIndex = v.nextIndex;
         capacity = v.capacity;
     }
@@ -75,10 +114,11 @@ public:
     // assignment operator
     vector& operator=(const vector& v) {
         if (this != &v) {
-            delete[] data;
-            data = new T[v.capacity];
-            for (int i = 0; i < v.nextIndex; i++)
-                data[i] = v.data[i];
+            T* copy = allocateSlots(v.capacity);
+            for (size_t i = 0; i < v.nextIndex; i++)
+                copy[i] = v.buffer[i];
+            freeSlots(buffer, capacity);
+            buffer = copy;
             nextIndex = v.nextIndex;
             capacity = v.capacity;
         }
@@ -87,26 +127,104 @@ public:
 
     // destructor
     ~vector() {
-        delete[] data;
+        freeSlots(buffer, capacity);
+    }
+
+    // move constructor
+    vector(vector&& v) noexcept : buffer(v.buffer), nextIndex(v.nextIndex), capacity(v.capacity) {
+        v.buffer = nullptr;
+        v.nextIndex = 0;
+        v.capacity = 0;
+    }
+
+    // move assignment operator
+    vector& operator=(vector&& v) noexcept {
+        if (this != &v) {
+            freeSlots(buffer, capacity);
+            buffer = v.buffer;
+            nextIndex = v.nextIndex;
+            capacity = v.capacity;
+            v.buffer = nullptr;
+            v.nextIndex = 0;
+            v.capacity = 0;
+        }
+        return *this;
     }
 
     // push element to end
-    void push_back(T element) {
+    void push_back(const T& element) {
+        if (nextIndex == capacity) {
+            emplaceGrow(element);
+            return;
+        }
+        buffer[nextIndex++] = element;
+    }
+
+    void push_back(T&& element) {
         if (nextIndex == capacity) {
-            T* newData = new T[2 * capacity];
-            for (int i = 0; i < capacity; i++)
-                newData[i] = data[i];
-            delete[] data;
-            data = newData;
-            capacity *= 2;
+            emplaceGrow(std::move(element));
+            return;
         }
-        data[nextIndex++] = element;
+        buffer[nextIndex++] = std::move(element);
+    }
+
+    // construct element at end from arguments
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (nextIndex == capacity)
+            return emplaceGrow(std::forward<Args>(args)...);
+        buffer[nextIndex] = T(std::forward<Args>(args)...);
+        return buffer[nextIndex++];
+    }
+
+    // remove last element, releasing whatever it held
+    void pop_back() {
+        if (nextIndex == 0) {
+            throw out_of_range("pop_back on empty vector");
+        }
+        buffer[--nextIndex] = T();
+    }
+
+    // first element
+    T& front() {
+        checkNotEmpty("front on empty vector");
+        return buffer[0];
+    }
+
+    const T& front() const {
+        checkNotEmpty("front on empty vector");
+        return buffer[0];
+    }
+
+    // last element
+    T& back() {
+        checkNotEmpty("back on empty vector");
+        return buffer[nextIndex - 1];
+    }
+
+    const T& back() const {
+        checkNotEmpty("back on empty vector");
+        return buffer[nextIndex - 1];
+    }
+
+    // make room for at least newCapacity elements without changing size
+    void reserve(size_t newCapacity) {
+        check_capacity(newCapacity, max_size(), "vector reserve exceeds max_size");
+        if (newCapacity > capacity)
+            grow(newCapacity);
+    }
+
+    // remove all elements, keeping the allocated capacity
+    void clear() {
+        for (size_t i = 0; i < nextIndex; i++)
+            buffer[i] = T();
+        nextIndex = 0;
     }
 
     // replace element at index
-    void replace(int index, T element) {
+    void replace(size_t index, T element) {
         if (index < nextIndex) {
-            data[index] = element;
+            buffer[index] = element;
         } else if (index == nextIndex) {
             push_back(element);
         } else {
@@ -115,42 +233,190 @@ public:
     }
 
     // get element
-    T get(int index) const {
+    T get(size_t index) const {
         if (index < nextIndex) {
-            return data[index];
+            return buffer[index];
         }
         throw out_of_range("Index out of bounds for get");
     }
 
-    // operator[] overloading
-    T& operator[](int index) {
-        if (index < 0 || index >= nextIndex) {
-            throw out_of_range("Index out of bounds");
+    // element access, checked only when MYSTL_VECTOR_CHECKS is on
+    T& operator[](size_t index) {
+        checkIndex(index);
+        return buffer[index];
+    }
+
+    const T& operator[](size_t index) const {
+        checkIndex(index);
+        return buffer[index];
+    }
+
+    // element access, always checked
+    T& at(size_t index) {
+        if (index >= nextIndex) {
+            throw out_of_range("Index out of bounds for at");
         }
-        return data[index];
+        return buffer[index];
     }
 
-    const T& operator[](int index) const {
-        if (index < 0 || index >= nextIndex) {
-            throw out_of_range("Index out of bounds");
+    const T& at(size_t index) const {
+        if (index >= nextIndex) {
+            throw out_of_range("Index out of bounds for at");
         }
-        return data[index];
+        return buffer[index];
     }
 
+    // pointer to the contiguous element buffer
+    T* data() {
+        return buffer;
+    }
+
+    const T* data() const {
+        return buffer;
+    }
+
+    // contiguous random-access iteration
+    iterator begin() { return buffer; }
+    iterator end() { return buffer + nextIndex; }
+    const_iterator begin() const { return buffer; }
+    const_iterator end() const { return buffer + nextIndex; }
+    const_iterator cbegin() const { return buffer; }
+    const_iterator cend() const { return buffer + nextIndex; }
+
+    reverse_iterator rbegin() { return reverse_iterator(end()); }
+    reverse_iterator rend() { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
     // return current size
-    int size() const {
+    size_t size() const {
         return nextIndex;
     }
 
     // return current capacity
-    int get_capacity() const {
+    size_t get_capacity() const {
         return capacity;
     }
 
+    // largest size the vector can reach
+    static constexpr size_t max_size() {
+        return max_elements<T>();
+    }
+
     // check if vector is empty
     bool empty() const {
         return nextIndex == 0;
     }
+
+private:
+    void checkIndex(size_t index) const {
+#if MYSTL_VECTOR_CHECKS
+        if (index >= nextIndex) {
+            throw out_of_range("Index out of bounds");
+        }
+#else
+        (void)index;
+#endif
+    }
+
+    void checkNotEmpty(const char* message) const {
+#if MYSTL_VECTOR_CHECKS
+        if (nextIndex == 0) {
+            throw out_of_range(message);
+        }
+#else
+        (void)message;
+#endif
+    }
+
+    // Capacity slots are all default-constructed, as with new T[n], so
+    // assignment into buffer[size()] is always valid.
+    static T* allocateSlots(size_t n) {
+        T* slots = static_cast<T*>(Allocation::allocate(n * sizeof(T), alignof(T)));
+        size_t built = 0;
+        try {
+            for (; built < n; built++)
+                new (slots + built) T;
+        } catch (...) {
+            destroySlots(slots, built);
+            Allocation::deallocate(slots, n * sizeof(T), alignof(T));
+            throw;
+        }
+        return slots;
+    }
+
+    static void destroySlots(T* slots, size_t n) {
+        if constexpr (!std::is_trivially_destructible<T>::value) {
+            for (size_t i = 0; i < n; i++)
+                slots[i].~T();
+        }
+    }
+
+    static void freeSlots(T* slots, size_t n) {
+        if (!slots) return;
+        destroySlots(slots, n);
+        Allocation::deallocate(slots, n * sizeof(T), alignof(T));
+    }
+
+    // doubling growth that stops at max_size() instead of overflowing
+    size_t nextCapacity() const {
+        return grown_capacity(capacity, 5, max_size(), "vector exceeds max_size");
+    }
+
+    // full vector: store the new element in the next buffer before the old
+    // one is freed, since args may refer to one of its elements (v.push_back(v[0]))
+    template <typename... Args>
+    T& emplaceGrow(Args&&... args) {
+        size_t newCapacity = nextCapacity();
+        T* newBuffer = allocateSlots(newCapacity);
+        try {
+            newBuffer[nextIndex] = T(std::forward<Args>(args)...);
+        } catch (...) {
+            freeSlots(newBuffer, newCapacity);
+            throw;
+        }
+        for (size_t i = 0; i < nextIndex; i++)
+            newBuffer[i] = std::move(buffer[i]);
+        freeSlots(buffer, capacity);
+        buffer = newBuffer;
+        capacity = newCapacity;
+        return buffer[nextIndex++];
+    }
+
+    // reallocate to newCapacity, moving the existing elements across
+    void grow(size_t newCapacity) {
+        T* newBuffer = allocateSlots(newCapacity);
+        for (size_t i = 0; i < nextIndex; i++)
+            newBuffer[i] = std::move(buffer[i]);
+        freeSlots(buffer, capacity);
+        buffer = newBuffer;
+        capacity = newCapacity;
+    }
+};
+
+namespace serial {
+
+template <typename T, typename Allocation>
+struct codec<vector<T, Allocation>> {
+    static constexpr uint8_t tag = tag_vector;
+
+    template <typename Sink>
+    static void write(Sink& sink, const vector<T, Allocation>& v) {
+        write_count(sink, v.size());
+        write_array(sink, v.data(), v.size());
+    }
+
+    // one allocation of exactly the stored size, filled in place
+    template <typename Source>
+    static vector<T, Allocation> read(Source& source) {
+        size_t n = read_count(source, vector<T, Allocation>::max_size());
+        vector<T, Allocation> v(n);
+        read_array(source, v.buffer, n);
+        v.nextIndex = n;
+        return v;
+    }
 };
 
 }
+
+}
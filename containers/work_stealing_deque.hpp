@@ -0,0 +1,144 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+#include "../utilities/cache_line.hpp"
+
+namespace mystl {
+
+// Chase-Lev work-stealing deque.
+//
+// The owning thread pushes and pops at the bottom without locks (a CAS is only
+// needed when it races a thief for the last element); any other thread may steal
+// from the top with a single CAS. The circular array doubles when full. Old
+// arrays stay alive until the deque is destroyed because a thief may still be
+// reading from one; that costs at most the size of the final array again.
+//
+// Elements are read speculatively before the CAS that claims them, so T must be
+// trivially copyable; store pointers or indices to larger task objects.
+template <typename T>
+class work_stealing_deque {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "work_stealing_deque<T> requires a trivially copyable T");
+
+private:
+    struct Array {
+        int64_t capacity;
+        int64_t mask;
+        std::atomic<T>* slots;
+
+        explicit Array(int64_t capacity)
+            : capacity(capacity), mask(capacity - 1), slots(new std::atomic<T>[capacity]) {}
+
+        ~Array() {
+            delete[] slots;
+        }
+
+        T get(int64_t i) const {
+            return slots[i & mask].load(std::memory_order_relaxed);
+        }
+
+        void put(int64_t i, T value) {
+            slots[i & mask].store(value, std::memory_order_relaxed);
+        }
+
+        Array* grow(int64_t bottom, int64_t top) const {
+            Array* bigger = new Array(2 * capacity);
+            for (int64_t i = top; i != bottom; i++)
+                bigger->put(i, get(i));
+            return bigger;
+        }
+    };
+
+    alignas(cache_line_size) std::atomic<int64_t> top;
+    alignas(cache_line_size) std::atomic<int64_t> bottom;
+    std::atomic<Array*> array;
+    std::vector<Array*> retired;
+
+public:
+    // capacity is rounded up to a power of two
+    explicit work_stealing_deque(int64_t capacity = 64) : top(0), bottom(0) {
+        int64_t cap = 2;
+        while (cap < capacity) cap <<= 1;
+        array.store(new Array(cap), std::memory_order_relaxed);
+    }
+
+    work_stealing_deque(const work_stealing_deque&) = delete;
+    work_stealing_deque& operator=(const work_stealing_deque&) = delete;
+
+    ~work_stealing_deque() {
+        delete array.load(std::memory_order_relaxed);
+        for (Array* a : retired)
+            delete a;
+    }
+
+    // owner only
+    void push(T value) {
+        int64_t b = bottom.load(std::memory_order_relaxed);
+        int64_t t = top.load(std::memory_order_acquire);
+        Array* a = array.load(std::memory_order_relaxed);
+        if (b - t > a->capacity - 1) {
+            retired.push_back(a);
+            a = a->grow(b, t);
+            array.store(a, std::memory_order_release);
+        }
+        a->put(b, value);
+        bottom.store(b + 1, std::memory_order_release);
+    }
+
+    // owner only: take the most recently pushed element; false if empty
+    bool try_pop(T& out) {
+        int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        Array* a = array.load(std::memory_order_relaxed);
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top.load(std::memory_order_relaxed);
+
+        if (t > b) {
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        T value = a->get(b);
+        if (t == b) {
+            // last element: race any thief for it
+            bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                   std::memory_order_relaxed);
+            bottom.store(b + 1, std::memory_order_relaxed);
+            if (!won) return false;
+        }
+        out = value;
+        return true;
+    }
+
+    // any thread: take the oldest element; false if empty or another thread won it
+    bool try_steal(T& out) {
+        int64_t t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = bottom.load(std::memory_order_acquire);
+        if (t >= b) return false;
+
+        Array* a = array.load(std::memory_order_acquire);
+        T value = a->get(t);
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                         std::memory_order_relaxed))
+            return false;
+        out = value;
+        return true;
+    }
+
+    // snapshot only when other threads are stealing
+    int64_t size() const {
+        int64_t b = bottom.load(std::memory_order_relaxed);
+        int64_t t = top.load(std::memory_order_relaxed);
+        return b > t ? b - t : 0;
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+};
+
+}
@@ -41,7 +41,7 @@ int main() {
     vct.push_back(6);
     vct.push_back(8);
 
-    for(int i=0;i<vct.size();i++) {
+    for(size_t i=0;i<vct.size();i++) {
         cout << vct[i] << " ";
     }
 
@@ -96,7 +96,7 @@ int main() {
     dq.push_back(9);
     dq.push_front(11);
 
-    for(int i = 0;i<dq.size();i++) {
+    for(size_t i = 0;i<dq.size();i++) {
         cout << dq[i] << " ";
     }
 
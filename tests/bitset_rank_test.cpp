@@ -0,0 +1,83 @@
+#include "check.hpp"
+#include "../containers/bitset.hpp"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// rank()/select() of bitset<N> against a plain count, with modifications
+// between queries so a stale block index would show. Sizes on both sides of
+// one 512-bit block, and a last block that is only partly used.
+
+template <size_t N>
+void checkAgainstScan(std::mt19937_64& rng) {
+    mystl::bitset<N> b;
+    std::vector<bool> ref(N);
+    auto verify = [&] {
+        size_t ones = 0;
+        for (size_t pos = 0; pos <= N; pos++) {
+            CHECK(b.rank(pos) == ones);
+            if (pos < N && ref[pos]) {
+                CHECK(b.select(ones) == pos);
+                ones++;
+            }
+        }
+        CHECK(b.count() == ones);
+        bool threw = false;
+        try {
+            b.select(ones);
+        } catch (const std::out_of_range&) {
+            threw = true;
+        }
+        CHECK(threw);
+    };
+
+    for (int round = 0; round < 20; round++) {
+        for (size_t i = 0; i < N / 8 + 1 && N > 0; i++) {
+            size_t pos = rng() % N;
+            bool value = rng() & 1;
+            b.set(pos, value);
+            ref[pos] = value;
+        }
+        verify();
+        if (N > 0) {
+            size_t pos = rng() % N;
+            b.flip(pos);
+            ref[pos] = !ref[pos];
+            verify();
+        }
+    }
+
+    b.flip();
+    for (size_t i = 0; i < N; i++) ref[i] = !ref[i];
+    verify();
+    mystl::bitset<N> mask;
+    mask.set();
+    b ^= mask;
+    for (size_t i = 0; i < N; i++) ref[i] = !ref[i];
+    verify();
+    b &= mask;
+    verify();
+    b.set();
+    for (size_t i = 0; i < N; i++) ref[i] = true;
+    verify();
+    b.reset();
+    for (size_t i = 0; i < N; i++) ref[i] = false;
+    verify();
+    b |= mask;
+    for (size_t i = 0; i < N; i++) ref[i] = true;
+    verify();
+}
+
+int main() {
+    std::mt19937_64 rng(7);
+    checkAgainstScan<0>(rng);
+    checkAgainstScan<64>(rng);
+    checkAgainstScan<512>(rng);
+    checkAgainstScan<513>(rng);
+    checkAgainstScan<4096>(rng);
+    checkAgainstScan<5000>(rng);
+    static_assert(sizeof(mystl::bitset<512>) == 64, "one block needs no index");
+    std::puts("bitset_rank_test: ok");
+    return 0;
+}
@@ -0,0 +1,15 @@
+#pragma once
+#include <cstdio>
+#include <cstdlib>
+
+// Minimal checks shared by the test programs in this directory. Each test is a
+// standalone file, built like the benchmarks, e.g.
+// `g++ -std=c++17 -g -fsanitize=address,undefined growth_aliasing_test.cpp`.
+// CHECK stays active under NDEBUG, unlike assert.
+#define CHECK(cond)                                                                  \
+    do {                                                                             \
+        if (!(cond)) {                                                               \
+            std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+            std::exit(1);                                                            \
+        }                                                                            \
+    } while (0)
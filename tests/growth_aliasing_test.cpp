@@ -0,0 +1,188 @@
+#include "check.hpp"
+#include "../containers/circular_buffer.hpp"
+#include "../containers/queue.hpp"
+#include "../containers/soa_vector.hpp"
+#include "../containers/stack.hpp"
+#include "../containers/vector.hpp"
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+// Pushing an element of a container into itself while the container is full:
+// growth must read the argument before it frees the old buffer. Run under
+// -fsanitize=address to catch a use-after-free rather than just a wrong value.
+
+const std::string kLong(64, 'x');  // past the small-string buffer, so copies touch the heap
+
+void vectorSelfPush() {
+    mystl::vector<std::string> v;
+    v.push_back(kLong);
+    for (int i = 0; i < 200; i++) {
+        v.push_back(v[0]);
+        v.emplace_back(v.back());
+        v.push_back(std::move(v[0]));
+        v[0] = kLong;
+    }
+    for (size_t i = 0; i < v.size(); i++) CHECK(v[i] == kLong || v[i].empty());
+
+    mystl::stack<std::string> s;
+    s.push(kLong);
+    for (int i = 0; i < 200; i++) s.push(s.top());
+    CHECK(s.size() == 201);
+    while (!s.empty()) {
+        CHECK(s.top() == kLong);
+        s.pop();
+    }
+}
+
+void circularBufferSelfPush() {
+    mystl::circular_buffer<std::string> cb;
+    cb.push_back(kLong);
+    for (int i = 0; i < 200; i++) {
+        cb.push_back(cb.front());
+        cb.push_front(cb.back());
+        cb.emplace_back(cb[cb.size() / 2]);
+    }
+    CHECK(cb.size() == 601);
+    for (size_t i = 0; i < cb.size(); i++) CHECK(cb[i] == kLong);
+
+    mystl::queue<std::string> q;
+    q.push(kLong);
+    for (int i = 0; i < 200; i++) {
+        q.push(q.front());
+        q.push(q.back());
+    }
+    CHECK(q.size() == 401);
+    while (!q.empty()) {
+        CHECK(q.front() == kLong);
+        q.pop();
+    }
+}
+
+void soaVectorSelfPush() {
+    mystl::soa_vector<std::string, int> sv;
+    sv.emplace_back(kLong, 1);
+    for (int i = 0; i < 200; i++) {
+        sv.emplace_back(mystl::get<0>(sv[0]), mystl::get<1>(sv[0]));
+        sv.push_back(mystl::tuple<std::string, int>(mystl::get<0>(sv.back()), 1));
+    }
+    CHECK(sv.size() == 401);
+    for (auto row : sv) CHECK(mystl::get<0>(row) == kLong && mystl::get<1>(row) == 1);
+}
+
+// counts live instances; constructing from a negative value throws
+struct Tracked {
+    static int live;
+    int value;
+    Tracked(int v) : value(v) {
+        if (v < 0) throw std::runtime_error("negative");
+        live++;
+    }
+    Tracked(const Tracked& other) : value(other.value) { live++; }
+    ~Tracked() { live--; }
+};
+int Tracked::live = 0;
+
+// a throwing field constructor must not leak the fields built before it
+void soaVectorRowUnwind() {
+    {
+        mystl::soa_vector<Tracked, Tracked> sv;
+        for (int i = 0; i < 40; i++) {
+            sv.emplace_back(i, i);
+            bool threw = false;
+            try {
+                sv.emplace_back(i, -1);  // the first column is built, the second throws
+            } catch (const std::runtime_error&) {
+                threw = true;
+            }
+            CHECK(threw);
+            CHECK(sv.size() == static_cast<size_t>(i + 1));
+            CHECK(Tracked::live == 2 * (i + 1));
+        }
+    }
+    CHECK(Tracked::live == 0);
+}
+
+// copies throw once the countdown reaches zero; the move is not noexcept, so
+// growth has to copy
+struct Fragile {
+    static int copiesLeft;
+    std::string text;
+    explicit Fragile(std::string t) : text(std::move(t)) {}
+    Fragile(const Fragile& other) : text(other.text) {
+        if (copiesLeft >= 0 && copiesLeft-- == 0) throw std::runtime_error("copy");
+    }
+    Fragile(Fragile&& other) : text(std::move(other.text)) {}
+    Fragile& operator=(const Fragile&) = default;
+};
+int Fragile::copiesLeft = -1;
+
+// a copy that throws while the columns move to new storage must leave every
+// row where it was, including the columns that are moved rather than copied
+void soaVectorGrowthRollback() {
+    mystl::soa_vector<std::string, Fragile, Tracked> sv;
+    for (int i = 0; i < 16; i++) sv.emplace_back(kLong + std::to_string(i), Fragile(std::to_string(i)), i);
+    CHECK(sv.size() == sv.capacity());
+    int live = Tracked::live;
+    for (int failAt : {0, 7, 15}) {
+        Fragile::copiesLeft = failAt;
+        bool threw = false;
+        try {
+            sv.emplace_back(kLong, Fragile("new"), 99);
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        CHECK(threw);
+        CHECK(sv.size() == 16 && sv.capacity() == 16);
+        CHECK(Tracked::live == live);
+        for (int i = 0; i < 16; i++) {
+            auto [text, fragile, tracked] = sv[i];
+            CHECK(text == kLong + std::to_string(i) && fragile.text == std::to_string(i) && tracked.value == i);
+        }
+    }
+    Fragile::copiesLeft = -1;
+    sv.emplace_back(kLong, Fragile("new"), 99);
+    CHECK(sv.size() == 17 && mystl::get<0>(sv[3]) == kLong + "3" && mystl::get<1>(sv[16]).text == "new");
+
+    Fragile::copiesLeft = 5;
+    bool threw = false;
+    try {
+        sv.reserve(1000);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    CHECK(threw && sv.capacity() < 1000 && mystl::get<0>(sv[16]) == kLong);
+    Fragile::copiesLeft = -1;
+}
+
+// rows assign through to the fields, from another row or from a value
+void soaVectorRowAssign() {
+    mystl::soa_vector<std::string, int> sv;
+    for (int i = 0; i < 4; i++) sv.emplace_back(kLong + std::to_string(i), i);
+    sv[0] = sv[2];
+    CHECK(mystl::get<0>(sv[0]) == kLong + "2" && mystl::get<1>(sv[0]) == 2);
+    sv[1] = sv[1];
+    CHECK(mystl::get<0>(sv[1]) == kLong + "1" && mystl::get<1>(sv[1]) == 1);
+    *sv.begin() = mystl::tuple<std::string, int>("head", -1);
+    CHECK(mystl::get<0>(sv[0]) == "head" && mystl::get<1>(sv[0]) == -1);
+    const auto& frozen = sv;
+    sv[3] = frozen[0];
+    CHECK(mystl::get<0>(sv[3]) == "head" && mystl::get<1>(sv[3]) == -1);
+    swap(sv[1], sv[2]);
+    CHECK(mystl::get<0>(sv[1]) == kLong + "2" && mystl::get<1>(sv[2]) == 1);
+    for (auto row : sv) row = mystl::tuple<std::string, int>("x", 0);
+    for (auto [text, n] : sv) CHECK(text == "x" && n == 0);
+}
+
+int main() {
+    vectorSelfPush();
+    circularBufferSelfPush();
+    soaVectorSelfPush();
+    soaVectorRowUnwind();
+    soaVectorGrowthRollback();
+    soaVectorRowAssign();
+    std::puts("growth_aliasing_test: ok");
+    return 0;
+}
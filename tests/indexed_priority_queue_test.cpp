@@ -0,0 +1,135 @@
+#include "check.hpp"
+#include "../containers/indexed_priority_queue.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+// Handles that outlive their element, key updates in the wrong direction, and
+// a random mix of operations checked against a std::map of the live handles.
+
+using MinQueue = mystl::indexed_priority_queue<int, std::greater<int>, 4>;
+
+template <typename F>
+bool throws(F f) {
+    try {
+        f();
+    } catch (const std::exception&) {
+        return true;
+    }
+    return false;
+}
+
+void staleHandles() {
+    MinQueue pq;
+    auto a = pq.push(10);
+    auto b = pq.push(20);
+    pq.erase(a);
+    auto c = pq.push(30);  // reuses a's slot
+    CHECK(!pq.contains(a));
+    CHECK(pq.contains(b) && pq.contains(c));
+    CHECK(throws([&] { pq.update(a, 1); }));
+    CHECK(throws([&] { pq.erase(a); }));
+    CHECK(throws([&] { pq.decrease_key(a, 1); }));
+    CHECK(throws([&] { pq.get(a); }));
+    CHECK(pq.get(c) == 30 && pq.size() == 2);
+
+    auto top = pq.top_handle();
+    CHECK(top == b);
+    pq.pop();
+    CHECK(!pq.contains(b));
+    auto d = pq.push(5);
+    CHECK(!pq.contains(b) && pq.contains(d) && pq.top_handle() == d);
+
+    pq.clear();
+    CHECK(!pq.contains(c) && !pq.contains(d));
+    auto e = pq.push(1);
+    CHECK(pq.contains(e) && !pq.contains(c) && !pq.contains(d));
+}
+
+void keyDirection() {
+    MinQueue pq;
+    auto a = pq.push(10);
+    pq.push(7);
+    pq.decrease_key(a, 3);
+    CHECK(pq.top() == 3);
+    CHECK(throws([&] { pq.decrease_key(a, 4); }));
+    CHECK(pq.get(a) == 3);
+    pq.increase_key(a, 9);
+    CHECK(pq.top() == 7);
+    CHECK(throws([&] { pq.increase_key(a, 8); }));
+    pq.decrease_key(a, 9);  // unchanged keys are allowed both ways
+    pq.increase_key(a, 9);
+
+    mystl::indexed_priority_queue<int> maxQueue;
+    auto b = maxQueue.push(10);
+    maxQueue.push(7);
+    maxQueue.decrease_key(b, 3);
+    CHECK(maxQueue.top() == 7);
+    CHECK(throws([&] { maxQueue.decrease_key(b, 5); }));
+}
+
+void randomOps() {
+    std::mt19937 rng(42);
+    MinQueue pq;
+    std::map<MinQueue::handle, int> live;
+    std::vector<MinQueue::handle> dead;
+    for (int step = 0; step < 200000; step++) {
+        int op = rng() % 6;
+        if (op <= 1 || live.empty()) {
+            int v = static_cast<int>(rng() % 100000);
+            auto h = pq.push(v);
+            CHECK(!live.count(h));
+            live[h] = v;
+        } else if (op == 2) {
+            if (step % 64 == 0) {
+                int best = INT32_MAX;
+                for (auto& [h, v] : live) best = v < best ? v : best;
+                CHECK(pq.top() == best);
+            }
+            auto h = pq.top_handle();
+            CHECK(live[h] == pq.top());
+            pq.pop();
+            live.erase(h);
+            dead.push_back(h);
+        } else {
+            auto it = live.begin();
+            std::advance(it, rng() % live.size());
+            auto h = it->first;
+            if (op == 3) {
+                pq.erase(h);
+                live.erase(it);
+                dead.push_back(h);
+            } else if (op == 4) {
+                int v = it->second - static_cast<int>(rng() % 1000);
+                pq.decrease_key(h, v);
+                it->second = v;
+            } else {
+                int v = static_cast<int>(rng() % 100000);
+                pq.update(h, v);
+                it->second = v;
+            }
+        }
+        if (!dead.empty() && step % 16 == 0) CHECK(!pq.contains(dead[rng() % dead.size()]));
+        CHECK(pq.size() == live.size());
+    }
+    int last = INT32_MIN;
+    while (!pq.empty()) {
+        CHECK(pq.top() >= last);
+        last = pq.top();
+        pq.pop();
+    }
+}
+
+int main() {
+    staleHandles();
+    keyDirection();
+    randomOps();
+    std::puts("indexed_priority_queue_test: ok");
+    return 0;
+}
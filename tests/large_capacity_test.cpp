@@ -0,0 +1,119 @@
+#include "check.hpp"
+#include "../containers/unordered_map.hpp"
+#include "../containers/unordered_set.hpp"
+#include "../containers/vector.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+
+// Sizes and bucket indices past 2^31, which used to wrap in int bookkeeping.
+//
+// The large runs need a lot of memory and are skipped unless
+// MYSTL_LARGE_TESTS=1 is set:
+//
+//   vector   a vector<uint8_t> of 2^31 + 4096 elements        ~2.2 GB
+//   buckets  unordered_map / unordered_set with more than
+//            2^31 buckets (8-byte bucket pointers)            ~18 GB each
+//
+// Pass "vector" or "buckets" to run one of them. Build with -O2; the element
+// loops are too slow under the sanitizers.
+
+constexpr uint64_t kPast31 = (uint64_t(1) << 31) + 4096;
+
+// a moved-from map keeps an empty bucket array and stays usable
+void movedFromMap() {
+    mystl::unordered_map<int, int> a;
+    for (int i = 0; i < 100; i++) a.insert(i, i * i);
+    mystl::unordered_map<int, int> b(std::move(a));
+    CHECK(b.size() == 100 && b.getValue(9) == 81);
+    CHECK(a.size() == 0 && a.bucket_count() > 0);
+    CHECK(!a.contains(3));
+    a.insert(3, 4);
+    a.insert(5, 0);
+    a[5] = 6;
+    CHECK(a.getValue(3) == 4 && a.getValue(5) == 6);
+    CHECK(a.remove(3) == 4 && a.size() == 1);
+}
+
+void largeVector() {
+    mystl::vector<uint8_t> v;
+    v.reserve(kPast31);  // doubling from 2^31 would hold 6 GB at once
+    for (uint64_t i = 0; i < kPast31; i++) v.push_back(static_cast<uint8_t>(i * 31));
+    CHECK(v.size() == kPast31);
+    for (uint64_t i : {uint64_t(0), uint64_t(1) << 31, (uint64_t(1) << 31) + 1, kPast31 - 1}) {
+        CHECK(v[i] == static_cast<uint8_t>(i * 31));
+        CHECK(v.at(i) == static_cast<uint8_t>(i * 31));
+    }
+    CHECK(v.back() == static_cast<uint8_t>((kPast31 - 1) * 31));
+    v.pop_back();
+    CHECK(v.size() == kPast31 - 1);
+    bool threw = false;
+    try {
+        v.at(kPast31 - 1);
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    CHECK(threw);
+    std::printf("vector: %llu elements ok\n", static_cast<unsigned long long>(v.size()));
+}
+
+// std::hash<uint64_t> is the identity, so these keys land in buckets above
+// 2^31 once the table is that large
+const uint64_t kHighKeys[] = {(uint64_t(1) << 31) + 1, (uint64_t(1) << 31) + 77, (uint64_t(1) << 32) - 1,
+                              uint64_t(1) << 31, 12345};
+
+void largeBuckets() {
+    // reserve sizes the array at n / 0.7 buckets
+    const size_t keys = static_cast<size_t>(kPast31 * 0.7) + 1;
+    {
+        mystl::unordered_map<uint64_t, uint32_t> m;
+        m.reserve(keys);
+        CHECK(m.bucket_count() > (size_t(1) << 31));
+        uint32_t n = 0;
+        for (uint64_t k : kHighKeys) m.insert(k, n++);
+        CHECK(m.size() == 5);
+        n = 0;
+        for (uint64_t k : kHighKeys) {
+            CHECK(m.contains(k));
+            CHECK(m.getValue(k) == n++);
+        }
+        CHECK(!m.contains((uint64_t(1) << 31) + 2));
+        m[(uint64_t(1) << 32) - 1] = 99;
+        CHECK(m.getValue((uint64_t(1) << 32) - 1) == 99);
+        CHECK(m.remove((uint64_t(1) << 31) + 77) == 1 && !m.contains((uint64_t(1) << 31) + 77));
+        size_t seen = 0;
+        for (auto it = m.begin(); it != m.end(); ++it) seen++;
+        CHECK(seen == 4);
+        std::printf("unordered_map: %zu buckets ok\n", m.bucket_count());
+    }
+    {
+        mystl::unordered_set<uint64_t> s;
+        s.reserve(keys);
+        CHECK(s.bucket_count() > (size_t(1) << 31));
+        for (uint64_t k : kHighKeys) s.insert(k);
+        CHECK(s.size() == 5);
+        for (uint64_t k : kHighKeys) CHECK(s.find(k) != s.end());
+        CHECK(s.find((uint64_t(1) << 31) + 2) == s.end());
+        s.erase(uint64_t(1) << 31);
+        CHECK(s.size() == 4 && s.find(uint64_t(1) << 31) == s.end());
+        std::printf("unordered_set: %zu buckets ok\n", s.bucket_count());
+    }
+}
+
+int main(int argc, char** argv) {
+    movedFromMap();
+
+    const char* enabled = std::getenv("MYSTL_LARGE_TESTS");
+    if (!enabled || std::strcmp(enabled, "1") != 0) {
+        std::puts("large_capacity_test: large runs skipped (set MYSTL_LARGE_TESTS=1)");
+        return 0;
+    }
+    const char* only = argc > 1 ? argv[1] : nullptr;
+    if (!only || std::strcmp(only, "vector") == 0) largeVector();
+    if (!only || std::strcmp(only, "buckets") == 0) largeBuckets();
+    std::puts("large_capacity_test: ok");
+    return 0;
+}
@@ -0,0 +1,54 @@
+#include "check.hpp"
+#include "../containers/mmap_unordered_map.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#include <unistd.h>
+
+// A map of constant size under steady remove/insert churn: tombstones force a
+// rehash at the same size again and again, and the retired slot arrays must be
+// reused rather than left behind in the file.
+
+constexpr uint64_t kLive = 1000;
+constexpr uint64_t kRounds = 2000000;
+
+int main() {
+    std::string path = "/tmp/mystl_mmap_churn_test_" + std::to_string(getpid()) + ".bin";
+    unlink(path.c_str());
+    std::size_t settled = 0;
+    {
+        mystl::mmap_unordered_map<uint64_t, uint64_t> m(path);
+        for (uint64_t k = 0; k < kLive; k++) m.insert(k, k * 3);
+        for (uint64_t r = 0; r < kRounds; r++) {
+            // slide a window of kLive keys: drop the oldest, add the next
+            CHECK(m.remove(r) == r * 3);
+            m.insert(r + kLive, (r + kLive) * 3);
+            if (r == 100000) settled = m.file_bytes();
+        }
+        CHECK(m.size() == kLive);
+        std::printf("file_bytes: %zu after warm-up, %zu after %llu rounds\n", settled, m.file_bytes(),
+                    static_cast<unsigned long long>(kRounds));
+        CHECK(m.file_bytes() == settled);
+        CHECK(m.file_bytes() < 256 * 1024);
+    }
+    {
+        mystl::mmap_unordered_map<uint64_t, uint64_t> m(path);
+        CHECK(m.size() == kLive);
+        for (uint64_t k = kRounds; k < kRounds + kLive; k++) CHECK(m.getValue(k) == k * 3);
+        CHECK(!m.contains(kRounds - 1));
+        // shrinking and growing again reuses the arrays of each size
+        for (uint64_t k = kRounds; k < kRounds + kLive; k++) m.remove(k);
+        std::size_t before = m.file_bytes();
+        for (int pass = 0; pass < 20; pass++) {
+            for (uint64_t k = 0; k < kLive; k++) m.insert(k, k);
+            for (uint64_t k = 0; k < kLive; k++) m.remove(k);
+        }
+        CHECK(m.empty());
+        CHECK(m.file_bytes() <= before * 2);
+    }
+    unlink(path.c_str());
+    std::puts("mmap_churn_test: ok");
+    return 0;
+}
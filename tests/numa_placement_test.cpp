@@ -0,0 +1,60 @@
+#include "check.hpp"
+#include "../utilities/page_allocation.hpp"
+
+#include <cstdio>
+
+// The mbind modes behind each numa_placement. place() skips mbind on a
+// single-node machine, so the test hands it a two-node mask; the local
+// policies only name the current node, which exists, and the kernel's
+// policy for the range is read back with get_mempolicy.
+
+#if MYSTL_PAGE_MAPPING
+
+constexpr int kMpolDefault = 0;
+constexpr unsigned long kMpolFAddr = 2;  // MPOL_F_ADDR: policy of the page at addr
+
+int policyAt(void* p) {
+    int mode = -1;
+    unsigned long nodes[2] = {};
+    if (syscall(SYS_get_mempolicy, &mode, nodes, 128, p, kMpolFAddr) != 0) return -1;
+    return mode;
+}
+
+int placedMode(mystl::numa_placement placement) {
+    std::size_t bytes = mystl::pages::huge_page_size;
+    void* p = mystl::pages::map(bytes, false, mystl::numa_placement::none);
+    mystl::pages::place(p, bytes, placement, 0x3);
+    int mode = policyAt(p);
+    mystl::pages::unmap(p, bytes);
+    return mode;
+}
+
+int main() {
+    int probe = 0;
+    if (policyAt(&probe) < 0) {
+        std::puts("numa_placement_test: skipped (no get_mempolicy)");
+        return 0;
+    }
+    CHECK(placedMode(mystl::numa_placement::none) == kMpolDefault);
+    CHECK(placedMode(mystl::numa_placement::local) == mystl::pages::kMpolPreferred);
+    CHECK(placedMode(mystl::numa_placement::bind_local) == mystl::pages::kMpolBind);
+
+    // the single-node shortcut still leaves the kernel default
+    std::size_t bytes = mystl::pages::huge_page_size;
+    void* p = mystl::pages::map(bytes, false, mystl::numa_placement::none);
+    mystl::pages::place(p, bytes, mystl::numa_placement::bind_local, 0x1);
+    CHECK(policyAt(p) == kMpolDefault);
+    mystl::pages::unmap(p, bytes);
+
+    std::puts("numa_placement_test: ok");
+    return 0;
+}
+
+#else
+
+int main() {
+    std::puts("numa_placement_test: skipped (no page mapping on this platform)");
+    return 0;
+}
+
+#endif
@@ -0,0 +1,212 @@
+#include "check.hpp"
+#include "../containers/deque.hpp"
+#include "../containers/map.hpp"
+#include "../containers/set.hpp"
+#include "../containers/string.hpp"
+#include "../containers/unordered_map.hpp"
+#include "../containers/unordered_set.hpp"
+#include "../containers/vector.hpp"
+#include "../utilities/serialization.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+// Round trips through streams and file descriptors, including several
+// documents written back to back and read with one deserialize() each.
+
+using Scores = mystl::map<mystl::string, mystl::vector<int>>;
+
+mystl::vector<double> makeDoubles(size_t n) {
+    mystl::vector<double> v;
+    for (size_t i = 0; i < n; i++) v.push_back(i * 0.25);
+    return v;
+}
+
+Scores makeScores() {
+    Scores m;
+    for (int i = 0; i < 500; i++) {
+        mystl::vector<int> v;
+        for (int j = 0; j < i % 5; j++) v.push_back(i * j);
+        m.insert(mystl::string(std::to_string(i).c_str()), v);
+    }
+    return m;
+}
+
+void checkDoubles(const mystl::vector<double>& v, size_t n) {
+    CHECK(v.size() == n);
+    for (size_t i = 0; i < n; i++) CHECK(v[i] == i * 0.25);
+}
+
+void checkScores(const Scores& m) {
+    int count = 0;
+    for (auto [k, v] : m) {
+        int i = std::atoi(std::string(&k[0], k.size()).c_str());
+        CHECK(v.size() == static_cast<size_t>(i % 5));
+        for (size_t j = 0; j < v.size(); j++) CHECK(v[j] == i * static_cast<int>(j));
+        count++;
+    }
+    CHECK(count == 500);
+}
+
+// write the three documents, then read them back in order
+template <typename Write, typename Read>
+void backToBack(Write write, Read read) {
+    mystl::vector<double> big = makeDoubles(100000);  // larger than the read-ahead buffer
+    mystl::vector<double> small = makeDoubles(3);
+    Scores scores = makeScores();
+    write(small, scores, big);
+    read(small.size(), big.size());
+}
+
+void streams() {
+    std::stringstream ss;
+    backToBack(
+        [&](auto& small, auto& scores, auto& big) {
+            mystl::serialize(ss, small);
+            mystl::serialize(ss, scores);
+            mystl::serialize(ss, big);
+            mystl::serialize(ss, small);
+        },
+        [&](size_t smallSize, size_t bigSize) {
+            checkDoubles(mystl::deserialize<mystl::vector<double>>(ss), smallSize);
+            checkScores(mystl::deserialize<Scores>(ss));
+            checkDoubles(mystl::deserialize<mystl::vector<double>>(ss), bigSize);
+            checkDoubles(mystl::deserialize<mystl::vector<double>>(ss), smallSize);
+        });
+}
+
+void files() {
+    char path[] = "/tmp/mystl_serialization_testXXXXXX";
+    int fd = mkstemp(path);
+    CHECK(fd >= 0);
+    unlink(path);
+    backToBack(
+        [&](auto& small, auto& scores, auto& big) {
+            mystl::serialize(fd, small);
+            mystl::serialize(fd, scores);
+            mystl::serialize(fd, big);
+            mystl::serialize(fd, small);
+            CHECK(lseek(fd, 0, SEEK_SET) == 0);
+        },
+        [&](size_t smallSize, size_t bigSize) {
+            checkDoubles(mystl::deserialize<mystl::vector<double>>(fd), smallSize);
+            checkScores(mystl::deserialize<Scores>(fd));
+            checkDoubles(mystl::deserialize<mystl::vector<double>>(fd), bigSize);
+            checkDoubles(mystl::deserialize<mystl::vector<double>>(fd), smallSize);
+            char extra;
+            CHECK(read(fd, &extra, 1) == 0);  // left exactly at the end
+        });
+    close(fd);
+}
+
+// a pipe cannot seek back, so nothing may be read past a document; kept
+// under the pipe buffer size so one thread can write and then read
+void pipes() {
+    int fds[2];
+    CHECK(pipe(fds) == 0);
+    mystl::vector<double> small = makeDoubles(100);
+    mystl::set<int> primes = {2, 3, 5, 7, 11, 13};
+    mystl::serialize(fds[1], small);
+    mystl::serialize(fds[1], primes);
+    mystl::serialize(fds[1], small);
+    close(fds[1]);
+    checkDoubles(mystl::deserialize<mystl::vector<double>>(fds[0]), 100);
+    int count = 0;
+    for (int p : mystl::deserialize<mystl::set<int>>(fds[0])) {
+        CHECK(primes.find(p) != primes.end());
+        count++;
+    }
+    CHECK(count == 6);
+    checkDoubles(mystl::deserialize<mystl::vector<double>>(fds[0]), 100);
+    close(fds[0]);
+}
+
+void hashAndDeque() {
+    std::stringstream ss;
+    mystl::unordered_map<int, mystl::string> names;
+    mystl::unordered_set<long> ids;
+    mystl::deque<int> dq = {3, 1, 4};
+    for (int i = 0; i < 1000; i++) {
+        names.insert(i, mystl::string(std::to_string(i).c_str()));
+        ids.insert(i * 7L);
+    }
+    mystl::serialize(ss, names);
+    mystl::serialize(ss, ids);
+    mystl::serialize(ss, dq);
+    auto names2 = mystl::deserialize<decltype(names)>(ss);
+    auto ids2 = mystl::deserialize<decltype(ids)>(ss);
+    auto dq2 = mystl::deserialize<decltype(dq)>(ss);
+    CHECK(names2.size() == 1000 && ids2.size() == 1000 && dq2.size() == 3);
+    for (int i = 0; i < 1000; i++) {
+        CHECK(names2.getValue(i) == mystl::string(std::to_string(i).c_str()));
+        CHECK(ids2.find(i * 7L) != ids2.end());
+    }
+    CHECK(dq2[0] == 3 && dq2[1] == 1 && dq2[2] == 4);
+
+    bool threw = false;
+    try {
+        mystl::deserialize<decltype(names)>(ss);  // nothing left
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    CHECK(threw);
+}
+
+// containers inside containers are copied and moved on the way in, so this
+// catches a shallow copy freeing the same nodes twice
+void nested() {
+    std::stringstream ss;
+    mystl::vector<mystl::set<int>> sets;
+    for (int i = 0; i < 50; i++) {
+        mystl::set<int> s;
+        for (int j = 0; j < i; j++) s.insert(j * i);
+        sets.push_back(s);
+    }
+    mystl::map<int, mystl::unordered_set<int>> groups;
+    for (int i = 0; i < 50; i++) {
+        mystl::unordered_set<int> g;
+        for (int j = 0; j < i; j++) g.insert(j - i);
+        groups.insert(i, g);
+    }
+    mystl::serialize(ss, sets);
+    mystl::serialize(ss, groups);
+    auto sets2 = mystl::deserialize<decltype(sets)>(ss);
+    auto groups2 = mystl::deserialize<decltype(groups)>(ss);
+    CHECK(sets2.size() == 50);
+    for (int i = 0; i < 50; i++) {
+        int count = 0;
+        for (int v : sets2[i]) CHECK(v == count++ * i);
+        CHECK(count == i);
+        CHECK(groups2.contains(i));
+        mystl::unordered_set<int> g = groups2[i];
+        CHECK(g.size() == static_cast<size_t>(i));
+        for (int j = 0; j < i; j++) CHECK(g.find(j - i) != g.end());
+    }
+
+    // copies are independent of their source
+    mystl::set<int> a = sets2[10];
+    mystl::unordered_set<int> b = groups2[10];
+    a.erase(0);
+    b.erase(-10);
+    CHECK(sets2[10].find(0) != sets2[10].end());
+    CHECK(groups2[10].find(-10) != groups2[10].end());
+    mystl::unordered_set<int> c = std::move(b);
+    CHECK(c.size() == 9 && b.size() == 0);
+    b.insert(1);
+    CHECK(b.find(1) != b.end());
+}
+
+int main() {
+    streams();
+    files();
+    pipes();
+    hashAndDeque();
+    nested();
+    std::puts("serialization_test: ok");
+    return 0;
+}
@@ -0,0 +1,117 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#if defined(__AVX2__) || defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+namespace mystl {
+
+// Word-parallel kernels over arrays of 64-bit words, shared by bitset,
+// dynamic_bitset and the bitmap chunks of the compressed integer set. The
+// bulk loops use AVX2 when the translation unit is compiled with it (-mavx2 or
+// -march=native) and plain 64-bit words otherwise.
+namespace bits {
+
+constexpr size_t npos = static_cast<size_t>(-1);
+
+inline void and_words(uint64_t* dst, const uint64_t* src, size_t n) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    for (; i < (n & ~size_t(3)); i += 4) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_and_si256(a, b));
+    }
+#endif
+    for (; i < n; i++) dst[i] &= src[i];
+}
+
+inline void or_words(uint64_t* dst, const uint64_t* src, size_t n) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    for (; i < (n & ~size_t(3)); i += 4) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_or_si256(a, b));
+    }
+#endif
+    for (; i < n; i++) dst[i] |= src[i];
+}
+
+inline void xor_words(uint64_t* dst, const uint64_t* src, size_t n) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    for (; i < (n & ~size_t(3)); i += 4) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_xor_si256(a, b));
+    }
+#endif
+    for (; i < n; i++) dst[i] ^= src[i];
+}
+
+// dst &= ~src
+inline void andnot_words(uint64_t* dst, const uint64_t* src, size_t n) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    for (; i < (n & ~size_t(3)); i += 4) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_andnot_si256(b, a));
+    }
+#endif
+    for (; i < n; i++) dst[i] &= ~src[i];
+}
+
+#if defined(__AVX2__)
+// per-byte popcounts of v via a nibble lookup table, summed into four 64-bit lanes
+inline __m256i popcount256(__m256i v) {
+    const __m256i table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                           0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low = _mm256_set1_epi8(0x0f);
+    __m256i lo = _mm256_shuffle_epi8(table, _mm256_and_si256(v, low));
+    __m256i hi = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(v, 4), low));
+    return _mm256_sad_epu8(_mm256_add_epi8(lo, hi), _mm256_setzero_si256());
+}
+#endif
+
+inline size_t popcount_words(const uint64_t* words, size_t n) {
+    size_t i = 0;
+    uint64_t total = 0;
+#if defined(__AVX2__)
+    __m256i sum = _mm256_setzero_si256();
+    for (; i < (n & ~size_t(3)); i += 4)
+        sum = _mm256_add_epi64(sum, popcount256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i))));
+    total = static_cast<uint64_t>(_mm256_extract_epi64(sum, 0)) + static_cast<uint64_t>(_mm256_extract_epi64(sum, 1)) +
+            static_cast<uint64_t>(_mm256_extract_epi64(sum, 2)) + static_cast<uint64_t>(_mm256_extract_epi64(sum, 3));
+#endif
+    for (; i < n; i++) total += static_cast<uint64_t>(__builtin_popcountll(words[i]));
+    return static_cast<size_t>(total);
+}
+
+// index of the first set bit at or after bit `from`, or npos
+inline size_t find_next(const uint64_t* words, size_t n, size_t from) {
+    size_t w = from / 64;
+    if (w >= n) return npos;
+    uint64_t word = words[w] & (~0ULL << (from % 64));
+    while (true) {
+        if (word) return w * 64 + static_cast<size_t>(__builtin_ctzll(word));
+        if (++w == n) return npos;
+        word = words[w];
+    }
+}
+
+// position of the k-th (0-based) set bit inside one word; k < popcount(word)
+inline unsigned select_in_word(uint64_t word, unsigned k) {
+#if defined(__BMI2__)
+    return static_cast<unsigned>(__builtin_ctzll(_pdep_u64(1ULL << k, word)));
+#else
+    for (; k > 0; k--) word &= word - 1;
+    return static_cast<unsigned>(__builtin_ctzll(word));
+#endif
+}
+
+}
+
+}
@@ -0,0 +1,11 @@
+#pragma once
+#include <cstddef>
+
+namespace mystl {
+
+// Size used to pad hot atomics of the concurrent containers onto separate cache
+// lines. 64 bytes covers x86-64 and most ARM cores; Apple M-series and some POWER
+// parts use 128, where adjacent-line prefetching makes 64 still close to optimal.
+constexpr std::size_t cache_line_size = 64;
+
+}
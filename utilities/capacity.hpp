@@ -0,0 +1,37 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+namespace mystl {
+
+// Largest element count a single allocation of T can hold: its byte size has
+// to fit in ptrdiff_t so pointer arithmetic across the buffer stays defined.
+template <typename T>
+constexpr std::size_t max_elements() {
+    return static_cast<std::size_t>(PTRDIFF_MAX) / sizeof(T);
+}
+
+// largest power of two not above n (n > 0)
+constexpr std::size_t floor_pow2(std::size_t n) {
+    std::size_t p = 1;
+    while (p <= n / 2) p *= 2;
+    return p;
+}
+
+// Capacity to move to once `current` slots are full: `initial` for an empty
+// buffer, otherwise double, clamped to `limit`. Throws length_error when the
+// buffer is already at `limit`, instead of letting the doubling wrap around.
+inline std::size_t grown_capacity(std::size_t current, std::size_t initial, std::size_t limit,
+                                  const char* what) {
+    if (current >= limit) throw std::length_error(what);
+    if (current == 0) return initial < limit ? initial : limit;
+    return current > limit / 2 ? limit : current * 2;
+}
+
+// throws length_error when a request for n slots exceeds limit
+inline void check_capacity(std::size_t n, std::size_t limit, const char* what) {
+    if (n > limit) throw std::length_error(what);
+}
+
+}
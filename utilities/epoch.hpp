@@ -0,0 +1,171 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "cache_line.hpp"
+
+namespace mystl {
+
+// Epoch-based memory reclamation for read-mostly lock-free structures.
+//
+// Readers bracket their accesses with an epoch_guard, which publishes the global
+// epoch in the thread's record with a plain store and a fence: no atomic
+// read-modify-write and no lock on the read path. Writers unlink nodes and hand
+// them to epoch_retire(); a node retired in epoch e is freed once the global
+// epoch reaches e + 2, which can only happen after every thread pinned at the
+// time has left its guard. Unlike hazard pointers a guard protects everything
+// reachable, so long traversals cost nothing per node.
+namespace epoch {
+
+constexpr int max_threads = 256;
+constexpr size_t retire_batch = 64;
+
+struct alignas(cache_line_size) Record {
+    std::atomic<bool> inUse{false};
+    // 0 while quiescent, otherwise (pinned epoch << 1) | 1
+    std::atomic<uint64_t> announced{0};
+};
+
+struct Retired {
+    void* ptr;
+    void (*deleter)(void*);
+    uint64_t epoch;
+};
+
+inline Record records[max_threads];
+inline std::atomic<int> recordsInUse{0};
+inline std::atomic<uint64_t> globalEpoch{1};
+
+// retired objects left behind by threads that exited before they could be freed
+inline std::mutex orphanMutex;
+inline std::vector<Retired> orphans;
+
+// advance the global epoch if every pinned thread has caught up with it
+inline uint64_t tryAdvance() {
+    uint64_t current = globalEpoch.load();
+    int used = recordsInUse.load();
+    for (int i = 0; i < used; i++) {
+        uint64_t a = records[i].announced.load();
+        if ((a & 1) && (a >> 1) != current) return current;
+    }
+    globalEpoch.compare_exchange_strong(current, current + 1);
+    return globalEpoch.load();
+}
+
+class ThreadState {
+public:
+    Record* record;
+    int depth = 0;
+    std::vector<Retired> limbo;
+
+    ThreadState() {
+        for (int i = 0; i < max_threads; i++) {
+            bool expected = false;
+            if (!records[i].inUse.load(std::memory_order_relaxed) &&
+                records[i].inUse.compare_exchange_strong(expected, true)) {
+                record = &records[i];
+                int used = recordsInUse.load();
+                while (used < i + 1 && !recordsInUse.compare_exchange_weak(used, i + 1)) {}
+                return;
+            }
+        }
+        throw std::runtime_error("epoch records exhausted");
+    }
+
+    ~ThreadState() {
+        record->announced.store(0);
+        collect();
+        if (!limbo.empty()) {
+            std::lock_guard<std::mutex> lock(orphanMutex);
+            orphans.insert(orphans.end(), limbo.begin(), limbo.end());
+        }
+        record->inUse.store(false);
+    }
+
+    // free whatever has aged two epochs
+    void collect() {
+        {
+            std::unique_lock<std::mutex> lock(orphanMutex, std::try_to_lock);
+            if (lock.owns_lock() && !orphans.empty()) {
+                limbo.insert(limbo.end(), orphans.begin(), orphans.end());
+                orphans.clear();
+            }
+        }
+
+        uint64_t current = tryAdvance();
+        size_t kept = 0;
+        for (size_t i = 0; i < limbo.size(); i++) {
+            if (limbo[i].epoch + 2 <= current)
+                limbo[i].deleter(limbo[i].ptr);
+            else
+                limbo[kept++] = limbo[i];
+        }
+        limbo.resize(kept);
+    }
+
+    void pin() {
+        if (depth++ == 0) {
+            record->announced.store((globalEpoch.load(std::memory_order_relaxed) << 1) | 1,
+                                    std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+    }
+
+    void unpin() {
+        if (--depth == 0)
+            record->announced.store(0, std::memory_order_release);
+    }
+};
+
+inline ThreadState& threadState() {
+    thread_local ThreadState state;
+    return state;
+}
+
+}
+
+// RAII pin of the calling thread to the current epoch. Nested and copied guards
+// are cheap: only the outermost one touches the shared record.
+class epoch_guard {
+public:
+    epoch_guard() {
+        epoch::threadState().pin();
+    }
+
+    epoch_guard(const epoch_guard&) : epoch_guard() {}
+    epoch_guard& operator=(const epoch_guard&) = default;
+
+    ~epoch_guard() {
+        epoch::threadState().unpin();
+    }
+};
+
+// free ptr with deleter once no thread can still be reading it
+inline void epoch_retire(void* ptr, void (*deleter)(void*)) {
+    epoch::ThreadState& state = epoch::threadState();
+    state.limbo.push_back({ptr, deleter, epoch::globalEpoch.load()});
+    if (state.limbo.size() >= epoch::retire_batch)
+        state.collect();
+}
+
+template <typename T>
+void epoch_retire(T* ptr) {
+    epoch_retire(ptr, [](void* p) { delete static_cast<T*>(p); });
+}
+
+// block until everything the calling thread has retired has been freed. Waits
+// for readers to leave their guards, so it must not be called while holding one.
+inline void epoch_synchronize() {
+    epoch::ThreadState& state = epoch::threadState();
+    if (state.depth > 0) throw std::runtime_error("epoch_synchronize inside epoch_guard");
+    state.collect();
+    while (!state.limbo.empty()) {
+        std::this_thread::yield();
+        state.collect();
+    }
+}
+
+}
@@ -0,0 +1,24 @@
+#pragma once
+#include <cstdint>
+
+namespace mystl {
+
+// 64-bit finalizer (from MurmurHash3) that spreads every input bit over the
+// whole word. std::hash of integers is the identity on common standard
+// libraries, which is fine for chained buckets but not for structures that
+// slice one hash into several independent indices.
+inline uint64_t mix64(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+// fold the hash of one more field into a running hash (pairs, tuples)
+inline uint64_t hash_combine(uint64_t seed, uint64_t h) {
+    return mix64(seed ^ (h + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2)));
+}
+
+}
@@ -0,0 +1,161 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+#include "cache_line.hpp"
+
+namespace mystl {
+
+// Hazard-pointer based safe memory reclamation for the lock-free containers.
+//
+// A thread that is about to dereference a shared node publishes its address in
+// one of its hazard slots first; a node removed from a structure is retired
+// rather than deleted and only freed once a scan finds no slot pointing at it.
+// This rules out both use-after-free and ABA on the protected pointer, since a
+// protected node can never be freed and handed back out by the allocator.
+namespace hazard {
+
+constexpr int max_threads = 256;
+constexpr int slots_per_thread = 2;
+
+struct alignas(cache_line_size) Record {
+    std::atomic<bool> active{false};
+    std::atomic<void*> slots[slots_per_thread] = {};
+};
+
+struct Retired {
+    void* ptr;
+    void (*deleter)(void*);
+};
+
+inline Record records[max_threads];
+inline std::atomic<int> recordsInUse{0};
+
+// retired nodes left behind by threads that exited while they were still protected
+inline std::mutex orphanMutex;
+inline std::vector<Retired> orphans;
+
+class ThreadState {
+public:
+    Record* record;
+    int usedSlots = 0;
+    std::vector<Retired> retired;
+
+    ThreadState() {
+        for (int i = 0; i < max_threads; i++) {
+            bool expected = false;
+            if (!records[i].active.load(std::memory_order_relaxed) &&
+                records[i].active.compare_exchange_strong(expected, true)) {
+                record = &records[i];
+                int used = recordsInUse.load();
+                while (used < i + 1 && !recordsInUse.compare_exchange_weak(used, i + 1)) {}
+                return;
+            }
+        }
+        throw std::runtime_error("hazard pointer records exhausted");
+    }
+
+    ~ThreadState() {
+        for (auto& slot : record->slots)
+            slot.store(nullptr);
+        scan();
+        if (!retired.empty()) {
+            std::lock_guard<std::mutex> lock(orphanMutex);
+            orphans.insert(orphans.end(), retired.begin(), retired.end());
+        }
+        record->active.store(false);
+    }
+
+    // free every retired node that no thread currently protects
+    void scan() {
+        {
+            std::unique_lock<std::mutex> lock(orphanMutex, std::try_to_lock);
+            if (lock.owns_lock() && !orphans.empty()) {
+                retired.insert(retired.end(), orphans.begin(), orphans.end());
+                orphans.clear();
+            }
+        }
+
+        std::vector<void*> protectedPtrs;
+        int used = recordsInUse.load();
+        for (int i = 0; i < used; i++) {
+            for (auto& slot : records[i].slots) {
+                if (void* p = slot.load())
+                    protectedPtrs.push_back(p);
+            }
+        }
+        std::sort(protectedPtrs.begin(), protectedPtrs.end());
+
+        std::vector<Retired> keep;
+        for (const Retired& r : retired) {
+            if (std::binary_search(protectedPtrs.begin(), protectedPtrs.end(), r.ptr))
+                keep.push_back(r);
+            else
+                r.deleter(r.ptr);
+        }
+        retired.swap(keep);
+    }
+
+    size_t scanThreshold() const {
+        return 2 * slots_per_thread * static_cast<size_t>(recordsInUse.load(std::memory_order_relaxed)) + 64;
+    }
+};
+
+inline ThreadState& threadState() {
+    thread_local ThreadState state;
+    return state;
+}
+
+}
+
+// RAII owner of one of the calling thread's hazard slots. Slots are handed out
+// and returned in LIFO order, so keep hazard_pointer objects scoped.
+class hazard_pointer {
+private:
+    std::atomic<void*>* slot;
+
+public:
+    hazard_pointer() {
+        hazard::ThreadState& state = hazard::threadState();
+        if (state.usedSlots == hazard::slots_per_thread)
+            throw std::runtime_error("hazard pointer slots exhausted");
+        slot = &state.record->slots[state.usedSlots++];
+    }
+
+    hazard_pointer(const hazard_pointer&) = delete;
+    hazard_pointer& operator=(const hazard_pointer&) = delete;
+
+    ~hazard_pointer() {
+        slot->store(nullptr, std::memory_order_release);
+        hazard::threadState().usedSlots--;
+    }
+
+    // load src and publish it, retrying until the published value is still current
+    template <typename T>
+    T* protect(const std::atomic<T*>& src) {
+        T* ptr = src.load(std::memory_order_relaxed);
+        for (;;) {
+            slot->store(ptr);
+            T* current = src.load();
+            if (current == ptr) return ptr;
+            ptr = current;
+        }
+    }
+
+    void reset() {
+        slot->store(nullptr, std::memory_order_release);
+    }
+};
+
+// hand ptr over for deletion once no hazard pointer protects it
+template <typename T>
+void retire(T* ptr) {
+    hazard::ThreadState& state = hazard::threadState();
+    state.retired.push_back({ptr, [](void* p) { delete static_cast<T*>(p); }});
+    if (state.retired.size() >= state.scanThreshold())
+        state.scan();
+}
+
+}
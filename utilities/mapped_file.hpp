@@ -0,0 +1,154 @@
+#pragma once
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace mystl {
+
+// A file mapped read-write and shared, so stores land in the page cache and
+// survive the process. The file only ever grows: grow() extends it with
+// ftruncate *before* widening the mapping (mremap on Linux), so no mapped
+// byte is ever past the end of the file, and a crash between the two steps
+// just leaves a longer file. The file is locked (flock) while open, so a
+// second opener, in this process or another, fails. Used by mmap_vector and
+// mmap_unordered_map.
+class mapped_file {
+private:
+    int fd = -1;
+    unsigned char* base = nullptr;
+    std::size_t length = 0;
+    bool fresh = false;
+
+    static constexpr std::size_t page = 4096;
+
+    [[noreturn]] static void fail(const std::string& what) {
+        throw std::runtime_error(what + ": " + std::strerror(errno));
+    }
+
+    static std::size_t roundUp(std::size_t bytes) {
+        return (bytes + page - 1) & ~(page - 1);
+    }
+
+    void release() {
+        if (base) munmap(base, length);
+        if (fd >= 0) ::close(fd);
+        base = nullptr;
+        fd = -1;
+        length = 0;
+    }
+
+public:
+    mapped_file() = default;
+
+    // open path, creating it if needed; a new or empty file is extended to
+    // initialBytes and reads back as zeros
+    mapped_file(const std::string& path, std::size_t initialBytes) {
+        fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd < 0) fail("open " + path);
+        if (flock(fd, LOCK_EX | LOCK_NB) != 0) {
+            bool busy = errno == EWOULDBLOCK;
+            release();
+            if (busy) throw std::runtime_error("open " + path + ": already open");
+            fail("flock " + path);
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            release();
+            fail("stat " + path);
+        }
+        length = static_cast<std::size_t>(st.st_size);
+        fresh = length == 0;
+        if (fresh) {
+            length = roundUp(initialBytes > 0 ? initialBytes : page);
+            if (ftruncate(fd, static_cast<off_t>(length)) != 0) {
+                release();
+                fail("ftruncate " + path);
+            }
+        }
+        void* p = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) {
+            release();
+            fail("mmap " + path);
+        }
+        base = static_cast<unsigned char*>(p);
+    }
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    mapped_file(mapped_file&& other) noexcept
+        : fd(std::exchange(other.fd, -1)), base(std::exchange(other.base, nullptr)),
+          length(std::exchange(other.length, 0)), fresh(other.fresh) {}
+
+    mapped_file& operator=(mapped_file&& other) noexcept {
+        if (this != &other) {
+            release();
+            fd = std::exchange(other.fd, -1);
+            base = std::exchange(other.base, nullptr);
+            length = std::exchange(other.length, 0);
+            fresh = other.fresh;
+        }
+        return *this;
+    }
+
+    ~mapped_file() {
+        release();
+    }
+
+    unsigned char* data() { return base; }
+    const unsigned char* data() const { return base; }
+
+    std::size_t size() const {
+        return length;
+    }
+
+    // true if the file did not exist (or was empty) when opened
+    bool created() const {
+        return fresh;
+    }
+
+    // true if the first bytes are all zero: a file whose creation stopped
+    // after the ftruncate but before its header was written
+    bool zeroed(std::size_t bytes) const {
+        for (std::size_t i = 0; i < bytes && i < length; i++) {
+            if (base[i] != 0) return false;
+        }
+        return true;
+    }
+
+    // make at least minimumBytes addressable, at least doubling; the mapping
+    // may move, so callers keep offsets rather than pointers across this call
+    void grow(std::size_t minimumBytes) {
+        if (minimumBytes <= length) return;
+        std::size_t target = length * 2 > minimumBytes ? length * 2 : minimumBytes;
+        target = roundUp(target);
+        if (ftruncate(fd, static_cast<off_t>(target)) != 0) fail("ftruncate");
+#if defined(__linux__)
+        void* p = mremap(base, length, target, MREMAP_MAYMOVE);
+        if (p == MAP_FAILED) fail("mremap");
+#else
+        void* p = mmap(nullptr, target, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) fail("mmap");
+        munmap(base, length);
+#endif
+        base = static_cast<unsigned char*>(p);
+        length = target;
+    }
+
+    // flush dirty pages to the file; needed only for durability across a
+    // machine crash, the page cache already outlives the process
+    void sync() {
+        if (base && msync(base, length, MS_SYNC) != 0) fail("msync");
+    }
+};
+
+}
@@ -0,0 +1,189 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <new>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define MYSTL_PAGE_MAPPING 1
+#else
+#define MYSTL_PAGE_MAPPING 0
+#endif
+
+namespace mystl {
+
+// Allocation policies for the large flat arrays of the containers (vector
+// storage, hash table bucket arrays). A policy is a type with
+//   static void* allocate(size_t bytes, size_t alignment);
+//   static void deallocate(void* p, size_t bytes, size_t alignment);
+// heap_allocation is the default; mapped_allocation takes whole pages straight
+// from the kernel so it can ask for huge pages and NUMA placement.
+
+struct heap_allocation {
+    static void* allocate(std::size_t bytes, std::size_t alignment) {
+        if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+            return ::operator new(bytes, std::align_val_t(alignment));
+        return ::operator new(bytes);
+    }
+
+    static void deallocate(void* p, std::size_t, std::size_t alignment) {
+        if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+            ::operator delete(p, std::align_val_t(alignment));
+        else
+            ::operator delete(p);
+    }
+};
+
+enum class numa_placement {
+    none,        // kernel default: first touch
+    local,       // preferred on the node of the allocating thread, elsewhere once it is full
+    bind_local,  // only on the node of the allocating thread; fails when it is full
+    interleave,  // pages spread round-robin over all online nodes
+};
+
+namespace pages {
+
+constexpr std::size_t huge_page_size = std::size_t(1) << 21;
+
+// arrays below this stay on the heap: a mapping costs a syscall and at least
+// one huge page, and a smaller array gains little from fewer TLB entries
+constexpr std::size_t mapping_threshold = huge_page_size;
+
+inline std::size_t roundUp(std::size_t bytes) {
+    return (bytes + huge_page_size - 1) & ~(huge_page_size - 1);
+}
+
+#if MYSTL_PAGE_MAPPING
+
+// constants from <linux/mempolicy.h>, which is not always installed
+constexpr int kMpolPreferred = 1;
+constexpr int kMpolBind = 2;
+constexpr int kMpolInterleave = 3;
+constexpr unsigned long kMaxNodes = 64;
+
+// bit mask of the online NUMA nodes, read once from sysfs ("0", "0-3", "0,2-3")
+inline unsigned long onlineNodes() {
+    static const unsigned long mask = [] {
+        unsigned long nodes = 0;
+        if (FILE* f = std::fopen("/sys/devices/system/node/online", "r")) {
+            unsigned first, last;
+            int c;
+            while (std::fscanf(f, "%u", &first) == 1) {
+                last = first;
+                c = std::fgetc(f);
+                if (c == '-' && std::fscanf(f, "%u", &last) == 1) c = std::fgetc(f);
+                for (unsigned n = first; n <= last && n < kMaxNodes; n++) nodes |= 1UL << n;
+                if (c != ',') break;
+            }
+            std::fclose(f);
+        }
+        return nodes ? nodes : 1UL;
+    }();
+    return mask;
+}
+
+// nodes is the online node mask, a parameter so tests can run the multi-node
+// path on a single-node machine
+inline void place(void* p, std::size_t bytes, numa_placement placement, unsigned long nodes) {
+    if (placement == numa_placement::none) return;
+    if ((nodes & (nodes - 1)) == 0) return;  // single node: nothing to decide
+    int mode = kMpolInterleave;
+    if (placement != numa_placement::interleave) {
+        unsigned cpu = 0, node = 0;
+        if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0 || node >= kMaxNodes) return;
+        nodes = 1UL << node;
+        // bind makes a page fault on a full node fail (SIGBUS / OOM kill)
+        // rather than fall back to another node
+        mode = placement == numa_placement::bind_local ? kMpolBind : kMpolPreferred;
+    }
+    // best effort: an unsupported policy leaves the kernel default in place
+    syscall(SYS_mbind, p, bytes, mode, &nodes, kMaxNodes + 1, 0);
+}
+
+inline void place(void* p, std::size_t bytes, numa_placement placement) {
+    place(p, bytes, placement, onlineNodes());
+}
+
+// cleared after the first MAP_HUGETLB failure (no pages reserved in
+// /proc/sys/vm/nr_hugepages) so later mappings go straight to THP
+inline std::atomic<bool>& hugetlbAvailable() {
+    static std::atomic<bool> available{true};
+    return available;
+}
+
+// huge_page_size-aligned anonymous mapping: explicit huge pages if reserved,
+// else transparent huge pages via madvise, else plain pages
+inline void* map(std::size_t bytes, bool hugePages, numa_placement placement) {
+    std::size_t length = roundUp(bytes);
+    void* p = MAP_FAILED;
+#ifdef MAP_HUGETLB
+    if (hugePages && hugetlbAvailable().load(std::memory_order_relaxed)) {
+        p = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (p == MAP_FAILED) hugetlbAvailable().store(false, std::memory_order_relaxed);
+    }
+#endif
+    if (p == MAP_FAILED) {
+        // over-map by one huge page and trim, so THP can back every 2 MB run
+        void* raw = mmap(nullptr, length + huge_page_size, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED) throw std::bad_alloc();
+        auto start = reinterpret_cast<std::uintptr_t>(raw);
+        auto aligned = (start + huge_page_size - 1) & ~(huge_page_size - 1);
+        if (aligned > start) munmap(raw, aligned - start);
+        std::size_t tail = start + length + huge_page_size - (aligned + length);
+        if (tail) munmap(reinterpret_cast<void*>(aligned + length), tail);
+        p = reinterpret_cast<void*>(aligned);
+#ifdef MADV_HUGEPAGE
+        if (hugePages) madvise(p, length, MADV_HUGEPAGE);
+#endif
+    }
+    // placement applies to pages not yet touched, i.e. all of them
+    place(p, length, placement);
+    return p;
+}
+
+inline void unmap(void* p, std::size_t bytes) {
+    munmap(p, roundUp(bytes));
+}
+
+#endif
+
+}
+
+// Page-mapped allocation for large arrays: huge pages cut TLB misses on
+// random access over gigabyte-sized tables, NUMA placement avoids
+// cross-socket traffic. Requests under pages::mapping_threshold, and every
+// request on non-Linux builds, fall back to heap_allocation.
+template <bool HugePages, numa_placement Placement = numa_placement::none>
+struct mapped_allocation {
+    static void* allocate(std::size_t bytes, std::size_t alignment) {
+#if MYSTL_PAGE_MAPPING
+        if (bytes >= pages::mapping_threshold && alignment <= pages::huge_page_size)
+            return pages::map(bytes, HugePages, Placement);
+#endif
+        return heap_allocation::allocate(bytes, alignment);
+    }
+
+    static void deallocate(void* p, std::size_t bytes, std::size_t alignment) {
+#if MYSTL_PAGE_MAPPING
+        if (bytes >= pages::mapping_threshold && alignment <= pages::huge_page_size) {
+            pages::unmap(p, bytes);
+            return;
+        }
+#endif
+        heap_allocation::deallocate(p, bytes, alignment);
+    }
+};
+
+template <numa_placement Placement = numa_placement::none>
+using huge_page_allocation = mapped_allocation<true, Placement>;
+
+template <numa_placement Placement>
+using numa_allocation = mapped_allocation<false, Placement>;
+
+}
@@ -1,62 +1,154 @@
 #pragma once
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include "hash_mix.hpp"
+
+// Empty member types (comparators, hashers, tags) take no space in a pair
+// where the compiler supports it.
+#if defined(__has_cpp_attribute)
+#if __has_cpp_attribute(no_unique_address)
+#define MYSTL_NO_UNIQUE_ADDRESS [[no_unique_address]]
+#endif
+#endif
+#ifndef MYSTL_NO_UNIQUE_ADDRESS
+#define MYSTL_NO_UNIQUE_ADDRESS
+#endif
 
 namespace mystl {
 
+// Copy and move are defaulted, so a pair of trivially copyable members is
+// itself trivially copyable and containers may relocate it with memcpy.
 template <typename T1, typename T2>
 class pair {
 public:
-    T1 first;
-    T2 second;
-    
-    pair() : first(), second() {}
+    MYSTL_NO_UNIQUE_ADDRESS T1 first;
+    MYSTL_NO_UNIQUE_ADDRESS T2 second;
+
+    constexpr pair() : first(), second() {}
+
+    constexpr pair(const T1& a, const T2& b) : first(a), second(b) {}
+
+    template <typename U1, typename U2,
+              std::enable_if_t<std::is_constructible<T1, U1&&>::value &&
+                               std::is_constructible<T2, U2&&>::value, int> = 0>
+    constexpr pair(U1&& a, U2&& b) : first(std::forward<U1>(a)), second(std::forward<U2>(b)) {}
 
-    pair(const T1& a, const T2& b) : first(a), second(b) {}
+    template <typename U1, typename U2,
+              std::enable_if_t<std::is_constructible<T1, const U1&>::value &&
+                               std::is_constructible<T2, const U2&>::value, int> = 0>
+    constexpr pair(const pair<U1, U2>& other) : first(other.first), second(other.second) {}
 
-    pair(const pair<T1, T2>& other) : first(other.first), second(other.second) {}
+    template <typename U1, typename U2,
+              std::enable_if_t<std::is_constructible<T1, U1&&>::value &&
+                               std::is_constructible<T2, U2&&>::value, int> = 0>
+    constexpr pair(pair<U1, U2>&& other)
+        : first(std::forward<U1>(other.first)), second(std::forward<U2>(other.second)) {}
 
-    pair& operator=(const pair<T1, T2>& other) {
-        if (this != &other) {
-            first = other.first;
-            second = other.second;
-        }
-        return *this;
+    pair(const pair&) = default;
+    pair(pair&&) = default;
+    pair& operator=(const pair&) = default;
+    pair& operator=(pair&&) = default;
+
+    void swap(pair& other) noexcept(std::is_nothrow_swappable<T1>::value &&
+                                    std::is_nothrow_swappable<T2>::value) {
+        using std::swap;
+        swap(first, other.first);
+        swap(second, other.second);
     }
 };
 
+template <typename T1, typename T2>
+void swap(pair<T1, T2>& a, pair<T1, T2>& b) noexcept(noexcept(a.swap(b))) {
+    a.swap(b);
+}
+
 // Comparison operators
 template <typename T1, typename T2>
-bool operator==(const pair<T1, T2>& lhs, const pair<T1, T2>& rhs) {
+constexpr bool operator==(const pair<T1, T2>& lhs, const pair<T1, T2>& rhs) {
     return lhs.first == rhs.first && lhs.second == rhs.second;
 }
 
 template <typename T1, typename T2>
-bool operator!=(const pair<T1, T2>& lhs, const pair<T1, T2>& rhs) {
+constexpr bool operator!=(const pair<T1, T2>& lhs, const pair<T1, T2>& rhs) {
     return !(lhs == rhs);
 }
 
 template <typename T1, typename T2>
-bool operator<(const pair<T1, T2>& lhs, const pair<T1, T2>& rhs) {
+constexpr bool operator<(const pair<T1, T2>& lhs, const pair<T1, T2>& rhs) {
     return lhs.first < rhs.first || (!(rhs.first < lhs.first) && lhs.second < rhs.second);
 }
 
 template <typename T1, typename T2>
-bool operator<=(const pair<T1, T2>& lhs, const pair<T1, T2>& rhs) {
+constexpr bool operator<=(const pair<T1, T2>& lhs, const pair<T1, T2>& rhs) {
     return !(rhs < lhs);
 }
 
 template <typename T1, typename T2>
-bool operator>(const pair<T1, T2>& lhs, const pair<T1, T2>& rhs) {
+constexpr bool operator>(const pair<T1, T2>& lhs, const pair<T1, T2>& rhs) {
     return rhs < lhs;
 }
 
 template <typename T1, typename T2>
-bool operator>=(const pair<T1, T2>& lhs, const pair<T1, T2>& rhs) {
+constexpr bool operator>=(const pair<T1, T2>& lhs, const pair<T1, T2>& rhs) {
     return !(lhs < rhs);
 }
 
+// arguments are decayed and forwarded, so make_pair(s, "x") moves nothing it
+// shouldn't and copies nothing it needn't
 template <typename T1, typename T2>
-pair<T1, T2> make_pair(const T1& a, const T2& b) {
-    return pair<T1, T2>(a, b);
+constexpr pair<std::decay_t<T1>, std::decay_t<T2>> make_pair(T1&& a, T2&& b) {
+    return pair<std::decay_t<T1>, std::decay_t<T2>>(std::forward<T1>(a), std::forward<T2>(b));
+}
+
+// get<0> / get<1>, which together with the std::tuple_size specialization
+// below makes `auto [key, value] = p;` work
+template <std::size_t N, typename T1, typename T2>
+constexpr auto& get(pair<T1, T2>& p) noexcept {
+    static_assert(N < 2, "pair index out of range");
+    if constexpr (N == 0) return p.first;
+    else return p.second;
+}
+
+template <std::size_t N, typename T1, typename T2>
+constexpr const auto& get(const pair<T1, T2>& p) noexcept {
+    static_assert(N < 2, "pair index out of range");
+    if constexpr (N == 0) return p.first;
+    else return p.second;
+}
+
+template <std::size_t N, typename T1, typename T2>
+constexpr auto&& get(pair<T1, T2>&& p) noexcept {
+    static_assert(N < 2, "pair index out of range");
+    if constexpr (N == 0) return std::forward<T1>(p.first);
+    else return std::forward<T2>(p.second);
+}
+
+static_assert(std::is_trivially_copyable<pair<int, double>>::value,
+              "pair of trivially copyable members must be trivially copyable");
+static_assert(std::is_nothrow_move_constructible<pair<int, std::nullptr_t>>::value,
+              "pair must be nothrow movable when its members are");
+
 }
 
+namespace std {
+
+template <typename T1, typename T2>
+struct tuple_size<mystl::pair<T1, T2>> : std::integral_constant<std::size_t, 2> {};
+
+template <std::size_t N, typename T1, typename T2>
+struct tuple_element<N, mystl::pair<T1, T2>> {
+    static_assert(N < 2, "pair index out of range");
+    using type = std::conditional_t<N == 0, T1, T2>;
+};
+
+template <typename T1, typename T2>
+struct hash<mystl::pair<T1, T2>> {
+    std::size_t operator()(const mystl::pair<T1, T2>& p) const {
+        return static_cast<std::size_t>(
+            mystl::hash_combine(std::hash<T1>{}(p.first), std::hash<T2>{}(p.second)));
+    }
+};
+
 }
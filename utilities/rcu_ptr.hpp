@@ -0,0 +1,108 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include "epoch.hpp"
+
+namespace mystl {
+
+// Read-copy-update publication of a read-mostly object, typically a lookup
+// table that is read constantly and rebuilt now and then.
+//
+// Readers pin an epoch and load the current version: no lock and no atomic
+// read-modify-write, so reads scale with the number of cores. Writers build a
+// complete new version off to the side and publish() it with a single pointer
+// swap; the version it replaces is retired through utilities/epoch.hpp and
+// freed once every reader that could still see it has moved on. Readers only
+// ever get a const view, so a published version is never modified in place.
+template <typename T>
+class rcu_ptr {
+private:
+    std::atomic<T*> current;
+    std::mutex writeLock;
+
+    void swapIn(T* next) {
+        T* old = current.exchange(next, std::memory_order_acq_rel);
+        if (old) epoch_retire(old);
+        // writers are rare, so nudge reclamation forward on every publish
+        // rather than waiting for a full retire batch of large tables
+        epoch::threadState().collect();
+    }
+
+public:
+    // A pinned view of one version. The version stays alive for as long as the
+    // handle does, even if newer ones are published meanwhile; keep handles
+    // short-lived so old versions can be reclaimed.
+    class read_handle {
+    private:
+        epoch_guard guard;
+        const T* ptr;
+
+    public:
+        explicit read_handle(const std::atomic<T*>& source)
+            : ptr(source.load(std::memory_order_acquire)) {}
+
+        const T* get() const { return ptr; }
+        const T& operator*() const { return *ptr; }
+        const T* operator->() const { return ptr; }
+        explicit operator bool() const { return ptr != nullptr; }
+    };
+
+    rcu_ptr() : current(nullptr) {}
+
+    explicit rcu_ptr(std::unique_ptr<T> initial) : current(initial.release()) {}
+
+    rcu_ptr(const rcu_ptr&) = delete;
+    rcu_ptr& operator=(const rcu_ptr&) = delete;
+
+    // no reader may still hold a handle
+    ~rcu_ptr() {
+        delete current.load(std::memory_order_relaxed);
+    }
+
+    read_handle read() const {
+        return read_handle(current);
+    }
+
+    // run fn on the current version while pinned and return its result.
+    // Throws std::out_of_range if nothing has been published (or nullptr was);
+    // use read() and test the handle where that is expected.
+    template <typename Fn>
+    auto read(Fn&& fn) const {
+        epoch_guard guard;
+        const T* version = current.load(std::memory_order_acquire);
+        if (!version) throw std::out_of_range("rcu_ptr is empty");
+        return fn(*version);
+    }
+
+    // replace the current version; readers see either the old one or next
+    void publish(std::unique_ptr<T> next) {
+        std::lock_guard<std::mutex> lock(writeLock);
+        swapIn(next.release());
+    }
+
+    template <typename... Args>
+    void emplace(Args&&... args) {
+        publish(std::make_unique<T>(std::forward<Args>(args)...));
+    }
+
+    // copy the current version, let fn modify the copy, then publish it.
+    // Concurrent update() calls are serialized so none of them is lost.
+    template <typename Fn>
+    void update(Fn&& fn) {
+        std::lock_guard<std::mutex> lock(writeLock);
+        T* old = current.load(std::memory_order_acquire);
+        std::unique_ptr<T> next = old ? std::make_unique<T>(*old) : std::make_unique<T>();
+        fn(*next);
+        swapIn(next.release());
+    }
+
+    // wait until every version this thread has replaced has been freed
+    void synchronize() {
+        epoch_synchronize();
+    }
+};
+
+}
@@ -0,0 +1,373 @@
+#pragma once
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+// the file descriptor overloads need POSIX read/write/lseek
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#define MYSTL_FD_SERIALIZATION 1
+#else
+#define MYSTL_FD_SERIALIZATION 0
+#endif
+
+#include "pair.hpp"
+#include "tuple.hpp"
+
+namespace mystl {
+
+// Binary serialization for the containers, pair and tuple:
+//
+//   mystl::serialize(out, container);                  // std::ostream& or fd
+//   auto copy = mystl::deserialize<Container>(in);     // std::istream& or fd
+//
+// (the fd overloads exist on POSIX builds only). Documents can be written
+// back to back and read back one deserialize() call each.
+//
+// Layout, host byte order: an 8-byte header (magic, format version, container
+// tag) then the payload. Counts are uint64_t. Trivially copyable elements are
+// written as raw bytes, and a run of them in one block, so a vector<double>
+// is one header, one count and one write. Other elements recurse, so a
+// map<string, vector<int>> works as well. Files are only portable between
+// builds with the same element layout and endianness.
+//
+// Each container header defines serial::codec<Container> next to the class.
+namespace serial {
+
+constexpr uint32_t magic = 0x4c54534d;  // "MSTL"
+constexpr uint16_t version = 1;
+
+// container tags in the header
+enum : uint8_t {
+    tag_vector = 1,
+    tag_string,
+    tag_map,
+    tag_set,
+    tag_unordered_map,
+    tag_unordered_set,
+    tag_deque,
+    tag_pair,
+    tag_tuple,
+};
+
+struct header {
+    uint32_t magic;
+    uint16_t version;
+    uint8_t tag;
+    uint8_t reserved;
+};
+
+// codec<T> has
+//   static constexpr uint8_t tag;
+//   template <typename Sink> static void write(Sink&, const T&);
+//   template <typename Source> static T read(Source&);
+template <typename T>
+struct codec;
+
+// written as their bytes; pointers are excluded since the address would not
+// mean anything to the reader
+template <typename T>
+constexpr bool is_raw = std::is_trivially_copyable<T>::value && !std::is_pointer<T>::value;
+
+// goes to the stream buffer directly: ostream::write builds a sentry per call,
+// which dominates when a map is written 8 bytes at a time
+class stream_sink {
+    std::ostream& out;
+
+public:
+    explicit stream_sink(std::ostream& out) : out(out) {}
+
+    void write(const void* data, std::size_t bytes) {
+        auto n = static_cast<std::streamsize>(bytes);
+        if (!out.rdbuf() || out.rdbuf()->sputn(static_cast<const char*>(data), n) != n) {
+            out.setstate(std::ios::badbit);
+            throw std::runtime_error("serialize: write failed");
+        }
+    }
+
+    void flush() {
+        out.flush();
+    }
+};
+
+class stream_source {
+    std::istream& in;
+
+public:
+    explicit stream_source(std::istream& in) : in(in) {}
+
+    void read(void* data, std::size_t bytes) {
+        auto n = static_cast<std::streamsize>(bytes);
+        if (!in.rdbuf() || in.rdbuf()->sgetn(static_cast<char*>(data), n) != n) {
+            in.setstate(std::ios::eofbit | std::ios::failbit);
+            throw std::runtime_error("deserialize: truncated input");
+        }
+    }
+
+    void finish() {}
+};
+
+#if MYSTL_FD_SERIALIZATION
+
+constexpr std::size_t fd_buffer_bytes = std::size_t(1) << 16;
+
+// buffers small writes; blocks of a buffer or more go straight to write(2)
+class fd_sink {
+    int fd;
+    std::unique_ptr<char[]> buffer;
+    std::size_t used = 0;
+
+    void writeAll(const char* data, std::size_t bytes) {
+        while (bytes > 0) {
+            ssize_t n = ::write(fd, data, bytes);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                throw std::runtime_error(std::string("serialize: ") + std::strerror(errno));
+            }
+            data += n;
+            bytes -= static_cast<std::size_t>(n);
+        }
+    }
+
+public:
+    explicit fd_sink(int fd) : fd(fd), buffer(new char[fd_buffer_bytes]) {}
+
+    void write(const void* data, std::size_t bytes) {
+        if (used + bytes > fd_buffer_bytes) flush();
+        if (bytes >= fd_buffer_bytes) {
+            writeAll(static_cast<const char*>(data), bytes);
+        } else {
+            std::memcpy(buffer.get() + used, data, bytes);
+            used += bytes;
+        }
+    }
+
+    void flush() {
+        writeAll(buffer.get(), used);
+        used = 0;
+    }
+};
+
+// Reads ahead a buffer at a time on seekable fds and seeks back over the
+// unconsumed bytes in finish(), so the fd ends just past the document. Pipes
+// and sockets cannot seek back, so they are read exactly as requested.
+class fd_source {
+    int fd;
+    bool seekable;
+    std::unique_ptr<char[]> buffer;
+    std::size_t position = 0;
+    std::size_t filled = 0;
+
+    std::size_t readSome(char* data, std::size_t bytes) {
+        for (;;) {
+            ssize_t n = ::read(fd, data, bytes);
+            if (n > 0) return static_cast<std::size_t>(n);
+            if (n == 0) throw std::runtime_error("deserialize: truncated input");
+            if (errno != EINTR) throw std::runtime_error(std::string("deserialize: ") + std::strerror(errno));
+        }
+    }
+
+    void readExactly(char* data, std::size_t bytes) {
+        while (bytes > 0) {
+            std::size_t n = readSome(data, bytes);
+            data += n;
+            bytes -= n;
+        }
+    }
+
+public:
+    explicit fd_source(int fd)
+        : fd(fd), seekable(::lseek(fd, 0, SEEK_CUR) >= 0),
+          buffer(seekable ? new char[fd_buffer_bytes] : nullptr) {}
+
+    void read(void* data, std::size_t bytes) {
+        char* out = static_cast<char*>(data);
+        if (!seekable) {
+            readExactly(out, bytes);
+            return;
+        }
+        std::size_t buffered = filled - position;
+        if (buffered >= bytes) {
+            std::memcpy(out, buffer.get() + position, bytes);
+            position += bytes;
+            return;
+        }
+        std::memcpy(out, buffer.get() + position, buffered);
+        out += buffered;
+        bytes -= buffered;
+        position = filled = 0;
+        if (bytes >= fd_buffer_bytes) {
+            readExactly(out, bytes);
+            return;
+        }
+        while (filled < bytes) filled += readSome(buffer.get() + filled, fd_buffer_bytes - filled);
+        std::memcpy(out, buffer.get(), bytes);
+        position = bytes;
+    }
+
+    // hand back the bytes read ahead but not consumed
+    void finish() {
+        if (filled > position) {
+            if (::lseek(fd, -static_cast<off_t>(filled - position), SEEK_CUR) < 0)
+                throw std::runtime_error(std::string("deserialize: ") + std::strerror(errno));
+        }
+        position = filled = 0;
+    }
+};
+
+#endif
+
+template <typename Sink, typename T>
+void write_value(Sink& sink, const T& value) {
+    if constexpr (is_raw<T>) {
+        sink.write(&value, sizeof(T));
+    } else {
+        codec<T>::write(sink, value);
+    }
+}
+
+template <typename T, typename Source>
+T read_value(Source& source) {
+    if constexpr (is_raw<T>) {
+        T value;
+        source.read(&value, sizeof(T));
+        return value;
+    } else {
+        return codec<T>::read(source);
+    }
+}
+
+template <typename Sink>
+void write_count(Sink& sink, std::size_t n) {
+    uint64_t count = n;
+    sink.write(&count, sizeof(count));
+}
+
+template <typename Source>
+std::size_t read_count(Source& source, std::size_t limit) {
+    uint64_t count;
+    source.read(&count, sizeof(count));
+    if (count > limit) throw std::runtime_error("deserialize: element count exceeds max_size");
+    return static_cast<std::size_t>(count);
+}
+
+// n contiguous elements: one write when they are raw
+template <typename Sink, typename T>
+void write_array(Sink& sink, const T* data, std::size_t n) {
+    if constexpr (is_raw<T>) {
+        if (n) sink.write(data, n * sizeof(T));
+    } else {
+        for (std::size_t i = 0; i < n; i++) write_value(sink, data[i]);
+    }
+}
+
+// into n constructed elements
+template <typename Source, typename T>
+void read_array(Source& source, T* data, std::size_t n) {
+    if constexpr (is_raw<T>) {
+        if (n) source.read(data, n * sizeof(T));
+    } else {
+        for (std::size_t i = 0; i < n; i++) data[i] = read_value<T>(source);
+    }
+}
+
+template <typename T, typename Sink>
+void write_document(Sink& sink, const T& value) {
+    header h{magic, version, codec<T>::tag, 0};
+    sink.write(&h, sizeof(h));
+    codec<T>::write(sink, value);
+    sink.flush();
+}
+
+template <typename T, typename Source>
+T read_document(Source& source) {
+    header h;
+    source.read(&h, sizeof(h));
+    if (h.magic != magic) throw std::runtime_error("deserialize: not mystl serialized data");
+    if (h.version != version) throw std::runtime_error("deserialize: unsupported format version");
+    if (h.tag != codec<T>::tag) throw std::runtime_error("deserialize: data holds a different container");
+    T value = codec<T>::read(source);
+    source.finish();
+    return value;
+}
+
+template <typename T1, typename T2>
+struct codec<pair<T1, T2>> {
+    static constexpr uint8_t tag = tag_pair;
+
+    template <typename Sink>
+    static void write(Sink& sink, const pair<T1, T2>& p) {
+        write_value(sink, p.first);
+        write_value(sink, p.second);
+    }
+
+    // braced initialization reads first, then second
+    template <typename Source>
+    static pair<T1, T2> read(Source& source) {
+        return pair<T1, T2>{read_value<T1>(source), read_value<T2>(source)};
+    }
+};
+
+template <typename... Types>
+struct codec<tuple<Types...>> {
+    static constexpr uint8_t tag = tag_tuple;
+
+    template <typename Sink>
+    static void write(Sink& sink, const tuple<Types...>& t) {
+        writeElements(sink, t, std::index_sequence_for<Types...>{});
+    }
+
+    template <typename Source>
+    static tuple<Types...> read(Source& source) {
+        return tuple<Types...>{read_value<Types>(source)...};
+    }
+
+private:
+    template <typename Sink, std::size_t... I>
+    static void writeElements(Sink& sink, const tuple<Types...>& t, std::index_sequence<I...>) {
+        (write_value(sink, mystl::get<I>(t)), ...);
+    }
+};
+
+}
+
+template <typename T>
+void serialize(std::ostream& out, const T& value) {
+    serial::stream_sink sink(out);
+    serial::write_document(sink, value);
+}
+
+
+template <typename T>
+T deserialize(std::istream& in) {
+    serial::stream_source source(in);
+    return serial::read_document<T>(source);
+}
+
+#if MYSTL_FD_SERIALIZATION
+
+// writes to a file descriptor from its current offset; fd stays open
+template <typename T>
+void serialize(int fd, const T& value) {
+    serial::fd_sink sink(fd);
+    serial::write_document(sink, value);
+}
+
+// reads one document from the current offset and leaves fd just past it
+template <typename T>
+T deserialize(int fd) {
+    serial::fd_source source(fd);
+    return serial::read_document<T>(source);
+}
+
+#endif
+
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+namespace mystl {
+
+// Non-owning view of a contiguous run of T: a pointer and a length. Element
+// access is unchecked, like a raw array, so loops over a span vectorize.
+template <typename T>
+class span {
+private:
+    T* ptr;
+    std::size_t count;
+
+public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using iterator = T*;
+
+    constexpr span() noexcept : ptr(nullptr), count(0) {}
+
+    constexpr span(T* data, std::size_t size) noexcept : ptr(data), count(size) {}
+
+    // span<T> -> span<const T>
+    template <typename U, std::enable_if_t<std::is_convertible<U (*)[], T (*)[]>::value, int> = 0>
+    constexpr span(const span<U>& other) noexcept : ptr(other.data()), count(other.size()) {}
+
+    constexpr T* data() const noexcept {
+        return ptr;
+    }
+
+    constexpr std::size_t size() const noexcept {
+        return count;
+    }
+
+    constexpr std::size_t size_bytes() const noexcept {
+        return count * sizeof(T);
+    }
+
+    constexpr bool empty() const noexcept {
+        return count == 0;
+    }
+
+    constexpr T& operator[](std::size_t index) const noexcept {
+        return ptr[index];
+    }
+
+    constexpr T& front() const noexcept {
+        return ptr[0];
+    }
+
+    constexpr T& back() const noexcept {
+        return ptr[count - 1];
+    }
+
+    constexpr iterator begin() const noexcept {
+        return ptr;
+    }
+
+    constexpr iterator end() const noexcept {
+        return ptr + count;
+    }
+
+    // elements [offset, offset + length), clamped to the end of the span
+    span subspan(std::size_t offset, std::size_t length = static_cast<std::size_t>(-1)) const {
+        if (offset > count) throw std::out_of_range("subspan offset out of bounds");
+        std::size_t rest = count - offset;
+        return span(ptr + offset, length < rest ? length : rest);
+    }
+};
+
+}
@@ -0,0 +1,200 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "../containers/queue.hpp"
+#include "../containers/work_stealing_deque.hpp"
+
+namespace mystl {
+
+// Work-stealing thread pool.
+//
+// Every worker owns a work_stealing_deque: tasks submitted from a worker go to
+// the bottom of its own deque, idle workers steal from the top of the others.
+// Tasks submitted from outside the pool land in a shared, mutex-guarded
+// injection queue. wait_until lets a thread keep executing tasks while it waits,
+// which is what makes recursive fork-join (see task_group) deadlock free.
+class thread_pool {
+private:
+    using Task = std::function<void()>;
+
+    struct Worker {
+        work_stealing_deque<Task*> tasks;
+        std::thread thread;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    mystl::queue<Task*> injected;
+    std::mutex injectedMutex;
+    std::atomic<bool> hasInjected{false};
+
+    std::mutex sleepMutex;
+    std::condition_variable wakeUp;
+    std::atomic<int> sleepers{0};
+    std::atomic<bool> stopping{false};
+
+    static constexpr int kIdleSpins = 64;
+
+    struct Current {
+        thread_pool* pool = nullptr;
+        size_t index = 0;
+    };
+
+    static Current& current() {
+        thread_local Current c;
+        return c;
+    }
+
+    Task* takeInjected() {
+        if (!hasInjected.load(std::memory_order_acquire)) return nullptr;
+        std::lock_guard<std::mutex> lock(injectedMutex);
+        Task* task = nullptr;
+        injected.try_pop(task);
+        hasInjected.store(!injected.empty(), std::memory_order_release);
+        return task;
+    }
+
+    // own deque first, then the injection queue, then steal starting at a random victim
+    Task* findTask(size_t self, bool isWorker, size_t& seed) {
+        Task* task = nullptr;
+        if (isWorker && workers[self]->tasks.try_pop(task)) return task;
+        if ((task = takeInjected())) return task;
+
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        size_t n = workers.size();
+        size_t start = seed % n;
+        for (size_t i = 0; i < n; i++) {
+            size_t victim = (start + i) % n;
+            if (isWorker && victim == self) continue;
+            if (workers[victim]->tasks.try_steal(task)) return task;
+        }
+        return nullptr;
+    }
+
+    static void execute(Task* task) {
+        (*task)();
+        delete task;
+    }
+
+    void notify() {
+        if (sleepers.load(std::memory_order_acquire) > 0)
+            wakeUp.notify_one();
+    }
+
+    void workerLoop(size_t index) {
+        current() = {this, index};
+        size_t seed = index * 0x9E3779B97F4A7C15ull + 1;
+        int idle = 0;
+        while (true) {
+            if (Task* task = findTask(index, true, seed)) {
+                execute(task);
+                idle = 0;
+                continue;
+            }
+            if (stopping.load(std::memory_order_acquire)) break;
+            if (++idle < kIdleSpins) {
+                std::this_thread::yield();
+                continue;
+            }
+            // the timeout bounds the cost of a wake-up racing with going to sleep
+            sleepers.fetch_add(1, std::memory_order_acq_rel);
+            {
+                std::unique_lock<std::mutex> lock(sleepMutex);
+                wakeUp.wait_for(lock, std::chrono::milliseconds(1));
+            }
+            sleepers.fetch_sub(1, std::memory_order_acq_rel);
+            idle = 0;
+        }
+        current() = {};
+    }
+
+public:
+    explicit thread_pool(size_t threads = std::thread::hardware_concurrency()) {
+        if (threads == 0) threads = 1;
+        for (size_t i = 0; i < threads; i++)
+            workers.push_back(std::make_unique<Worker>());
+        for (size_t i = 0; i < threads; i++)
+            workers[i]->thread = std::thread([this, i] { workerLoop(i); });
+    }
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    // runs every task already submitted, then joins the workers
+    ~thread_pool() {
+        stopping.store(true, std::memory_order_release);
+        wakeUp.notify_all();
+        for (auto& w : workers)
+            w->thread.join();
+    }
+
+    template <typename F>
+    void submit(F&& f) {
+        Task* task = new Task(std::forward<F>(f));
+        Current& c = current();
+        if (c.pool == this) {
+            workers[c.index]->tasks.push(task);
+        } else {
+            std::lock_guard<std::mutex> lock(injectedMutex);
+            injected.push(task);
+            hasInjected.store(true, std::memory_order_release);
+        }
+        notify();
+    }
+
+    // execute pool tasks on the calling thread until done() returns true
+    template <typename Pred>
+    void wait_until(Pred done) {
+        Current& c = current();
+        bool isWorker = c.pool == this;
+        size_t seed = reinterpret_cast<size_t>(&c) | 1;
+        while (!done()) {
+            if (Task* task = findTask(c.index, isWorker, seed))
+                execute(task);
+            else
+                std::this_thread::yield();
+        }
+    }
+
+    size_t size() const {
+        return workers.size();
+    }
+};
+
+// Fork-join helper: run() forks a task onto the pool, wait() joins all of them
+// while helping to execute pool work.
+class task_group {
+private:
+    thread_pool& pool;
+    std::atomic<int> pending{0};
+
+public:
+    explicit task_group(thread_pool& pool) : pool(pool) {}
+
+    ~task_group() {
+        wait();
+    }
+
+    template <typename F>
+    void run(F&& f) {
+        pending.fetch_add(1, std::memory_order_relaxed);
+        pool.submit([this, fn = std::forward<F>(f)]() mutable {
+            fn();
+            pending.fetch_sub(1, std::memory_order_release);
+        });
+    }
+
+    void wait() {
+        pool.wait_until([this] { return pending.load(std::memory_order_acquire) == 0; });
+    }
+};
+
+}
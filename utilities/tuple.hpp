@@ -1,73 +1,238 @@
 #pragma once
 #include <cstddef>
+#include <functional>
+#include <type_traits>
 #include <utility>
+#include "hash_mix.hpp"
 
 namespace mystl {
 
-template <std::size_t Index, typename T>
+template <typename... Types>
+class tuple;
+
+// Storage for one element. Empty, non-final element types are inherited
+// instead of stored, so stateless members (comparators, allocators, tags)
+// add nothing to sizeof(tuple).
+template <std::size_t Index, typename T,
+          bool Compress = std::is_empty<T>::value && !std::is_final<T>::value>
 struct tuple_leaf {
     T value;
 
-    tuple_leaf() = default;
+    constexpr tuple_leaf() : value() {}
 
     template <typename U>
-    tuple_leaf(U&& val) : value(std::forward<U>(val)) {}
+    constexpr tuple_leaf(std::in_place_t, U&& val) : value(std::forward<U>(val)) {}
+
+    constexpr T& element() noexcept { return value; }
+    constexpr const T& element() const noexcept { return value; }
 };
 
-template <std::size_t Index, typename... Types>
+template <std::size_t Index, typename T>
+struct tuple_leaf<Index, T, true> : private T {
+    constexpr tuple_leaf() : T() {}
+
+    template <typename U>
+    constexpr tuple_leaf(std::in_place_t, U&& val) : T(std::forward<U>(val)) {}
+
+    constexpr T& element() noexcept { return *this; }
+    constexpr const T& element() const noexcept { return *this; }
+};
+
+// All leaves are direct bases, each tagged with its index so that two
+// elements of the same type stay distinct.
+template <typename Indices, typename... Types>
 struct tuple_impl;
 
-template <std::size_t Index, typename Head, typename... Tail>
-struct tuple_impl<Index, Head, Tail...>
-    : public tuple_leaf<Index, Head>,
-      public tuple_impl<Index + 1, Tail...> {
+template <std::size_t... Indices, typename... Types>
+struct tuple_impl<std::index_sequence<Indices...>, Types...>
+    : public tuple_leaf<Indices, Types>... {
 
-    tuple_impl() = default;
+    constexpr tuple_impl() = default;
 
-    template <typename H, typename... T>
-    tuple_impl(H&& h, T&&... t)
-        : tuple_leaf<Index, Head>(std::forward<H>(h)),
-          tuple_impl<Index + 1, Tail...>(std::forward<T>(t)...) {}
+    template <typename... Args>
+    constexpr tuple_impl(std::in_place_t, Args&&... args)
+        : tuple_leaf<Indices, Types>(std::in_place, std::forward<Args>(args))... {}
 };
 
+template <std::size_t N, typename Head, typename... Tail>
+struct tuple_type_at : tuple_type_at<N - 1, Tail...> {};
+
+template <typename Head, typename... Tail>
+struct tuple_type_at<0, Head, Tail...> {
+    using type = Head;
+};
+
+// true when tuple<Types...> can be built element-wise from Args...
+template <bool SameArity, typename Tuple, typename... Args>
+struct tuple_constructible : std::false_type {};
+
+template <typename... Types, typename... Args>
+struct tuple_constructible<true, tuple<Types...>, Args...>
+    : std::conjunction<std::is_constructible<Types, Args&&>...> {};
 
-template <std::size_t Index>
-struct tuple_impl<Index> {};
+// keeps the forwarding constructor of a one-element tuple from hijacking
+// copies of the tuple itself
+template <typename Tuple, typename... Args>
+struct tuple_not_self : std::true_type {};
 
+template <typename Tuple, typename Arg>
+struct tuple_not_self<Tuple, Arg>
+    : std::bool_constant<!std::is_same<std::decay_t<Arg>, Tuple>::value> {};
 
+// Copy and move are defaulted, so a tuple of trivially copyable members is
+// itself trivially copyable.
 template <typename... Types>
-class tuple : public tuple_impl<0, Types...> {
-public:
-    tuple() = default;
+class tuple : public tuple_impl<std::index_sequence_for<Types...>, Types...> {
+    using base = tuple_impl<std::index_sequence_for<Types...>, Types...>;
 
-    template <typename... Args>
-    tuple(Args&&... args)
-        : tuple_impl<0, Types...>(std::forward<Args>(args)...) {}
+public:
+    constexpr tuple() = default;
+
+    template <bool NonEmpty = (sizeof...(Types) > 0), std::enable_if_t<NonEmpty, int> = 0>
+    constexpr tuple(const Types&... args) : base(std::in_place, args...) {}
+
+    template <typename... Args,
+              std::enable_if_t<(sizeof...(Args) > 0) &&
+                               tuple_not_self<tuple, Args...>::value &&
+                               tuple_constructible<sizeof...(Args) == sizeof...(Types),
+                                                   tuple, Args...>::value, int> = 0>
+    constexpr tuple(Args&&... args) : base(std::in_place, std::forward<Args>(args)...) {}
+
+    tuple(const tuple&) = default;
+    tuple(tuple&&) = default;
+    tuple& operator=(const tuple&) = default;
+    tuple& operator=(tuple&&) = default;
+
+    void swap(tuple& other) {
+        swapLeaves(other, std::index_sequence_for<Types...>{});
+    }
+
+private:
+    template <std::size_t... Indices>
+    void swapLeaves(tuple& other, std::index_sequence<Indices...>) {
+        using std::swap;
+        (swap(static_cast<tuple_leaf<Indices, Types>&>(*this).element(),
+              static_cast<tuple_leaf<Indices, Types>&>(other).element()), ...);
+    }
 };
 
-template <std::size_t N, typename T>
-T& get_leaf(tuple_leaf<N, T>& leaf) {
-    return leaf.value;
+template <typename... Types>
+void swap(tuple<Types...>& a, tuple<Types...>& b) {
+    a.swap(b);
 }
 
-template <std::size_t N, typename T>
-const T& get_leaf(const tuple_leaf<N, T>& leaf) {
-    return leaf.value;
+template <std::size_t N, typename T, bool C>
+constexpr T& get_leaf(tuple_leaf<N, T, C>& leaf) noexcept {
+    return leaf.element();
+}
+
+template <std::size_t N, typename T, bool C>
+constexpr const T& get_leaf(const tuple_leaf<N, T, C>& leaf) noexcept {
+    return leaf.element();
 }
 
 template <std::size_t N, typename... Types>
-auto& get(tuple<Types...>& t) {
+constexpr auto& get(tuple<Types...>& t) noexcept {
+    static_assert(N < sizeof...(Types), "tuple index out of range");
     return get_leaf<N>(t);
 }
 
 template <std::size_t N, typename... Types>
-const auto& get(const tuple<Types...>& t) {
+constexpr const auto& get(const tuple<Types...>& t) noexcept {
+    static_assert(N < sizeof...(Types), "tuple index out of range");
     return get_leaf<N>(t);
 }
 
+template <std::size_t N, typename... Types>
+constexpr auto&& get(tuple<Types...>&& t) noexcept {
+    static_assert(N < sizeof...(Types), "tuple index out of range");
+    using T = typename tuple_type_at<N, Types...>::type;
+    return static_cast<T&&>(get_leaf<N>(t));
+}
+
+// arguments are decayed, so make_tuple(x) stores a copy of x rather than a
+// dangling reference to it
 template <typename... Args>
-tuple<Args...> make_tuple(Args&&... args) {
-    return tuple<Args...>(std::forward<Args>(args)...);
+constexpr tuple<std::decay_t<Args>...> make_tuple(Args&&... args) {
+    return tuple<std::decay_t<Args>...>(std::forward<Args>(args)...);
+}
+
+// Element-wise lexicographic comparison, unrolled at compile time
+template <std::size_t I, typename... Types>
+constexpr bool tuple_equal(const tuple<Types...>& lhs, const tuple<Types...>& rhs) {
+    if constexpr (I == sizeof...(Types)) return true;
+    else return get<I>(lhs) == get<I>(rhs) && tuple_equal<I + 1>(lhs, rhs);
+}
+
+template <std::size_t I, typename... Types>
+constexpr bool tuple_less(const tuple<Types...>& lhs, const tuple<Types...>& rhs) {
+    if constexpr (I == sizeof...(Types)) return false;
+    else return get<I>(lhs) < get<I>(rhs) ||
+                (!(get<I>(rhs) < get<I>(lhs)) && tuple_less<I + 1>(lhs, rhs));
+}
+
+template <typename... Types>
+constexpr bool operator==(const tuple<Types...>& lhs, const tuple<Types...>& rhs) {
+    return tuple_equal<0>(lhs, rhs);
+}
+
+template <typename... Types>
+constexpr bool operator!=(const tuple<Types...>& lhs, const tuple<Types...>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename... Types>
+constexpr bool operator<(const tuple<Types...>& lhs, const tuple<Types...>& rhs) {
+    return tuple_less<0>(lhs, rhs);
 }
 
+template <typename... Types>
+constexpr bool operator<=(const tuple<Types...>& lhs, const tuple<Types...>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename... Types>
+constexpr bool operator>(const tuple<Types...>& lhs, const tuple<Types...>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename... Types>
+constexpr bool operator>=(const tuple<Types...>& lhs, const tuple<Types...>& rhs) {
+    return !(lhs < rhs);
+}
+
+static_assert(std::is_trivially_copyable<tuple<int, double, char>>::value,
+              "tuple of trivially copyable members must be trivially copyable");
+static_assert(sizeof(tuple<int, std::less<int>>) == sizeof(int),
+              "empty element types must not take space");
+
+}
+
+namespace std {
+
+template <typename... Types>
+struct tuple_size<mystl::tuple<Types...>>
+    : std::integral_constant<std::size_t, sizeof...(Types)> {};
+
+template <std::size_t N, typename... Types>
+struct tuple_element<N, mystl::tuple<Types...>> {
+    static_assert(N < sizeof...(Types), "tuple index out of range");
+    using type = typename mystl::tuple_type_at<N, Types...>::type;
+};
+
+template <typename... Types>
+struct hash<mystl::tuple<Types...>> {
+    std::size_t operator()(const mystl::tuple<Types...>& t) const {
+        return hashLeaves(t, std::index_sequence_for<Types...>{});
+    }
+
+private:
+    template <std::size_t... Indices>
+    static std::size_t hashLeaves(const mystl::tuple<Types...>& t, std::index_sequence<Indices...>) {
+        uint64_t h = 0;
+        ((h = mystl::hash_combine(h, std::hash<Types>{}(mystl::get<Indices>(t)))), ...);
+        return static_cast<std::size_t>(h);
+    }
+};
+
 }